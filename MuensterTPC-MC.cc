@@ -24,6 +24,7 @@
 #include <string>
 #include <sstream>
 #include <unistd.h>
+#include <getopt.h>
 #include <sys/time.h>
 
 // include GEANT4 classes
@@ -47,6 +48,8 @@
 #include "muensterTPCRunAction.hh"
 #include "muensterTPCEventAction.hh"
 #include "muensterTPCActionInitialization.hh"
+#include "muensterTPCBinaryWriter.hh"
+#include "muensterTPCCheckpoint.hh"
 
 void usage();
 inline bool fileexists (const std::string& name);
@@ -79,10 +82,13 @@ int main(int argc, char **argv)
 	bool bMacroFile = false;
 	bool bDataFilename = false;
 	bool bVerbosities = false;
+	bool bResume = false;
 	int iVerbosities = 0;
 	int iNbEventsToSimulate = 0;
-	std::string hPreInitFilename, hMacroFilename, hDataFilename;
+	long lMasterSeed = -1;
+	std::string hPreInitFilename, hMacroFilename, hDataFilename, hCheckpointFilename;
 	std::stringstream hStream;
+	muensterTPCCheckpoint hCheckpoint;
 	
 	// parse switches
 	// p: preinit with custom file
@@ -91,8 +97,15 @@ int main(int argc, char **argv)
 	// n: number of events to simulate
 	// i: interactive session
 	// v: turn on debug verbosities
+	// c: convert a binary event file into the ROOT format and exit
+	// s: master seed of the event seeds
+	// r, --resume: continue the run of a checkpoint file (/Xe/output/checkpoint) in its datafile
+	static struct option hLongOptions[] = {
+		{"resume", required_argument, 0, 'r'},
+		{0, 0, 0, 0}
+	};
 	if ( argc == 1 ) { bInteractive = true; }
-	while((c = getopt(argc,argv,"p:f:o:n:v:i")) != -1) {
+	while((c = getopt_long(argc,argv,"p:f:o:n:v:ic:r:s:",hLongOptions,0)) != -1) {
 		switch(c)	{
 			case 'p':
 				bPreInitFromFile = true;
@@ -132,6 +145,31 @@ int main(int argc, char **argv)
 				bInteractive = true;
 				break;
 
+			case 'c':
+				if (fileexists(optarg)) {
+					// events.evb -> events.root
+					std::string hBinaryFilename = optarg;
+					std::string hRootFilename = hBinaryFilename.substr(0, hBinaryFilename.find_last_of('.')) + ".root";
+					return muensterTPCBinaryWriter::Convert(hBinaryFilename, hRootFilename)?0:1;
+				}
+				else
+					{ G4cout << "File '" << optarg << "' not found!" << G4endl; usage(); }
+				break;
+
+			case 's':
+				hStream.str(optarg);
+				hStream.clear();
+				hStream >> lMasterSeed;
+				break;
+
+			case 'r':
+				bResume = true;
+				if (fileexists(optarg))
+					hCheckpointFilename = optarg;
+				else
+					{ G4cout << "File '" << optarg << "' not found!" << G4endl; usage(); }
+				break;
+
 			default:
 				usage();
 		}
@@ -141,10 +179,22 @@ int main(int argc, char **argv)
 	if (bInteractive) {	ui = new G4UIExecutive(argc, argv, "Qt"); }
 	else if (!bMacroFile) { usage(); }
 	
+	// the remaining events of the checkpoint are simulated into the same datafile
+	if (bResume) {
+		if (!hCheckpoint.Read(hCheckpointFilename) || !fileexists(hCheckpoint.m_hDataFilename))
+			{ G4cout << "Checkpoint '" << hCheckpointFilename << "' cannot be resumed!" << G4endl; usage(); }
+		iNbEventsToSimulate = hCheckpoint.m_iNbEvents - (hCheckpoint.m_iLastEventId+1);
+		if (iNbEventsToSimulate <= 0)
+			{ G4cout << "All " << hCheckpoint.m_iNbEvents << " events of '" << hCheckpoint.m_hDataFilename << "' are simulated." << G4endl; return 0; }
+	}
+
 	std::stringstream DatafileName;
 	DatafileName.clear();
  	size_t found;
-	if (bDataFilename) {
+	if (bResume) {
+		DatafileName << hCheckpoint.m_hDataFilename;
+	}
+	else if (bDataFilename) {
 		found=hDataFilename.find_last_of("/");
  		if (found!=std::string::npos)
 			DatafileName << hDataFilename.substr(0,found+1) << hTimeStamp.str() << "_" << hDataFilename.substr(found+1);
@@ -181,7 +231,7 @@ int main(int argc, char **argv)
 	
 	// create the primary generator action
 	muensterTPCPrimaryGeneratorAction *pPrimaryGeneratorAction = new muensterTPCPrimaryGeneratorAction();
-	pRunManager->SetUserInitialization(new muensterTPCActionInitialization(DatafileName.str(), pPrimaryGeneratorAction));
+	pRunManager->SetUserInitialization(new muensterTPCActionInitialization(DatafileName.str(), pPrimaryGeneratorAction, hCheckpointFilename));
 
 	// start visualization and ui manager
 	G4VisManager* pVisManager = new G4VisExecutive;
@@ -229,6 +279,10 @@ int main(int argc, char **argv)
 		pUImanager->ApplyCommand(hCommand);
 	}
 		
+	// the command line overrides the macro, a resumed run takes the seed of its checkpoint
+	if(lMasterSeed >= 0)
+		pPrimaryGeneratorAction->SetMasterSeed(lMasterSeed);
+
 	if(iNbEventsToSimulate)	{
 		hStream.str("");
 		hStream.clear();
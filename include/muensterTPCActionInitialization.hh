@@ -17,6 +17,8 @@
 #include "muensterTPCAnalysisManager.hh"
 #include "muensterTPCPrimaryGeneratorAction.hh"
 
+class muensterTPCParameterScan;
+
 #include <string.h>    
 #include <iostream>
 #include <sstream>
@@ -26,7 +28,7 @@
 class muensterTPCActionInitialization : public G4VUserActionInitialization
 {
   public:
-  	muensterTPCActionInitialization(std::string, muensterTPCPrimaryGeneratorAction*);
+  	muensterTPCActionInitialization(std::string, muensterTPCPrimaryGeneratorAction*, std::string = "");
     virtual ~muensterTPCActionInitialization();
 
     virtual void BuildForMaster() const;
@@ -35,6 +37,7 @@ class muensterTPCActionInitialization : public G4VUserActionInitialization
   private:
   	muensterTPCAnalysisManager *pAnalysisManager;
   	muensterTPCPrimaryGeneratorAction *pPrimaryGeneratorAction;
+  	muensterTPCParameterScan *pParameterScan;
 
 };
 
@@ -16,15 +16,27 @@
 #include <globals.hh>
 #include <TParameter.h>
 
+#include <vector>
+#include <utility>
+
+#include "muensterTPCDetectorConstruction.hh"
+#include "muensterTPCHistogramWriter.hh"
+
 class G4Run;
 class G4Event;
 class G4Step;
+class G4Timer;
 
 class TFile;
-class TTree;
 
 class muensterTPCEventData;
 class muensterTPCPrimaryGeneratorAction;
+class muensterTPCAnalysisMessenger;
+class muensterTPCOutputWriter;
+class muensterTPCEventFilter;
+class muensterTPCLXeSensitiveDetector;
+class muensterTPCPmtSensitiveDetector;
+class muensterTPCCheckpoint;
 
 class muensterTPCAnalysisManager {
 public:
@@ -42,18 +54,56 @@ public:
 	void SetNbEventsToSimulate(G4int iNbEventsToSimulate) { m_iNbEventsToSimulate = iNbEventsToSimulate; }
 	G4int GetNbEventsToSimulate() { return m_iNbEventsToSimulate; }
 
+	// directory of the next run in the output file (parameter scan)
+	void SetScanPoint(const G4String &hDirectory, const G4String &hDescription, G4bool bAppendToFile);
+
+	// output file settings, used from the next run on
+	void SetOutputFormat(const G4String &hFormat);
+	void SetCompression(const G4String &hAlgorithm, G4int iLevel);
+	void SetBasketSize(const G4String &hBranch, G4int iBytes);
+	void SetAutoFlush(Long64_t lAutoFlush);
+	void SetAutoSave(Long64_t lAutoSave);
+	void SetStoreHits(G4bool bStoreHits);
+	void SetStepFields(const G4String &hFields);
+
+	// sparse waveforms of the pmts, 0 bins switches them off
+	void SetWaveform(G4int iNbBins, G4double dBinWidth, G4double dStartTime);
+	void SetSpeResponse(const G4String &hFilename);
+
+	// checkpoints every N events for a resume after a crash, 0 switches them off
+	void SetCheckpointInterval(G4int iNbEvents);
+	// continues the run of a checkpoint in its output file
+	G4bool SetResume(const G4String &hCheckpointFilename);
+	muensterTPCCheckpoint *GetCheckpoint() { return m_pCheckpoint; }
+	// the tracks of the checkpoint are classified as postponed
+	G4bool IsPushingPostponedTracks() { return m_bPushingPostponedTracks; }
+
+	// calibration runs (e.g. /Xe/detector/tuneSmartless) write into a temporary
+	// file without checkpoints, it is removed at the end of the calibration
+	void SetCalibration(G4bool bCalibration);
+
+	// histograms of the histograms format
+	void AddHistogram(const muensterTPCHistogramWriter::Histogram &hHistogram);
+	void ClearHistograms();
+
 private:
-	G4bool FilterEvent(muensterTPCEventData *pEventData);
+	G4String GetBinaryFilename();
+	G4String GetMetadata();
+	G4String GetStepFieldNames(G4int iStepFields);
+	G4String GetCheckpointFilename();
+	void WriteCheckpoint(G4int iLastEventId);
 
 private:
-	G4int m_iLXeHitsCollectionID;
-	G4int m_iPmtHitsCollectionID;
+	// the sensitive detectors fill the event record during the event
+	muensterTPCLXeSensitiveDetector *m_pLXeSensitiveDetector;
+	muensterTPCPmtSensitiveDetector *m_pPmtSensitiveDetector;
+	G4bool m_bStoreHits;
+	G4int m_iStepFields;
 
 	G4String m_hDataFilename;
 	G4int m_iNbEventsToSimulate;
 
 	TFile *m_pTreeFile;
-	TTree *m_pTree;
 	TDirectory *_events;
 	
 	TParameter<int> *m_pNbEventsToSimulateParameter;
@@ -63,6 +113,59 @@ private:
 	muensterTPCEventData *m_pEventData;
 	
 	G4bool writeEmptyEvents;
+
+	// parameter scan point of the next run
+	G4String m_hScanDirectory;
+	G4String m_hScanDescription;
+	G4bool m_bAppendToFile;
+
+	// geometry parameters at the beginning of the run
+	muensterTPCDetectorConstruction::GeometryParameters m_hGeometryParameters;
+	G4int m_iNbTopPmts;
+	G4int m_iNbBottomPmts;
+
+	// throughput of the run (events and primaries per second)
+	G4Timer *m_pRunTimer;
+	G4long m_lNbPrimaries;
+
+	// time spent in EndOfEvent and number of processed hits
+	G4double m_dEndOfEventTime;
+	G4long m_lNbEndOfEventHits;
+
+	// output file settings
+	muensterTPCAnalysisMessenger *m_pMessenger;
+	G4String m_hOutputFormat;
+	muensterTPCOutputWriter *m_pOutputWriter;
+	G4String m_hCompression;
+	G4int m_iCompressionSetting;
+	std::vector<std::pair<G4String, G4int> > m_hBasketSizes;
+	Long64_t m_lAutoFlush;
+	Long64_t m_lAutoSave;
+	G4double m_dFillTime;
+
+	std::vector<muensterTPCHistogramWriter::Histogram> m_hHistograms;
+
+	// waveform settings
+	G4int m_iNbWaveformBins;
+	G4double m_dWaveformBinWidth;
+	G4double m_dWaveformStartTime;
+	std::vector<float> m_hSpeResponse;
+
+	// cuts applied before the event record is filled
+	muensterTPCEventFilter *m_pEventFilter;
+
+	// checkpoints and resumed runs
+	muensterTPCCheckpoint *m_pCheckpoint;
+	G4int m_iCheckpointInterval;
+	G4bool m_bCheckpoints;
+	G4bool m_bResume;
+	G4bool m_bPushingPostponedTracks;
+	G4int m_iEventIdOffset;
+	Long64_t m_lNbResumedEntries;
+
+	// the output file of the job during a calibration
+	G4bool m_bCalibration;
+	G4String m_hJobDataFilename;
 };
 
 #endif // __muensterTPCPANALYSISMANAGER_H__
@@ -0,0 +1,52 @@
+#ifndef __MUENSTERTPCANALYSISMESSENGER_H__
+#define __MUENSTERTPCANALYSISMESSENGER_H__
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Settings of the output file
+ *
+ * @comment
+ ******************************************************************/
+
+#include <G4UImessenger.hh>
+#include <globals.hh>
+
+class muensterTPCAnalysisManager;
+
+class G4UIcommand;
+class G4UIdirectory;
+class G4UIcmdWithoutParameter;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADouble;
+class G4UIcmdWithABool;
+
+class muensterTPCAnalysisMessenger: public G4UImessenger
+{
+public:
+  muensterTPCAnalysisMessenger(muensterTPCAnalysisManager *pAnalysisManager);
+  ~muensterTPCAnalysisMessenger();
+
+  void SetNewValue(G4UIcommand *pCommand, G4String hNewValues);
+private:
+  muensterTPCAnalysisManager *m_pAnalysisManager;
+  G4UIdirectory              *m_pDirectory;
+  G4UIcmdWithAString         *m_pFormatCmd;
+  G4UIcommand                *m_pCompressionCmd;
+  G4UIcommand                *m_pBasketSizeCmd;
+  G4UIcmdWithAnInteger       *m_pAutoFlushCmd;
+  G4UIcmdWithADouble         *m_pAutoSaveCmd;
+  G4UIcmdWithABool           *m_pStoreHitsCmd;
+  G4UIcmdWithAString         *m_pFieldsCmd;
+  G4UIcommand                *m_pWaveformCmd;
+  G4UIcmdWithAString         *m_pSpeResponseCmd;
+  G4UIcmdWithAnInteger       *m_pCheckpointCmd;
+
+  G4UIdirectory              *m_pHistogramDirectory;
+  G4UIcommand                *m_pAddHistogramCmd[3];
+  G4UIcmdWithoutParameter    *m_pClearHistogramsCmd;
+};
+
+#endif // __MUENSTERTPCANALYSISMESSENGER_H__
+
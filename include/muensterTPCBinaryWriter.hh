@@ -0,0 +1,92 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Chunked columnar binary output of the event data without ROOT
+ *
+ * @comment - file:   "MTPCEVB1" uint32 version uint32 length metadata
+ *                    chunk* "END " uint64 nbevents
+ *          - chunk:  "CHNK" uint32 nbevents uint32 nbcolumns column*
+ *          - column: uint8 length name uint8 type uint64 nbvalues
+ *                    uint32 rawbytes uint32 storedbytes data
+ *            type 'i' int32, 'f' float32, 's' string: uint32 nbstrings
+ *            (uint16 length chars)* int32 index[nbvalues]
+ *          - the data of each column is compressed with zlib, stored
+ *            uncompressed if storedbytes == rawbytes
+ *          - the step columns have nsteps values per event, pmthits has
+ *            npmts values, little endian as written by the machine
+ *          - only the columns of the step fields of the run are written
+ *            (metadata key fields), readers skip unknown columns
+ *          - waveforms: nwf values per event in wfpmt, wfbin and wfamp,
+ *            metadata key waveform (nbins binwidth start in ns)
+ *          - the metadata are "key value" lines (G4VERSION_TAG, MC_TAG,
+ *            nbevents, fields, waveform, directory, parameters)
+ *          - every chunk is complete on disk, files of aborted runs can be
+ *            converted up to the last chunk
+ ******************************************************************/
+#ifndef __MUENSTERTPCBINARYWRITER_H__
+#define __MUENSTERTPCBINARYWRITER_H__
+
+#include <globals.hh>
+
+#include <fstream>
+#include <vector>
+#include <map>
+#include <string>
+
+#include "muensterTPCOutputWriter.hh"
+
+class muensterTPCEventData;
+
+class muensterTPCBinaryWriter: public muensterTPCOutputWriter {
+public:
+	// chunk size > 0: events, < 0: bytes
+	muensterTPCBinaryWriter(muensterTPCEventData *pEventData, const G4String &hFilename, const G4String &hMetadata,
+		G4int iCompressionLevel, G4long lChunkSize);
+	~muensterTPCBinaryWriter();
+
+	void Fill();
+	void Close();
+
+	G4String GetDescription();
+	G4double GetRawSize() { return m_dRawBytes; }
+	G4double GetCompressedSize() { return m_dStoredBytes; }
+
+	// writes a binary file into the layout of the ttree format
+	static G4bool Convert(const G4String &hBinaryFilename, const G4String &hRootFilename);
+
+private:
+	typedef struct {
+		char cType;
+		G4bool bEnabled;
+		G4long lNbValues;
+		std::vector<char> hData;
+		std::map<std::string, G4int> hDictionary;
+		std::vector<std::string> hStrings;
+	} Column;
+
+	void AppendInts(Column &hColumn, const int *pValues, G4int iNbValues);
+	void AppendFloats(Column &hColumn, const float *pValues, G4int iNbValues);
+	void AppendStrings(Column &hColumn, const std::vector<std::string> &hValues);
+	void WriteChunk();
+
+private:
+	muensterTPCEventData *m_pEventData;
+	G4String m_hFilename;
+	std::ofstream m_hFile;
+
+	G4int m_iCompressionLevel;
+	G4long m_lChunkSize;
+
+	std::vector<Column> m_hColumns;
+	G4int m_iNbEnabledColumns;
+	G4long m_lNbChunkEvents;
+	G4long m_lNbChunkBytes;
+	std::vector<char> m_hBuffer;
+
+	G4double m_dRawBytes;
+	G4double m_dStoredBytes;
+};
+
+#endif // __MUENSTERTPCBINARYWRITER_H__
+
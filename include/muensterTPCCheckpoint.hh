@@ -0,0 +1,75 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Checkpoint of a run to resume it after a crash
+ *
+ * @comment - written next to the AutoSave of the events tree, the tree
+ *            on disk holds exactly the events of the checkpoint
+ *          - master seed and run id of the event seeds and the state of
+ *            the random engine after the last completed event
+ *          - tracks postponed to the next event (radioactive decays,
+ *            see muensterTPCStackingAction) are pushed again at the
+ *            beginning of the resumed run, before the first primaries
+ *          - text file <output>.checkpoint, replaced atomically
+ ******************************************************************/
+#ifndef __MUENSTERTPCCHECKPOINT_H__
+#define __MUENSTERTPCCHECKPOINT_H__
+
+#include <globals.hh>
+#include <G4ThreeVector.hh>
+
+#include <vector>
+
+class G4Track;
+class G4StackManager;
+
+class muensterTPCCheckpoint {
+public:
+	muensterTPCCheckpoint();
+	~muensterTPCCheckpoint();
+
+	void Clear();
+
+	G4bool Write(const G4String &hFilename);
+	G4bool Read(const G4String &hFilename);
+
+	// state of the current random engine
+	void SaveRandomEngine();
+	G4bool RestoreRandomEngine();
+
+	// tracks in the postponed stack at the end of the event
+	void AddPostponedTrack(const G4Track *pTrack);
+	void ClearPostponedTracks() { m_hPostponedTracks.clear(); }
+	G4int GetNbPostponedTracks() { return m_hPostponedTracks.size(); }
+	G4int PushPostponedTracks(G4StackManager *pStackManager);
+
+public:
+	G4String m_hDataFilename;
+	G4int m_iNbEvents;
+	G4int m_iLastEventId;
+	G4long m_lNbEntries;
+	// the event seeds of the run
+	G4long m_lMasterSeed;
+	G4int m_iRunId;
+
+private:
+	typedef struct {
+		G4String hParticle;
+		G4int iZ;
+		G4int iA;
+		G4double dExcitationEnergy;
+		G4double dKineticEnergy;
+		G4ThreeVector hDirection;
+		G4ThreeVector hPosition;
+		G4ThreeVector hPolarization;
+		G4double dTime;
+		G4double dWeight;
+	} PostponedTrack;
+
+	G4String m_hEngineState;
+	std::vector<PostponedTrack> m_hPostponedTracks;
+};
+
+#endif // __MUENSTERTPCCHECKPOINT_H__
+
@@ -25,6 +25,7 @@ class G4LogicalVolume;
 class G4VPhysicalVolume;
 class G4Material;
 class G4UserLimits;
+class G4OpticalSurface;
 class muensterTPCDetectorMessenger;
 
 #include <G4VUserDetectorConstruction.hh>
@@ -40,7 +41,10 @@ public:
 	void SetGXeTeflonReflectivity(G4double dGXeReflectivity);
 	void SetSS304LSteelReflectivity(G4double dReflectivity);
 	void SetLXeScintillation(G4bool dScintillation);
-	void SetLXeLevel(G4double dlevel);
+	void SetLXeLevel(G4double dLXeLevel);
+	void SetAnodeMeshOffset(G4double dOffset);
+	void SetNbMountedTopPmts(G4int iNbPmts);
+	void SetNbMountedBottomPmts(G4int iNbPmts);
 	void SetMaterial (const G4String&);
 	void SetLXeMeshMaterial (const G4String&);
 	void SetGXeMeshMaterial (const G4String&);
@@ -52,7 +56,147 @@ public:
 	void SetLXeMeshTransparency(G4double dTransparency); 
 	void SetGXeMeshTransparency(G4double dTransparency); 
 
-	static G4double GetGeometryParameter(const char *szParameter);
+	void SetTeflonSurfaceModel(const G4String &hModel);
+
+	void SetPmtPlacement(const G4String &hPlacement);
+	void SetPmtLayout(const G4String &hFilename);
+	void SetGdmlCache(const G4String &hFilename);
+	void ExportGdml(const G4String &hFilename, G4bool bWriteHash);
+	void AuditGeometry(G4int iNbPoints);
+	void SetSmartless(const G4String &hVolumeName, G4double dSmartless);
+	void SetMeshModel(const G4String &hModel);
+	void TuneSmartless(G4int iNbEvents);
+
+	// geometry parameter keys, unknown keys fail at compile time
+	typedef enum {
+		ScreeningMeshToAnode,
+		AnodeToLiquidLevel,
+		LiquidLevelToGateMesh,
+		LiquidLevelToScreenMesh,
+		CathodeToScreenMesh,
+		TopBottomPMTToScreeningMesh,
+		BottomTopPMTToScreeningMesh,
+		TeflonCentralCylinderInnerRadius,
+		TeflonCentralCylinderOuterRadius,
+		TeflonCentralCylinderHeight,
+		TeflonCentralCylinderThickness,
+		TeflonOuterCylinderInnerRadius,
+		TeflonOuterCylinderOuterRadius,
+		TeflonOuterCylinderHeight,
+		TeflonOuterCylinderThickness,
+		BottomPMTHolderTopPartThickness,
+		BottomPMTHolderBottomPartThickness,
+		BottomPMTBaseHolderThickness,
+		BottomPMTHolderPlateRadius,
+		BottomPTFESlabThickness,
+		BottomPTFESlabInnerRadius,
+		BottomPTFESlabOuterRadius,
+		BottomSteelRingThickness,
+		BottomSteelRingInnerRadius,
+		BottomSteelRingOuterRadius,
+		BottomFlangeCopperRingToTopSteelRing,
+		TopPMTHolderPlateThickness,
+		TopPMTHolderTopPartThickness,
+		TopPMTHolderBottomPartThickness,
+		TopPMTHolderPlateRadius,
+		TopPTFESlabThickness,
+		TopPTFESlabInnerRadius,
+		TopPTFESlabOuterRadius,
+		CopperRingsOuterRadius,
+		CopperRingsInnerRadius,
+		CopperRingsThickness,
+		CopperRingsNumber,
+		CopperRingsSpacing,
+		GridMeshThickness,
+		GridMeshRadius,
+		GridMeshNumber,
+		GridMeshBorderInnerRadius,
+		GridMeshBorderOuterRadius,
+		GateMeshRingThickness,
+		GridMeshSupportThickness,
+		GridMeshSupportInnerRadius,
+		GridMeshSupportOuterRadius,
+		GridMeshSupportNumber,
+		CathodeGridMeshSupportThickness,
+		CathodeGridMeshSupportInnerRadius,
+		CathodeGridMeshSupportOuterRadius,
+		PmtWidth,
+		PmtSpacing,
+		PmtWindowWidth,
+		PmtWindowThickness,
+		PmtCasingWidth,
+		PmtCasingHeight,
+		PmtCasingThickness,
+		PmtPhotoCathodeWidth,
+		PmtPhotoCathodeThickness,
+		PmtBaseThickness,
+		PmtToPmtBase,
+		NbTopPmtsFirstRow,
+		NbTopPmtsSecondRow,
+		NbTopPmtsThirdRow,
+		NbTopPmts,
+		NbBottomPmtsFirstRow,
+		NbBottomPmtsSecondRow,
+		NbBottomPmtsThirdRow,
+		NbBottomPmts,
+		SpaceBelowTopPMTHeight,
+		InnerCryostatBlindFlangeThickness,
+		InnerCryostatBoreFlangeThickness,
+		InnerCryostatBoreFlangeOuterRadius,
+		InnerCryostatBlindFlangeOuterRadius,
+		BoreFlangeNumber,
+		BlindFlangeNumber,
+		InnerCryostatVesselOuterRadius,
+		InnerCryostatVesselInnerRadius,
+		InnerCryostatVesselHeight,
+		InnerCryostatVesselThickness,
+		CryostatToTopPMTCasingSpacing,
+		CryostatBottomDistanceBetweenLXeAndPTFE,
+		TopBoreFlangeInnerCryostatToLiquidLevel,
+		InnerCryostatCopperRingsOuterRadius,
+		InnerCryostatCopperRingsInnerRadius,
+		InnerCryostatCopperRingsThickness,
+		InnerCryostatCopperRingsNumber,
+		OuterCryostatBlindFlangeThickness,
+		OuterCryostatBoreFlangeThickness,
+		OuterCryostatBoreFlangeOuterRadius,
+		OuterCryostatBoreFlangeInnerRadius,
+		OuterCryostatBlindFlangeOuterRadius,
+		OuterCryostatBoreFlangeNumber,
+		OuterCryostatBlindFlangeNumber,
+		OuterCryostatVesselOuterRadius,
+		OuterCryostatVesselInnerRadius,
+		OuterCryostatVesselHeight,
+		OuterCryostatVesselThickness,
+		OuterCryostatToTurboPumpTubeInnerRadius,
+		OuterCryostatToTurboPumpTubeOuterRadius,
+		OuterCryostatToTurboPumpTubeFlangeInnerRadius,
+		OuterCryostatToTurboPumpTubeFlangeOuterRadius,
+		OuterCryostatToTurboPumpTubeFlangeThickness,
+		OuterCryostatBottomToTurboPumpTube,
+		OuterCryostatTopToTopFlangeTPCCryostat,
+		OuterCryostatBottomToBottomFlangeTPCCryostat,
+		LXeHeight,
+		GXeHeight,
+		LXeLevelZeroOffset,
+		InnerCryostatVesselOffsetZ,
+		LXeLevelToTopTPCCryostat,
+		DriftLength,
+		NbGeometryParameters
+	} GeometryParameter;
+
+	// immutable copy of all geometry parameters, e.g. for the analysis
+	class GeometryParameters {
+	public:
+		G4double operator[](GeometryParameter eParameter) const {return m_pdValues[eParameter];};
+
+	private:
+		friend class muensterTPCDetectorConstruction;
+		G4double m_pdValues[NbGeometryParameters];
+	};
+
+	static G4double GetGeometryParameter(GeometryParameter eParameter);
+	static const GeometryParameters &GetGeometryParameters();
 
 public:
 	G4Material*	GetMaterial()	{return LXeMaterial;};
@@ -60,11 +204,44 @@ public:
 private:
 	void DefineMaterials();
 	void DefineGeometryParameters();
+	static void SetGeometryParameter(GeometryParameter eParameter, G4double dValue);
 	void UpdateGeometry();
+	void ReoptimiseGeometry(G4VPhysicalVolume *pPhysicalVolume);
+	void MountPmts();
+	void MountMeshes();
+	void UpdateMeshPlanes();
+
+	G4String GetGeometryHash();
+	G4bool ImportGdml(const G4String &hFilename);
+	G4VPhysicalVolume *FindPhysicalVolume(const G4String &hName, G4int iCopyNb);
+	G4String m_hGdmlCacheFilename;
+	G4bool m_bParameterisedPmtArrays;
+	G4bool m_bMeshSurfaces;
+
+	// pmt positions (x, y) from a layout table, empty for the default rows
+	vector<G4ThreeVector> m_hTopPmtLayout;
+	vector<G4ThreeVector> m_hBottomPmtLayout;
 
 	G4Material* LXeMaterial;
 	G4UserLimits* fStepLimit;       // pointer to user step limits
 
+	G4OpticalSurface *m_pTeflonOpticalSurface;
+	G4OpticalSurface *m_pGXeTeflonOpticalSurface;
+	G4String m_hTeflonSurfaceModel;
+	// unified model as constructed, restored by SetTeflonSurfaceModel
+	void SaveTeflonSurfaceModel();
+	G4double m_dTeflonSigmaAlpha;
+	G4double m_dGXeTeflonSigmaAlpha;
+	map<G4String, vector<G4double> > m_hTeflonSurfaceEnergies;
+	map<G4String, vector<G4double> > m_hTeflonSurfaceConstants;
+
+	// run time changes w.r.t. the nominal geometry
+	G4double m_dLXeLevel;
+	G4double m_dAnodeMeshOffset;
+	G4int m_iNbMountedTopPmts;
+	G4int m_iNbMountedBottomPmts;
+	vector<G4bool> m_hPmtMounted;
+
 	void ConstructLaboratory();
 	void ConstructShield();
 	void ConstructXenon();
@@ -73,9 +250,12 @@ private:
 	void ConstructTPC();
 	void ConstructPmtSupports();
 	void ConstructPmtArrays();
+	void ConstructParameterisedPmtArrays();
 	void ConstructCryostat();
 	void ConstructInnerCryostat();
 	void ConstructOuterCryostat();
+	void ConstructSensitiveDetectors();
+	void ConstructRegions();
 
 	void PrintGeometryInformation();
 	void PrintPhysicalVolumes();
@@ -354,7 +534,7 @@ private:
 	G4VPhysicalVolume *m_pTeflonBottomReflectorTopPhysicalVolume;
 	G4VPhysicalVolume *m_pTeflonBottomReflectorBottomPhysicalVolume;
 	
-	static map<G4String, G4double> m_hGeometryParameters;
+	static GeometryParameters m_hGeometryParameters;
 	
 	muensterTPCDetectorMessenger *m_pDetectorMessenger;
 };
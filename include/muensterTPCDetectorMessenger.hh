@@ -31,6 +31,9 @@ private:
 	G4UIdirectory *m_pDetectorDir;
 
 	G4UIcmdWithADoubleAndUnit *m_pLXeLevelCmd;
+	G4UIcmdWithADoubleAndUnit *m_pAnodeMeshOffsetCmd;
+	G4UIcmdWithAnInteger *m_pNbMountedTopPmtsCmd;
+	G4UIcmdWithAnInteger *m_pNbMountedBottomPmtsCmd;
 	G4UIcmdWithAString	*m_pMaterCmd;
 	G4UIcmdWithAString	*m_pLXeMeshMaterialCmd;
 	G4UIcmdWithAString	*m_pGXeMeshMaterialCmd;
@@ -44,6 +47,15 @@ private:
 	G4UIcmdWithADouble *m_pGridMeshTransparencyCmd;
 	G4UIcmdWithADouble *m_pLXeMeshTransparencyCmd;
 	G4UIcmdWithADouble *m_pGXeMeshTransparencyCmd;
+	G4UIcmdWithAString *m_pTeflonSurfaceModelCmd;
+	G4UIcmdWithAString *m_pMeshModelCmd;
+	G4UIcmdWithAString *m_pPmtPlacementCmd;
+	G4UIcmdWithAString *m_pPmtLayoutCmd;
+	G4UIcmdWithAString *m_pGdmlCacheCmd;
+	G4UIcmdWithAString *m_pExportGdmlCmd;
+	G4UIcmdWithAnInteger *m_pAuditGeometryCmd;
+	G4UIcommand *m_pSmartlessCmd;
+	G4UIcmdWithAnInteger *m_pTuneSmartlessCmd;
 
 };
 #endif
@@ -8,7 +8,14 @@
  *
  * @update 2015-11-02 - added comments
  *
- * @comment
+ * @comment - the vectors keep their capacity between the events and the
+ *            strings of the steps are assigned to the existing elements,
+ *            the pmthits vector has a fixed size per run
+ *          - only the step fields of the mask are filled, the vectors of
+ *            the other fields stay empty
+ *          - waveforms: photons per time bin in a fixed size buffer per pmt,
+ *            only the rows of pmts with hits are cleared, the non-zero bins
+ *            (after the single photoelectron response) are the output
  ******************************************************************/
 #ifndef __muensterTPCPEVENTDATA_H__
 #define __muensterTPCPEVENTDATA_H__
@@ -24,9 +31,52 @@ public:
 	 muensterTPCEventData();
 	~muensterTPCEventData();
 
+public:
+	// step fields, see /Xe/output/fields
+	enum StepField {
+		eStepTrackId = 1<<0, eStepParentId = 1<<1, eStepType = 1<<2, eStepParentType = 1<<3,
+		eStepCreatorProcess = 1<<4, eStepDepositingProcess = 1<<5, eStepX = 1<<6, eStepY = 1<<7, eStepZ = 1<<8,
+		eStepEnergyDeposited = 1<<9, eStepTime = 1<<10, eStepKineticEnergy = 1<<11, eStepLength = 1<<12,
+		eNbStepFields = 13, eDefaultStepFields = (1<<11)-1
+	};
+
+	// branch name of a field (bit number), field of a branch name (0 if unknown)
+	static const char *GetStepFieldName(int iBit);
+	static int GetStepField(const string &hName);
+
+	void SetStepFields(int iStepFields) { m_iStepFields = iStepFields; }
+	int GetStepFields() { return m_iStepFields; }
+	bool HasStepField(int iStepField) { return (m_iStepFields & iStepField) != 0; }
+
 public:
 	void Clear();
 
+	// adds one energy depositing step, reuses the strings of the previous events
+	void AddStep(int iTrackId, int iParentId, const string &hParticleType, const string &hParentType,
+		const string &hCreatorProcess, const string &hDepositingProcess, float fX, float fY, float fZ,
+		float fEnergyDeposited, float fKineticEnergy, float fTime, float fStepLength);
+	// string of the current step (m_iNbSteps), for filling the fields one by one
+	void SetStepString(vector<string> *pVector, const string &hValue);
+	void SetPrimaryParticleType(const string &hParticleType);
+	// removes the strings left over from larger events, call before filling the tree
+	void Seal();
+
+	// waveforms of the next events, 0 bins disables them (times in ns)
+	void SetWaveform(int iNbPmts, int iNbBins, float fBinWidth, float fStartTime, const vector<float> &hSpeResponse);
+	bool HasWaveforms() { return m_iNbWaveformBins > 0; }
+	int GetNbWaveformBins() { return m_iNbWaveformBins; }
+	float GetWaveformBinWidth() { return m_fWaveformBinWidth; }
+	float GetWaveformStartTime() { return m_fWaveformStartTime; }
+
+	inline void AddPhoton(int iPmtNb, float fTime);
+	// convolution and the non-zero bins of the pmts with hits, call before filling the tree
+	void SealWaveforms();
+
+	int GetReserveHint() { return m_iReserveHint; }
+
+private:
+	void Reserve(int iNbSteps);
+
 public:
 	int m_iEventId;								// the event ID
 	int m_iNbTopPmtHits;					// number of top pmt hits
@@ -48,12 +98,37 @@ public:
 	vector<float> *m_pEnergyDeposited; 			// energy deposited in the step
 	vector<float> *m_pKineticEnergy;	// particle kinetic energy after the step			
 	vector<float> *m_pTime;						// time of the step
+	vector<float> *m_pStepLength;			// length of the step
 	vector<string> *m_pPrimaryParticleType;		// type of particle
 	float m_fPrimaryEnergy;						// energy of the primary particle
 	float m_fPrimaryX;								// position of the primary particle
 	float m_fPrimaryY;
 	float m_fPrimaryZ;	
+	vector<int> *m_pWaveformPmt;			// pmt of the waveform bin
+	vector<int> *m_pWaveformBin;			// time bin
+	vector<float> *m_pWaveformAmplitude;	// photons or amplitude in the bin
+
+private:
+	int m_iStepFields;						// mask of the filled step fields
+	int m_iReserveHint;						// expected number of steps of the next event
+
+	int m_iNbWaveformBins;
+	float m_fWaveformBinWidth;
+	float m_fWaveformStartTime;
+	vector<float> m_hSpeResponse;			// amplitude per bin after the photon
+	vector<float> m_hWaveforms;				// nbpmts x nbbins photons
+	vector<float> m_hConvolution;			// one waveform
 };
 
+inline void muensterTPCEventData::AddPhoton(int iPmtNb, float fTime)
+{
+	if(!m_iNbWaveformBins)
+		return;
+
+	const float fBin = (fTime-m_fWaveformStartTime)/m_fWaveformBinWidth;
+	if(fBin >= 0.f && fBin < m_iNbWaveformBins)
+		m_hWaveforms[iPmtNb*m_iNbWaveformBins + (int) fBin] += 1.f;
+}
+
 #endif // __muensterTPCPEVENTDATA_H__
 
@@ -0,0 +1,88 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Event selection before the event is written
+ *
+ * @comment - the active cuts are collected at the beginning of the run,
+ *            the steps are only looped over if a cut needs them
+ *          - the fiducial volume is the drift region by default
+ *          - single scatter: all energy depositing steps (no optical
+ *            photons) within a z range, the z resolution of the TPC
+ ******************************************************************/
+#ifndef __MUENSTERTPCEVENTFILTER_H__
+#define __MUENSTERTPCEVENTFILTER_H__
+
+#include <globals.hh>
+
+#include <vector>
+
+class muensterTPCEventData;
+class muensterTPCEventFilterMessenger;
+
+class muensterTPCEventFilter {
+public:
+	muensterTPCEventFilter();
+	~muensterTPCEventFilter();
+
+	// cuts, a negative maximum is no upper limit
+	void SetEnergyRange(G4double dMinimum, G4double dMaximum);
+	void SetFiducialVolume(G4double dZMinimum, G4double dZMaximum, G4double dRadius);
+	void SetFiducialEnergyRange(G4double dMinimum, G4double dMaximum);
+	void SetSingleScatter(G4double dZRange);
+	void SetMinimumPmtHits(G4int iNbPmtHits);
+	void Clear();
+
+	void BeginOfRun(G4double dDriftLength, G4double dRadius);
+	void EndOfRun();
+
+	// the fiducial volume and single scatter cuts need the steps of the event record
+	G4bool NeedsSteps() { return m_bNeedsSteps; }
+
+	G4bool Accept(muensterTPCEventData *pEventData, G4int iNbPmtHits);
+
+private:
+	typedef struct {
+		G4double dEnergy;
+		G4double dFiducialEnergy;
+		G4double dZMinimum;
+		G4double dZMaximum;
+		G4int iNbPmtHits;
+	} EventSummary;
+
+	typedef G4bool (muensterTPCEventFilter::*Cut)(const EventSummary &hSummary);
+
+	G4bool EnergyCut(const EventSummary &hSummary);
+	G4bool FiducialEnergyCut(const EventSummary &hSummary);
+	G4bool SingleScatterCut(const EventSummary &hSummary);
+	G4bool PmtHitsCut(const EventSummary &hSummary);
+
+private:
+	muensterTPCEventFilterMessenger *m_pMessenger;
+
+	G4bool m_bEnergyCut;
+	G4double m_dEnergyMinimum;
+	G4double m_dEnergyMaximum;
+
+	G4bool m_bFiducialVolume;
+	G4double m_dFiducialZMinimum;
+	G4double m_dFiducialZMaximum;
+	G4double m_dFiducialRadius;
+
+	G4bool m_bFiducialEnergyCut;
+	G4double m_dFiducialEnergyMinimum;
+	G4double m_dFiducialEnergyMaximum;
+
+	G4double m_dSingleScatterZRange;
+	G4int m_iMinimumPmtHits;
+
+	// active cuts of the run
+	std::vector<Cut> m_hCuts;
+	G4bool m_bNeedsSteps;
+
+	G4long m_lNbAccepted;
+	G4long m_lNbRejected;
+};
+
+#endif // __MUENSTERTPCEVENTFILTER_H__
+
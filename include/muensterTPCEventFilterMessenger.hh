@@ -0,0 +1,42 @@
+#ifndef __MUENSTERTPCEVENTFILTERMESSENGER_H__
+#define __MUENSTERTPCEVENTFILTERMESSENGER_H__
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Cuts of the event filter
+ *
+ * @comment
+ ******************************************************************/
+
+#include <G4UImessenger.hh>
+#include <globals.hh>
+
+class muensterTPCEventFilter;
+
+class G4UIcommand;
+class G4UIdirectory;
+class G4UIcmdWithoutParameter;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADoubleAndUnit;
+
+class muensterTPCEventFilterMessenger: public G4UImessenger
+{
+public:
+  muensterTPCEventFilterMessenger(muensterTPCEventFilter *pEventFilter);
+  ~muensterTPCEventFilterMessenger();
+
+  void SetNewValue(G4UIcommand *pCommand, G4String hNewValues);
+private:
+  muensterTPCEventFilter     *m_pEventFilter;
+  G4UIdirectory              *m_pDirectory;
+  G4UIcommand                *m_pEnergyCmd;
+  G4UIcommand                *m_pFiducialVolumeCmd;
+  G4UIcommand                *m_pFiducialEnergyCmd;
+  G4UIcmdWithADoubleAndUnit  *m_pSingleScatterCmd;
+  G4UIcmdWithAnInteger       *m_pMinimumPmtHitsCmd;
+  G4UIcmdWithoutParameter    *m_pClearCmd;
+};
+
+#endif // __MUENSTERTPCEVENTFILTERMESSENGER_H__
+
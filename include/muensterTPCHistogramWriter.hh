@@ -0,0 +1,70 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Histograms of event quantities instead of the events
+ *
+ * @comment - the histograms are filled in memory and written into the
+ *            events directory at the end of the run, files of parallel
+ *            jobs are merged with hadd
+ *          - variables: etot, ntpmthits, nbpmthits, npmthits, asym
+ *            ((top-bottom)/(top+bottom)), nsteps, e_pri, xp_pri, yp_pri,
+ *            zp_pri, rp_pri
+ *          - with waveforms h_waveforms holds the photons (or amplitude)
+ *            per pmt and time bin of all events
+ ******************************************************************/
+#ifndef __MUENSTERTPCHISTOGRAMWRITER_H__
+#define __MUENSTERTPCHISTOGRAMWRITER_H__
+
+#include <globals.hh>
+
+#include <vector>
+
+#include "muensterTPCOutputWriter.hh"
+
+class TH1;
+class TH2D;
+
+class muensterTPCEventData;
+
+class muensterTPCHistogramWriter: public muensterTPCOutputWriter {
+public:
+	typedef struct {
+		G4String hName;
+		G4int iDimension;
+		G4String hVariables[3];
+		G4int iNbBins[3];
+		G4double dMin[3];
+		G4double dMax[3];
+	} Histogram;
+
+public:
+	// the histograms are created in the current directory
+	muensterTPCHistogramWriter(muensterTPCEventData *pEventData, const std::vector<Histogram> &hHistograms);
+	~muensterTPCHistogramWriter();
+
+	void Fill();
+	void Close();
+	G4bool NeedsSteps() { return false; }
+
+	G4String GetDescription();
+	G4double GetRawSize() { return -1.; }
+	G4double GetCompressedSize() { return -1.; }
+
+	static G4bool IsVariable(const G4String &hVariable);
+	// etot, ntpmthits, nbpmthits, asym and zp_pri
+	static std::vector<Histogram> GetDefaultHistograms();
+
+private:
+	muensterTPCEventData *m_pEventData;
+
+	std::vector<TH1 *> m_hHistograms;
+	std::vector<G4int> m_hDimensions;
+	// variable indices, three per histogram
+	std::vector<G4int> m_hVariables;
+
+	TH2D *m_pWaveformHistogram;
+};
+
+#endif // __MUENSTERTPCHISTOGRAMWRITER_H__
+
@@ -17,10 +17,15 @@
 
 #include "muensterTPCLXeHit.hh"
 
+#include <map>
+
 using std::map;
 
 class G4Step;
 class G4HCofThisEvent;
+class G4ParticleDefinition;
+
+class muensterTPCEventData;
 
 class muensterTPCLXeSensitiveDetector: public G4VSensitiveDetector {
 public:
@@ -31,10 +36,30 @@ public:
 	G4bool ProcessHits(G4Step *pStep, G4TouchableHistory *pHistory);
 	void EndOfEvent(G4HCofThisEvent *pHitsCollectionOfThisEvent);
 
+	// the steps are written directly into the event record (no optical photons),
+	// only the step fields of the record are computed, without fields only the
+	// total energy deposited is summed up
+	void SetEventData(muensterTPCEventData *pEventData);
+	// hits objects for the visualization, not needed for the output
+	void SetStoreHits(G4bool bStoreHits) { m_bStoreHits = bStoreHits; }
+
+	// number of steps in the LXe of the current event, including optical photons
+	G4int GetNbHits() { return m_iNbHits; }
+
+private:
+	void StoreHit(G4Step *pStep);
+	const G4String &GetParentType(G4int iParentId);
+
 private:
 	muensterTPCLXeHitsCollection* m_pLXeHitsCollection;
 
-	map<int,G4String> m_hParticleTypes;
+	muensterTPCEventData *m_pEventData;
+	G4int m_iStepFields;
+	G4bool m_bStoreHits;
+	G4int m_iNbHits;
+
+	// the particle definitions own the names
+	map<int,const G4ParticleDefinition *> m_hParticleTypes;
 };
 
 #endif // __muensterTPCPLXESENSITIVEDETECTOR_H__
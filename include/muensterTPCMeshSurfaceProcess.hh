@@ -0,0 +1,51 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Zero-thickness optical model of the grid meshes
+ *
+ * @comment - with the surface mesh model the mesh volumes are removed,
+ *            every step of an optical photon that crosses a mesh plane
+ *            is absorbed with the probability of the slab model
+ *            1 - exp(-thickness/(|cos theta| ABSLENGTH)) of the mesh
+ *            material, no extra boundary steps are needed
+ *          - without mesh planes the process is never invoked
+ ******************************************************************/
+#ifndef __MUENSTERTPCMESHSURFACEPROCESS_H__
+#define __MUENSTERTPCMESHSURFACEPROCESS_H__
+
+#include <G4VDiscreteProcess.hh>
+#include <globals.hh>
+
+#include <vector>
+
+class G4Material;
+
+class muensterTPCMeshSurfaceProcess: public G4VDiscreteProcess {
+public:
+	muensterTPCMeshSurfaceProcess(const G4String &hProcessName = "MeshSurface");
+	~muensterTPCMeshSurfaceProcess();
+
+	typedef struct {
+		G4double dZ;			// global z of the mesh plane
+		G4double dRadius;
+		G4double dThickness;
+		G4Material *pMaterial;	// ABSLENGTH gives the transparency
+	} MeshPlane;
+
+	// set by the detector construction, empty for the slab model
+	static void SetMeshPlanes(const std::vector<MeshPlane> &hMeshPlanes);
+
+	G4bool IsApplicable(const G4ParticleDefinition &hParticle);
+
+	G4double PostStepGetPhysicalInteractionLength(const G4Track &hTrack, G4double dPreviousStepSize, G4ForceCondition *pCondition);
+	G4VParticleChange* PostStepDoIt(const G4Track &hTrack, const G4Step &hStep);
+
+protected:
+	G4double GetMeanFreePath(const G4Track &hTrack, G4double dPreviousStepSize, G4ForceCondition *pCondition);
+
+private:
+	static std::vector<MeshPlane> m_hMeshPlanes;
+};
+
+#endif // __MUENSTERTPCMESHSURFACEPROCESS_H__
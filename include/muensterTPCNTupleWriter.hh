@@ -0,0 +1,86 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * RNTuple output of the event data
+ *
+ * @comment - same field names as the branches of the events tree, the
+ *            steps are a collection "steps" of records with the selected
+ *            step fields (steps.xp, steps.ed, ...)
+ *          - the event fields are bound to the event record, the step
+ *            records are copied into a buffer laid out like the untyped
+ *            record field (no dictionary needed), the strings in the
+ *            buffer are kept between the events
+ *          - needs ROOT 6.34 or newer, otherwise IsAvailable() is false
+ ******************************************************************/
+#ifndef __MUENSTERTPCNTUPLEWRITER_H__
+#define __MUENSTERTPCNTUPLEWRITER_H__
+
+#include <globals.hh>
+#include <RVersion.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,34,0)
+#define MUENSTERTPC_USE_RNTUPLE
+#include <ROOT/RField.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleWriter.hxx>
+#endif
+
+#include "muensterTPCOutputWriter.hh"
+
+class TDirectory;
+
+class muensterTPCEventData;
+
+class muensterTPCNTupleWriter: public muensterTPCOutputWriter {
+public:
+	muensterTPCNTupleWriter(muensterTPCEventData *pEventData, TDirectory *pDirectory, G4int iCompressionSetting);
+	~muensterTPCNTupleWriter();
+
+	void Fill();
+	// writes the remaining clusters and the anchor of the ntuple
+	void Close();
+
+	G4String GetDescription() { return "rntuple"; }
+	G4double GetRawSize() { return -1.; }
+	G4double GetCompressedSize() { return -1.; }
+
+	static G4bool IsAvailable();
+
+private:
+	typedef struct {
+		std::size_t lOffset;
+		std::vector<int> *pInts;
+		std::vector<float> *pFloats;
+		std::vector<std::string> *pStrings;
+	} StepMember;
+
+	// copies the steps of the event into the records of the buffer
+	void FillSteps();
+	void ResizeSteps(G4int iNbSteps);
+
+private:
+	muensterTPCEventData *m_pEventData;
+
+	std::vector<StepMember> m_hStepMembers;
+	std::size_t m_lStepSize;				// bytes per record
+	std::vector<char> m_hSteps;				// memory of the steps field
+	G4int m_iNbStepRecords;					// records with constructed strings
+
+#ifdef MUENSTERTPC_USE_RNTUPLE
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,36,0)
+	std::unique_ptr<ROOT::RNTupleWriter> m_pWriter;
+	std::unique_ptr<ROOT::REntry> m_pEntry;
+#else
+	std::unique_ptr<ROOT::Experimental::RNTupleWriter> m_pWriter;
+	std::unique_ptr<ROOT::Experimental::REntry> m_pEntry;
+#endif
+#endif
+};
+
+#endif // __MUENSTERTPCNTUPLEWRITER_H__
+
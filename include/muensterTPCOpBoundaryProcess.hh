@@ -0,0 +1,77 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Optical boundary process with tabulated angular response
+ *
+ * @comment - the response of the Teflon and PMT casing surfaces is
+ *            tabulated in bins of the incidence angle (cos theta) and
+ *            the reflected direction (cos theta, phi) w.r.t. the
+ *            surface normal, sampled in O(1) with alias tables
+ *          - modes: record (standard physics, fill tables),
+ *                   tabulated (sample from tables),
+ *                   validate (standard physics, compare with tables)
+ ******************************************************************/
+#ifndef __MUENSTERTPCOPBOUNDARYPROCESS_H__
+#define __MUENSTERTPCOPBOUNDARYPROCESS_H__
+
+#include <G4OpBoundaryProcess.hh>
+#include <globals.hh>
+
+#include <vector>
+#include <map>
+
+class G4SurfaceProperty;
+
+class muensterTPCOpBoundaryProcess: public G4OpBoundaryProcess {
+public:
+	muensterTPCOpBoundaryProcess(const G4String &hMode, const G4String &hTableFilename, const G4String &hProcessName = "OpBoundary");
+	~muensterTPCOpBoundaryProcess();
+
+	G4VParticleChange* PostStepDoIt(const G4Track &hTrack, const G4Step &hStep);
+
+	// writes the tables (record) or prints the comparison (validate)
+	void EndOfRun();
+
+private:
+	typedef struct {
+		G4String hSurfaceName;
+		// counts [iCosIn*(m_iNbCells+1) + iCell], the last cell is absorption
+		std::vector<G4double> hCounts;
+		std::vector<G4double> hEntries;
+		// alias tables for the sampling
+		std::vector<G4double> hProbability;
+		std::vector<G4int> hAlias;
+		// validation histograms of cos theta out, the last bin is absorption
+		std::vector<G4double> hValidationModel;
+		std::vector<G4double> hValidationTable;
+	} BoundaryResponse;
+
+	BoundaryResponse *GetResponse(const G4Step &hStep);
+	G4bool GetSurfaceNormal(const G4Step &hStep, G4ThreeVector &hNormal);
+	G4int GetCosInBin(G4double dCosIn);
+	G4int GetCell(const G4ThreeVector &hDirection, const G4ThreeVector &hNormal, const G4ThreeVector &hT1, const G4ThreeVector &hT2);
+	G4int SampleCell(BoundaryResponse *pResponse, G4int iCosIn);
+	G4ThreeVector GetDirection(G4int iCell, const G4ThreeVector &hNormal, const G4ThreeVector &hT1, const G4ThreeVector &hT2);
+
+	void BuildAliasTables(BoundaryResponse *pResponse);
+	void ReadTables();
+	void WriteTables();
+	void PrintValidation();
+
+private:
+	G4String m_hMode;
+	G4String m_hTableFilename;
+	G4bool m_bTablesRead;
+
+	G4int m_iNbCosInBins;
+	G4int m_iNbCosOutBins;
+	G4int m_iNbPhiBins;
+	G4int m_iNbCells;
+
+	std::map<G4String, BoundaryResponse> m_hResponses;
+	std::map<const G4SurfaceProperty *, BoundaryResponse *> m_hSurfaceCache;
+};
+
+#endif // __MUENSTERTPCOPBOUNDARYPROCESS_H__
+
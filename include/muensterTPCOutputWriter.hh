@@ -0,0 +1,44 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Interface of the event data output formats
+ *
+ * @comment - a writer is created at the beginning of each run, it reads
+ *            the event record of the AnalysisManager in Fill()
+ *          - ttree: muensterTPCTreeWriter, rntuple: muensterTPCNTupleWriter,
+ *            binary: muensterTPCBinaryWriter (no ROOT at event time),
+ *            histograms: muensterTPCHistogramWriter
+ ******************************************************************/
+#ifndef __MUENSTERTPCOUTPUTWRITER_H__
+#define __MUENSTERTPCOUTPUTWRITER_H__
+
+#include <globals.hh>
+
+class muensterTPCOutputWriter {
+public:
+	muensterTPCOutputWriter() { m_lNbEntries = 0; }
+	virtual ~muensterTPCOutputWriter() {}
+
+	// writes the current content of the event record
+	virtual void Fill() = 0;
+	// writes the buffered events, before the output file is written
+	virtual void Close() = 0;
+	// false if the steps of the event record are not used
+	virtual G4bool NeedsSteps() { return true; }
+	// saves all events written so far for a resume, false if the format cannot be resumed
+	virtual G4bool Checkpoint() { return false; }
+
+	// for the end of run report, the sizes are in bytes (< 0: unknown)
+	virtual G4String GetDescription() = 0;
+	virtual G4double GetRawSize() = 0;
+	virtual G4double GetCompressedSize() = 0;
+
+	G4long GetEntries() { return m_lNbEntries; }
+
+protected:
+	G4long m_lNbEntries;
+};
+
+#endif // __MUENSTERTPCOUTPUTWRITER_H__
+
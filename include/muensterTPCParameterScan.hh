@@ -0,0 +1,49 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Parameter scan over run time settings within one process
+ *
+ * @comment - every point of the scan grid applies its UI commands
+ *            (e.g. material properties) and starts a run, physics and
+ *            geometry are kept between the points
+ *          - the points are written into their own directories
+ *            (point_0000, point_0001, ...) of the output file
+ ******************************************************************/
+#ifndef __MUENSTERTPCPARAMETERSCAN_H__
+#define __MUENSTERTPCPARAMETERSCAN_H__
+
+#include <globals.hh>
+
+#include <vector>
+
+using std::vector;
+
+class muensterTPCAnalysisManager;
+class muensterTPCParameterScanMessenger;
+
+class muensterTPCParameterScan {
+public:
+	muensterTPCParameterScan(muensterTPCAnalysisManager *pAnalysisManager);
+	~muensterTPCParameterScan();
+
+	void AddParameter(const G4String &hCommand, const vector<G4String> &hValues);
+	void Clear();
+	void BeamOn(G4int iNbEventsPerPoint);
+
+	G4int GetNbPoints();
+
+private:
+	typedef struct {
+		G4String hCommand;
+		vector<G4String> hValues;
+	} ScanParameter;
+
+	vector<ScanParameter> m_hParameters;
+
+	muensterTPCAnalysisManager *m_pAnalysisManager;
+	muensterTPCParameterScanMessenger *m_pMessenger;
+};
+
+#endif // __MUENSTERTPCPARAMETERSCAN_H__
+
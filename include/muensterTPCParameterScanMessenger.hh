@@ -0,0 +1,39 @@
+#ifndef __MUENSTERTPCPARAMETERSCANMESSENGER_H__
+#define __MUENSTERTPCPARAMETERSCANMESSENGER_H__
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Allow for setting up and starting a parameter scan
+ *
+ * @comment
+ ******************************************************************/
+
+#include <G4UImessenger.hh>
+#include <globals.hh>
+
+class muensterTPCParameterScan;
+
+class G4UIcommand;
+class G4UIdirectory;
+class G4UIcmdWithoutParameter;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+
+class muensterTPCParameterScanMessenger: public G4UImessenger
+{
+public:
+  muensterTPCParameterScanMessenger(muensterTPCParameterScan *pParameterScan);
+  ~muensterTPCParameterScanMessenger();
+
+  void SetNewValue(G4UIcommand *pCommand, G4String hNewValues);
+private:
+  muensterTPCParameterScan   *m_pParameterScan;
+  G4UIdirectory              *m_pDirectory;
+  G4UIcmdWithAString         *m_pAddParameterCmd;
+  G4UIcmdWithoutParameter    *m_pClearCmd;
+  G4UIcmdWithAnInteger       *m_pBeamOnCmd;
+};
+
+#endif // __MUENSTERTPCPARAMETERSCANMESSENGER_H__
+
@@ -31,12 +31,24 @@ public:
   void SetEMlowEnergyModel(G4String theModel) { m_hEMlowEnergyModel = theModel; }
   void SetHadronicModel(G4String theModel)    { m_hHadronicModel = theModel; }
   void SetCerenkov(G4bool useCerenkov) { m_bCerenkov = useCerenkov; }
+  void SetPhysicsMode(G4String hMode) { m_hPhysicsMode = hMode; }
+  void SetOpBoundaryModel(G4String hModel) { m_hOpBoundaryModel = hModel; }
+  void SetOpBoundaryTable(G4String hFilename) { m_hOpBoundaryTable = hFilename; }
+  void SetXenonRegionCut(G4double dCut);
+  void SetCryostatRegionCut(G4double dCut);
+  void SetLabCut(G4double dCut);
+
+	// physics table cache
+	void StoreTables(const G4String &hDirectory);
+	void RetrieveTables(const G4String &hDirectory) { m_hRetrieveTablesDirectory = hDirectory; }
 
 protected:
 	void ConstructParticle();
 	void ConstructProcess();
 
 	void ConstructGeneral();
+	void ConstructEMPhysics();
+	void ConstructHadronicPhysics();
 	void ConstructEM();
 	void ConstructHad();
 	void ConstructOp();
@@ -45,6 +57,12 @@ protected:
 
 	void SetBuilderList1(G4bool flagHP);
 
+	void ApplyCuts();
+	void SetRegionCuts(const G4String &hRegionName, G4double dCut);
+
+	G4String GetTableSignature();
+	G4bool CheckTableSignature(const G4String &hDirectory);
+
 private:
 	G4int VerboseLevel;
 	G4int OpVerbLevel;
@@ -56,6 +74,12 @@ private:
 	G4double cutForAlpha;
 	G4double cutForGenericIon;
 
+	// regional production cuts (see DetectorConstruction::ConstructRegions)
+	G4double m_dXenonRegionCut;
+	G4double m_dCryostatRegionCut;
+
+	G4String m_hRetrieveTablesDirectory;
+
 	void ConstructMyBosons();
 	void ConstructMyLeptons();
 	void ConstructMyHadrons();
@@ -69,6 +93,9 @@ private:
   G4String                 m_hEMlowEnergyModel;
   G4String                 m_hHadronicModel;
   G4bool                   m_bCerenkov;
+  G4String                 m_hPhysicsMode;
+  G4String                 m_hOpBoundaryModel;
+  G4String                 m_hOpBoundaryTable;
   G4DecayPhysics          *particleList;
 
 };
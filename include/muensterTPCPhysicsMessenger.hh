@@ -42,6 +42,14 @@ private:
   G4UIcmdWithAString         *m_pEMlowEnergyModelCmd;
   G4UIcmdWithAString         *m_pHadronicModelCmd;
   G4UIcmdWithABool           *m_pCerenkovCmd;
+  G4UIcmdWithAString         *m_pPhysicsModeCmd;
+  G4UIcmdWithAString         *m_pOpBoundaryModelCmd;
+  G4UIcmdWithAString         *m_pOpBoundaryTableCmd;
+  G4UIcmdWithADoubleAndUnit  *m_pXenonCutCmd;
+  G4UIcmdWithADoubleAndUnit  *m_pCryostatCutCmd;
+  G4UIcmdWithADoubleAndUnit  *m_pLabCutCmd;
+  G4UIcmdWithAString         *m_pStoreTablesCmd;
+  G4UIcmdWithAString         *m_pRetrieveTablesCmd;
 };
 
 #endif // __MUENSTERTPCPHYSICSMESSENGER_H__
@@ -0,0 +1,38 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Parameterised placement of the PMTs of one array
+ *
+ * @comment - the replica number of a pmt unit plus the first pmt
+ *            number of the array gives the pmt number of the hits
+ ******************************************************************/
+#ifndef __MUENSTERTPCPMTPARAMETERISATION_H__
+#define __MUENSTERTPCPMTPARAMETERISATION_H__
+
+#include <G4VPVParameterisation.hh>
+#include <G4ThreeVector.hh>
+#include <globals.hh>
+
+#include <vector>
+
+using std::vector;
+
+class G4VPhysicalVolume;
+
+class muensterTPCPmtParameterisation: public G4VPVParameterisation {
+public:
+	muensterTPCPmtParameterisation(G4int iFirstPmtNb, const vector<G4ThreeVector> &hPositions);
+	~muensterTPCPmtParameterisation();
+
+	void ComputeTransformation(const G4int iCopyNo, G4VPhysicalVolume *pPhysicalVolume) const;
+
+	G4int GetFirstPmtNb() const {return m_iFirstPmtNb;};
+	G4int GetNbPmts() const {return m_hPositions.size();};
+
+private:
+	G4int m_iFirstPmtNb;
+	vector<G4ThreeVector> m_hPositions;
+};
+
+#endif // __MUENSTERTPCPMTPARAMETERISATION_H__
@@ -20,6 +20,8 @@
 class G4Step;
 class G4HCofThisEvent;
 
+class muensterTPCEventData;
+
 class muensterTPCPmtSensitiveDetector: public G4VSensitiveDetector {
 public:
 	muensterTPCPmtSensitiveDetector(G4String hName);
@@ -29,8 +31,20 @@ public:
 	G4bool ProcessHits(G4Step *pStep, G4TouchableHistory *pHistory);
 	void EndOfEvent(G4HCofThisEvent *pHitsCollectionOfThisEvent);
 
+	// the photons are counted directly in the pmthits and waveforms of the event record
+	void SetEventData(muensterTPCEventData *pEventData) { m_pEventData = pEventData; }
+	// hits objects for the visualization, not needed for the output
+	void SetStoreHits(G4bool bStoreHits) { m_bStoreHits = bStoreHits; }
+
+	// number of photons on the photocathodes in the current event
+	G4int GetNbHits() { return m_iNbHits; }
+
 private:
 	muensterTPCPmtHitsCollection* m_pPmtHitsCollection;
+
+	muensterTPCEventData *m_pEventData;
+	G4bool m_bStoreHits;
+	G4int m_iNbHits;
 };
 
 #endif // __muensterTPCPPMTSENSITIVEDETECTOR_H__
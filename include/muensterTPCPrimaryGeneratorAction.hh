@@ -24,6 +24,7 @@
 class muensterTPCParticleSource;
 
 class G4Event;
+class G4Run;
 
 class muensterTPCPrimaryGeneratorAction: public G4VUserPrimaryGeneratorAction {
 public:
@@ -37,12 +38,28 @@ public:
 	G4ThreeVector GetPositionOfPrimary() { return m_hPositionOfPrimary; }
 
 	void GeneratePrimaries(G4Event *pEvent);
+
+	// the random numbers of each event are seeded from (master seed, run id, event id)
+	void SetMasterSeed(G4long lMasterSeed);
+	G4long GetMasterSeed() { return m_lMasterSeed; }
+	// ids of the first event of the next run, e.g. to simulate a single event again (-1: run id of Geant4)
+	void SetFirstEvent(G4int iEventId, G4int iRunId);
+	void BeginOfRun(const G4Run *pRun);
+	G4int GetRunId() { return m_iRunId; }
+	G4int GetFirstEventId() { return m_iFirstEventId; }
+
 	void     SetWriteEmpty(G4bool doit){writeEmpty = doit;};
 	G4bool   GetWriteEmpty(){return writeEmpty;};
 
   private:
 	muensterTPCPrimaryGeneratorMessenger *m_pMessenger;
 	long m_lSeeds[2];
+	G4bool m_bMasterSeed;
+	G4long m_lMasterSeed;
+	G4int m_iRunId;
+	G4int m_iFirstEventId;
+	G4int m_iNextRunId;
+	G4int m_iNextEventId;
 	G4bool	writeEmpty;
 	G4String m_hParticleTypeOfPrimary;
 	G4double m_dEnergyOfPrimary;
@@ -28,8 +28,9 @@ public:
 
 private:
   muensterTPCPrimaryGeneratorAction *m_pPrimaryGeneratorAction;
-  G4UIdirectory                 *m_pDirectory;
   G4UIcmdWithABool              *m_pWriteEmptyCmd;
+  G4UIcmdWithAnInteger          *m_pSeedCmd;
+  G4UIcommand                   *m_pFirstEventCmd;
 
 };
 
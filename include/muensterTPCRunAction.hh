@@ -28,6 +28,8 @@ public:
 	void BeginOfRunAction(const G4Run *pRun);
 	void EndOfRunAction(const G4Run *pRun);
 
+	muensterTPCAnalysisManager *GetAnalysisManager() { return m_pAnalysisManager; }
+
 private:
 	muensterTPCAnalysisManager *m_pAnalysisManager;
 };
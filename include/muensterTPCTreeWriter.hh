@@ -0,0 +1,58 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * TTree output of the event data
+ *
+ * @comment - the events tree is created in the current directory, the
+ *            branches point to the event record
+ *          - a resumed run continues the events tree of the current
+ *            directory, it is only saved at the checkpoints
+ ******************************************************************/
+#ifndef __MUENSTERTPCTREEWRITER_H__
+#define __MUENSTERTPCTREEWRITER_H__
+
+#include <globals.hh>
+#include <Rtypes.h>
+
+#include <vector>
+#include <utility>
+
+#include "muensterTPCOutputWriter.hh"
+
+class TTree;
+
+class muensterTPCEventData;
+
+class muensterTPCTreeWriter: public muensterTPCOutputWriter {
+public:
+	muensterTPCTreeWriter(muensterTPCEventData *pEventData, const std::vector<std::pair<G4String, G4int> > &hBasketSizes,
+		Long64_t lAutoFlush, Long64_t lAutoSave, G4bool bResume=false);
+	~muensterTPCTreeWriter();
+
+	void Fill();
+	void Close();
+	G4bool Checkpoint();
+
+	// entries of the tree before the resumed run
+	Long64_t GetResumedEntries() { return m_lNbResumedEntries; }
+
+	G4String GetDescription();
+	G4double GetRawSize();
+	G4double GetCompressedSize();
+
+private:
+	// creates the branch or connects the branch of the resumed tree
+	void Branch(const char *szName, void *pAddress, const char *szLeafList);
+	template<class T> void Branch(const char *szName, const char *szClassName, T **pAddress);
+
+private:
+	TTree *m_pTree;
+	G4bool m_bResume;
+	Long64_t m_lNbResumedEntries;
+	Long64_t m_lAutoFlush;
+	Long64_t m_lAutoSave;
+};
+
+#endif // __MUENSTERTPCTREEWRITER_H__
+
@@ -0,0 +1,20 @@
+#!/bin/bash
+# Compare the optical photon throughput of the full physics list with the
+# minimal optical mode (and the reduced Teflon surface model).
+#
+# usage: ./scripts/benchmark_optical.sh [number of events] [source macro]
+NBEVENTS=${1:-10000}
+SOURCE=${2:-macros/src_optPhot_DP_S1.mac}
+EXECUTABLE=./MuensterTPC-MC
+
+# reduced surface model on top of the source macro
+sed '$a/Xe/detector/setTeflonSurfaceModel lambertian' ${SOURCE} > benchmark_lambertian.mac
+
+echo "full physics, unified surfaces"
+${EXECUTABLE} -p macros/preinit.mac -f ${SOURCE} -n ${NBEVENTS} -o benchmark_full.root | grep "Throughput"
+echo "optical mode, unified surfaces"
+${EXECUTABLE} -p macros/preinit_optical.mac -f ${SOURCE} -n ${NBEVENTS} -o benchmark_optical.root | grep "Throughput"
+echo "optical mode, lambertian surfaces"
+${EXECUTABLE} -p macros/preinit_optical.mac -f benchmark_lambertian.mac -n ${NBEVENTS} -o benchmark_lambertian.root | grep "Throughput"
+
+rm -f benchmark_lambertian.mac
@@ -0,0 +1,43 @@
+#!/bin/bash
+# Compare the light collection and the throughput of the slab and the
+# surface (zero-thickness) mesh model.
+#
+# usage: ./scripts/compare_mesh_model.sh [number of events] [source macro] [seed]
+NBEVENTS=${1:-10000}
+SOURCE=${2:-macros/src_optPhot_DP_S1.mac}
+# both runs simulate the same primaries
+SEED=${3:-12345}
+EXECUTABLE=./MuensterTPC-MC
+
+# surface mesh model on top of the source macro
+sed '1i/Xe/detector/setMeshModel surface' ${SOURCE} > compare_mesh_surface.mac
+
+echo "slab mesh model"
+${EXECUTABLE} -p macros/preinit_optical.mac -f ${SOURCE} -n ${NBEVENTS} -s ${SEED} -o compare_mesh_slab.root | grep "Throughput"
+echo "surface mesh model"
+${EXECUTABLE} -p macros/preinit_optical.mac -f compare_mesh_surface.mac -n ${NBEVENTS} -s ${SEED} -o compare_mesh_surface.root | grep "Throughput"
+
+# the output files get a time stamp in front of the name
+SLAB=$(ls -t *_compare_mesh_slab.root | head -1)
+SURFACE=$(ls -t *_compare_mesh_surface.root | head -1)
+
+# pmt hits per simulated event (empty events are not written)
+root -l -b -q -e '
+	const char *szFiles[2] = {"'${SLAB}'", "'${SURFACE}'"};
+	const char *szBranches[2] = {"ntpmthits", "nbpmthits"};
+	const double dNbEvents = '${NBEVENTS}';
+	for(int i=0; i<2; i++) {
+		TTree *t = (TTree *) TFile::Open(szFiles[i])->Get("events/events");
+		t->SetEstimate(t->GetEntries()+1);
+		printf("%s:", szFiles[i]);
+		for(int j=0; j<2; j++) {
+			double dSum = 0., dSum2 = 0.;
+			Long64_t n = t->Draw(szBranches[j], "", "goff");
+			for(Long64_t k=0; k<n; k++) { dSum += t->GetV1()[k]; dSum2 += t->GetV1()[k]*t->GetV1()[k]; }
+			double dMean = dSum/dNbEvents;
+			printf(" %s %.4f +- %.4f", szBranches[j], dMean, sqrt((dSum2/dNbEvents-dMean*dMean)/dNbEvents));
+		}
+		printf(" per event\n");
+	}'
+
+rm -f compare_mesh_surface.mac
@@ -0,0 +1,35 @@
+#!/bin/bash
+# Compare the throughput and the size of the output formats and
+# compression settings with the same source.
+#
+# usage: ./scripts/compare_output_format.sh [number of events] [source macro]
+NBEVENTS=${1:-10000}
+SOURCE=${2:-macros/src_optPhot_DP_S1.mac}
+EXECUTABLE=./MuensterTPC-MC
+
+SETTINGS=(
+	"/Xe/output/format ttree"
+	"/Xe/output/format ttree;/Xe/output/compression lz4"
+	"/Xe/output/format ttree;/Xe/output/compression zstd"
+	"/Xe/output/format rntuple"
+	"/Xe/output/format binary"
+	"/Xe/output/format binary;/Xe/output/compression zlib 6"
+)
+
+for i in "${!SETTINGS[@]}"; do
+	# output settings on top of the source macro
+	echo "${SETTINGS[$i]}" | tr ';' '\n' | cat - ${SOURCE} > compare_output_format.mac
+
+	echo "${SETTINGS[$i]}"
+	${EXECUTABLE} -p macros/preinit.mac -f compare_output_format.mac -n ${NBEVENTS} -o compare_output_format_${i}.root \
+		| grep "Throughput\|Output:"
+done
+
+# conversion of the binary files into the ttree format
+for hFile in *compare_output_format_*.evb; do
+	[ -f "${hFile}" ] || continue
+	TIMEFORMAT="conversion of ${hFile}: %R s"
+	time ${EXECUTABLE} -c ${hFile} | grep "Converted"
+done
+
+rm -f compare_output_format.mac
@@ -0,0 +1,32 @@
+#!/bin/bash
+# Compare the optical photon throughput of the placed and the parameterised
+# PMT arrays and check that both give the same PMT hits event by event.
+#
+# usage: ./scripts/compare_pmt_placement.sh [number of events] [source macro] [seed]
+NBEVENTS=${1:-10000}
+SOURCE=${2:-macros/src_optPhot_DP_S1.mac}
+# both runs simulate the same events
+SEED=${3:-12345}
+EXECUTABLE=./MuensterTPC-MC
+
+# same preinit with the parameterised arrays
+sed '/\/run\/initialize/i/Xe/detector/setPmtPlacement parameterised' macros/preinit_optical.mac > compare_parameterised.mac
+
+echo "placed pmt arrays"
+${EXECUTABLE} -p macros/preinit_optical.mac -f ${SOURCE} -n ${NBEVENTS} -s ${SEED} -o compare_placement.root | grep "Throughput"
+echo "parameterised pmt arrays"
+${EXECUTABLE} -p compare_parameterised.mac -f ${SOURCE} -n ${NBEVENTS} -s ${SEED} -o compare_parameterised.root | grep "Throughput"
+
+# the output files get a time stamp in front of the name
+PLACEMENT=$(ls -t *_compare_placement.root | head -1)
+PARAMETERISED=$(ls -t *_compare_parameterised.root | head -1)
+
+# number of events with different pmt hits
+root -l -b -q -e '
+	TFile *f1 = TFile::Open("'${PLACEMENT}'");
+	TTree *t1 = (TTree *) f1->Get("events/events");
+	t1->AddFriend("p = events/events", "'${PARAMETERISED}'");
+	Long64_t n = t1->GetEntries("Length$(pmthits) != Length$(p.pmthits) || Sum$(pmthits != p.pmthits) > 0");
+	std::cout << "events with different pmt hits: " << n << " of " << t1->GetEntries() << std::endl;'
+
+rm -f compare_parameterised.mac
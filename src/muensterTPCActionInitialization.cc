@@ -21,20 +21,27 @@
 #include "muensterTPCStackingAction.hh"
 #include "muensterTPCRunAction.hh"
 #include "muensterTPCEventAction.hh"
+#include "muensterTPCParameterScan.hh"
 
-muensterTPCActionInitialization::muensterTPCActionInitialization (std::string NewDatafileName, muensterTPCPrimaryGeneratorAction *pNewPrimaryGeneratorAction) {	
+muensterTPCActionInitialization::muensterTPCActionInitialization (std::string NewDatafileName, muensterTPCPrimaryGeneratorAction *pNewPrimaryGeneratorAction, std::string CheckpointFilename) {	
 	pPrimaryGeneratorAction = pNewPrimaryGeneratorAction;
   
 	// create an analysis manager object
 	pAnalysisManager = new muensterTPCAnalysisManager(pPrimaryGeneratorAction);
 	// set the filename for the root datafile
 	pAnalysisManager->SetDataFilename(NewDatafileName);
+	// a resumed run writes into the datafile of the checkpoint
+	if(!CheckpointFilename.empty())
+		pAnalysisManager->SetResume(CheckpointFilename);
+
+	// parameter scans write into the same datafile
+	pParameterScan = new muensterTPCParameterScan(pAnalysisManager);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 muensterTPCActionInitialization::~muensterTPCActionInitialization() {
-
+	delete pParameterScan;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
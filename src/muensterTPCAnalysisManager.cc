@@ -16,12 +16,18 @@
 #include <G4SDManager.hh>
 #include <G4Run.hh>
 #include <G4Event.hh>
-#include <G4HCofThisEvent.hh>
 #include <G4SystemOfUnits.hh>
 #include <G4Version.hh>
+#include <G4Timer.hh>
+#include <G4PrimaryVertex.hh>
+#include <G4EventManager.hh>
 
 // include C++ classes
 #include <numeric>
+#include <chrono>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
 
 // include ROOT classes
 #include <TROOT.h>
@@ -33,9 +39,15 @@
 // include Muenster TPC classes
 #include "muensterTPCPrimaryGeneratorAction.hh"
 #include "muensterTPCAnalysisManager.hh"
+#include "muensterTPCAnalysisMessenger.hh"
+#include "muensterTPCTreeWriter.hh"
+#include "muensterTPCNTupleWriter.hh"
+#include "muensterTPCBinaryWriter.hh"
 #include "muensterTPCEventData.hh"
-#include "muensterTPCLXeHit.hh"
-#include "muensterTPCPmtHit.hh"
+#include "muensterTPCEventFilter.hh"
+#include "muensterTPCCheckpoint.hh"
+#include "muensterTPCLXeSensitiveDetector.hh"
+#include "muensterTPCPmtSensitiveDetector.hh"
 #include "muensterTPCDetectorConstruction.hh"
 
 //******************************************************************/
@@ -44,9 +56,18 @@
 muensterTPCAnalysisManager::muensterTPCAnalysisManager(muensterTPCPrimaryGeneratorAction *pPrimaryGeneratorAction) {
   G4int threadID = G4Threading::IsMultithreadedApplication() ? G4Threading::G4GetThreadId() : 0;
 	
-	// initialization of the HitsCollectionID variables 
-	m_iLXeHitsCollectionID = -1;
-	m_iPmtHitsCollectionID = -1;
+	// the sensitive detectors are known at the beginning of the run
+	m_pLXeSensitiveDetector = 0;
+	m_pPmtSensitiveDetector = 0;
+	m_bStoreHits = false;
+
+	// step fields of the output
+	m_iStepFields = muensterTPCEventData::eDefaultStepFields;
+
+	// no waveforms
+	m_iNbWaveformBins = 0;
+	m_dWaveformBinWidth = 10.*ns;
+	m_dWaveformStartTime = 0.;
 
 	// default output file name (which should be redifined in the main class)
 	m_hDataFilename = "events.root";
@@ -56,6 +77,45 @@ muensterTPCAnalysisManager::muensterTPCAnalysisManager(muensterTPCPrimaryGenerat
 	// declaration of the EventData class
 	m_pEventData = new muensterTPCEventData();
 	writeEmptyEvents = kFALSE;
+
+	m_hScanDirectory = "";
+	m_hScanDescription = "";
+	m_bAppendToFile = false;
+
+	m_pRunTimer = new G4Timer();
+	m_lNbPrimaries = 0;
+
+	m_dEndOfEventTime = 0.;
+	m_lNbEndOfEventHits = 0;
+
+	m_iNbTopPmts = 0;
+	m_iNbBottomPmts = 0;
+
+	m_hOutputFormat = "ttree";
+	m_pTreeFile = 0;
+	m_pOutputWriter = 0;
+
+	// ROOT defaults
+	m_hCompression = "default";
+	m_iCompressionSetting = -1;
+	m_lAutoFlush = -30000000;
+	m_lAutoSave = -300000000;
+	m_dFillTime = 0.;
+
+	// no checkpoints
+	m_pCheckpoint = new muensterTPCCheckpoint();
+	m_iCheckpointInterval = 0;
+	m_bCheckpoints = false;
+	m_bResume = false;
+	m_bPushingPostponedTracks = false;
+	m_iEventIdOffset = 0;
+	m_lNbResumedEntries = 0;
+
+	m_bCalibration = false;
+	m_hJobDataFilename = "";
+
+	m_pMessenger = new muensterTPCAnalysisMessenger(this);
+	m_pEventFilter = new muensterTPCEventFilter();
 }
 
 
@@ -63,6 +123,10 @@ muensterTPCAnalysisManager::muensterTPCAnalysisManager(muensterTPCPrimaryGenerat
 //
 //******************************************************************/
 muensterTPCAnalysisManager::~muensterTPCAnalysisManager(){
+	delete m_pCheckpoint;
+	delete m_pEventFilter;
+	delete m_pMessenger;
+	delete m_pRunTimer;
 }
 
 //******************************************************************/
@@ -72,303 +136,666 @@ void muensterTPCAnalysisManager::BeginOfRun(const G4Run *pRun) {
 		// do we write empty events or not?
 		writeEmptyEvents = m_pPrimaryGeneratorAction->GetWriteEmpty();
   
-		// create output file
-		m_pTreeFile = new TFile(m_hDataFilename.c_str(), "RECREATE", "File containing event data for muensterTPCsim");
-		TNamed *G4version = new TNamed("G4VERSION_TAG",G4VERSION_TAG);
-		G4version->Write();
-		TNamed *G4MCname = new TNamed("MC_TAG","muensterTPC");
-		G4MCname->Write();
-		TNamed *G4MCVersion = new TNamed("MCVERSION_TAG","X.Y.Z");
-		G4MCname->Write();
-		
-		_events = m_pTreeFile->mkdir("events");
-		_events->cd();
-		
-		// create ROOT Tree for the simulation data
-		m_pTree = new TTree("events", "Tree containing event data for muensterTPCsim");
-
-		// include missing ROOT classes
-		gROOT->ProcessLine("#include <vector>");
-
-		// initialize all tree branches for the different data types
-
-		//******************************************************************/	
-		// branches for each main event/particle beam:
-		//******************************************************************/
-		// eventid:	The eventid contains the individual ID of each event. Since 'event' is used in different situations,
-		//					it means, every particle created by 'beamOn' starts a detector event. All following events will be
-		//					be saved within the same eventid in specific branches (see below).
-		//					Acces to the eventid in ROOT: int eventid;
-		//																				T1->SetBranchAddress("eventid", &eventid);
-		m_pTree->Branch("eventid", &m_pEventData->m_iEventId, "eventid/I");
-		// ntpmthits:	total amount of top PMT hits for a specific eventid/particle beam
-		//						Acces in ROOT: 	int ntpmthits;
-		//														T1->SetBranchAddress("ntpmthits", &ntpmthits);
-		m_pTree->Branch("ntpmthits", &m_pEventData->m_iNbTopPmtHits, "ntpmthits/I");
-		// nbpmthits:	total amount of bottom PMT hits for a specific eventid/particle beam
-		//						Acces in ROOT: 	int nbpmthits;
-		//														T1->SetBranchAddress("nbpmthits", &nbpmthits);
-		m_pTree->Branch("nbpmthits", &m_pEventData->m_iNbBottomPmtHits, "nbpmthits/I");
-
-		//m_pTree->Branch("ntvetopmthits", &m_pEventData->m_iNbTopVetoPmtHits, "ntvetopmthits/I");
-		//m_pTree->Branch("nbvetopmthits", &m_pEventData->m_iNbBottomVetoPmtHits, "nbvetopmthits/I");
-
-		// pmthits:	total amount of PMT hits for a specific eventid and for each PMT
-		//						Acces in ROOT: 	vector<int> *pmthits= new vector<int>;
-		//														T1->SetBranchAddress("pmthits", &pmthits);
-		//						Note: Do not access pmthits without calling a specifig vector element.
-		m_pTree->Branch("pmthits", "vector<int>", &m_pEventData->m_pPmtHits);
-		// etot:	Amount of energy, which is deopsited during this eventid/particle run.
-		//				Acces in ROOT: 	float etot;
-		//												T1->SetBranchAddress("etot", &etot);
-		m_pTree->Branch("etot", &m_pEventData->m_fTotalEnergyDeposited, "etot/F");
-		// nbpmthits:	total amount of bottom PMT hits for a specific eventid/particle beam
-		//						Acces in ROOT: 	int nbpmthits;
-		//														T1->SetBranchAddress("nbpmthits", &nbpmthits);
-		m_pTree->Branch("nsteps", &m_pEventData->m_iNbSteps, "nsteps/I");
-	
-		//******************************************************************/	
-		// branches for each event/particle which is created by the main event
-		//******************************************************************/
-		// trackid:	ID of the current event in the event track. All listed events are
-		//					generated within the main eventid. (e.g. emitted gammas)
-		//					Acces in ROOT: 	vector<int> *trackid= new vector<int>;
-		//													T1->SetBranchAddress("trackid", &trackid);
-		m_pTree->Branch("trackid", "vector<int>", &m_pEventData->m_pTrackId);
-		// type:	type of the particles in the event track
-		//				Acces in ROOT: 	vector<string> *type= new vector<string>;
-		//												T1->SetBranchAddress("type", &type);
-		m_pTree->Branch("type", "vector<string>", &m_pEventData->m_pParticleType);
-		// parentid:	trackid of the parent track event
-		//						Acces in ROOT: 	vector<int> *parentid= new vector<int>;
-		//														T1->SetBranchAddress("parentid", &parentid);
-		m_pTree->Branch("parentid", "vector<int>", &m_pEventData->m_pParentId);
-		// parenttype:	parenttype of the parent track event
-		//							Acces in ROOT: 	vector<string> *parenttype= new vector<string>;
-		//															T1->SetBranchAddress("parenttype", &parenttype);
-		m_pTree->Branch("parenttype", "vector<string>", &m_pEventData->m_pParentType);
-		// creaproc:	name of the creation process of the track particle/trackid
-		//						Acces in ROOT: 	vector<string> *creaproc= new vector<string>;
-		//														T1->SetBranchAddress("creaproc", &creaproc);
-		m_pTree->Branch("creaproc", "vector<string>", &m_pEventData->m_pCreatorProcess);
-		// edproc:	name of the energy deposition process of the track particle/trackid
-		//					Acces in ROOT: 	vector<string> *edproc= new vector<string>;
-		//													T1->SetBranchAddress("edproc", &edproc);
-		m_pTree->Branch("edproc", "vector<string>", &m_pEventData->m_pDepositingProcess);
-		// Positions of the current particle/trackid
-		// 		Acces in ROOT: 		vector<float> *xp= new vector<float>;
-		//											T1->SetBranchAddress("xp", &xp);
-		m_pTree->Branch("xp", "vector<float>", &m_pEventData->m_pX);
-		// 		Acces in ROOT: 		vector<float> *yp= new vector<float>;
-		//											T1->SetBranchAddress("yp", &yp);
-		m_pTree->Branch("yp", "vector<float>", &m_pEventData->m_pY);
-		// 		Acces in ROOT: 		vector<float> *zp= new vector<float>;
-		//											T1->SetBranchAddress("zp", &zp);
-		m_pTree->Branch("zp", "vector<float>", &m_pEventData->m_pZ);
-		// ed:	energy deposition of the current particle/trackid
-		// 			Acces in ROOT: 		vector<float> *ed= new vector<float>;
-		//												T1->SetBranchAddress("ed", &ed);
-		m_pTree->Branch("ed", "vector<float>", &m_pEventData->m_pEnergyDeposited);
-		// time:	timestamp of the current particle/trackid
-		// 				Acces in ROOT: 		vector<float> *time= new vector<float>;
-		//													T1->SetBranchAddress("time", &time);
-		m_pTree->Branch("time", "vector<float>", &m_pEventData->m_pTime);
-
-		//******************************************************************/	
-		// branches for each event/particle which contain information about the primary particle
-		//******************************************************************/
-		// type_pri:	type of the primary event/main event
-		//						Acces in ROOT: 	vector<string> *type_pri= new vector<string>;
-		//														T1->SetBranchAddress("type_pri", &type_pri);
-		m_pTree->Branch("type_pri", "vector<string>", &m_pEventData->m_pPrimaryParticleType);
-		// Energy and positions of the current particle/trackid
-		// 		Acces in ROOT:	vector<float> *e_pri= new vector<float>;
-		//										T1->SetBranchAddress("e_pri", &e_pri);
-		m_pTree->Branch("e_pri", &m_pEventData->m_fPrimaryEnergy, "e_pri/F");
-		// 		Acces in ROOT:	vector<float> *xp_pri= new vector<float>;
-		//										T1->SetBranchAddress("xp_pri", &xp_pri);
-		m_pTree->Branch("xp_pri", &m_pEventData->m_fPrimaryX, "xp_pri/F");
-		// 		Acces in ROOT:	vector<float> *yp_pri= new vector<float>;
-		//										T1->SetBranchAddress("yp_pri", &yp_pri);	
-		m_pTree->Branch("yp_pri", &m_pEventData->m_fPrimaryY, "yp_pri/F");
-		// 		Acces in ROOT:	vector<float> *zp_pri= new vector<float>;
-		//										T1->SetBranchAddress("zp_pri", &zp_pri);
-		m_pTree->Branch("zp_pri", &m_pEventData->m_fPrimaryZ, "zp_pri/F");
-
-		//m_pTree->SetMaxTreeSize(10e9); /previous
-		m_pTree->SetMaxTreeSize(1000*Long64_t(2000000000)); //2TB
-		m_pTree->AutoSave();
-	
-		// Write the number of events in the output file
 		m_iNbEventsToSimulate = pRun->GetNumberOfEventToBeProcessed();
-		m_pNbEventsToSimulateParameter = new TParameter<int>("nbevents", m_iNbEventsToSimulate);
-		m_pNbEventsToSimulateParameter->Write();
+
+		// a resumed run continues the events tree, the event ids and the random numbers of the checkpoint
+		const G4bool bResume = m_bResume;
+		m_bResume = false;
+		m_lNbResumedEntries = 0;
+		if(bResume)
+		{
+			if(!m_hScanDirectory.empty())
+			{
+				G4cout << "!!!!> A parameter scan cannot be resumed!" << G4endl;
+				exit(-1);
+			}
+			if(m_hOutputFormat != "ttree")
+			{
+				G4cout << "--> warning from AnalysisManager::BeginOfRun : checkpoints are written with the ttree format, resuming with it" << G4endl;
+				m_hOutputFormat = "ttree";
+			}
+
+			m_pPrimaryGeneratorAction->SetMasterSeed(m_pCheckpoint->m_lMasterSeed);
+			m_pPrimaryGeneratorAction->SetFirstEvent(m_pCheckpoint->m_iLastEventId+1, m_pCheckpoint->m_iRunId);
+			if(!m_pCheckpoint->RestoreRandomEngine())
+			{
+				G4cout << "!!!!> Random engine of the checkpoint not restored!" << G4endl;
+				exit(-1);
+			}
+		}
+
+		// event seeds and event ids of this run
+		m_pPrimaryGeneratorAction->BeginOfRun(pRun);
+		m_iEventIdOffset = m_pPrimaryGeneratorAction->GetFirstEventId();
+
+		// the tree is only saved at the checkpoints, it never holds events after the last checkpoint
+		m_bCheckpoints = (m_iCheckpointInterval > 0 && !m_bCalibration);
+		if(m_bCheckpoints && (m_hOutputFormat != "ttree" || !m_hScanDirectory.empty()))
+		{
+			G4cout << "--> warning from AnalysisManager::BeginOfRun : checkpoints need the ttree format outside of parameter scans, no checkpoints in this run" << G4endl;
+			m_bCheckpoints = false;
+		}
+
+		// snapshot of the geometry parameters for this run
+		m_hGeometryParameters = muensterTPCDetectorConstruction::GetGeometryParameters();
+		m_iNbTopPmts = (G4int) m_hGeometryParameters[muensterTPCDetectorConstruction::NbTopPmts];
+		m_iNbBottomPmts = (G4int) m_hGeometryParameters[muensterTPCDetectorConstruction::NbBottomPmts];
+
+		// one entry per pmt of the layout, reset after every event
+		m_pEventData->m_pPmtHits->assign(m_iNbTopPmts+m_iNbBottomPmts, 0);
+		m_pEventData->SetWaveform(m_iNbTopPmts+m_iNbBottomPmts, m_iNbWaveformBins,
+			m_dWaveformBinWidth/ns, m_dWaveformStartTime/ns, m_hSpeResponse);
+
+		// the fiducial volume of the event filter is the drift region by default
+		m_pEventFilter->BeginOfRun(m_hGeometryParameters[muensterTPCDetectorConstruction::DriftLength],
+			m_hGeometryParameters[muensterTPCDetectorConstruction::TeflonCentralCylinderInnerRadius]);
+
+		// the step cuts of the filter need the positions and energies
+		const G4int iCutStepFields = muensterTPCEventData::eStepX | muensterTPCEventData::eStepY
+			| muensterTPCEventData::eStepZ | muensterTPCEventData::eStepEnergyDeposited;
+		const G4int iFilterStepFields = (m_pEventFilter->NeedsSteps())?(iCutStepFields):(0);
+
+		// the writers create the branches of the step fields of the record
+		m_pEventData->SetStepFields(m_iStepFields | iFilterStepFields);
+
+		if(m_hOutputFormat == "binary") {
+			// no ROOT at event time, the metadata are written into the header of the binary file
+			m_pTreeFile = 0;
+			m_pOutputWriter = new muensterTPCBinaryWriter(m_pEventData, GetBinaryFilename(), GetMetadata(),
+				(m_iCompressionSetting == -1)?(1):(m_iCompressionSetting % 100), m_lAutoFlush);
+		} else {
+			// create output file, the points of a parameter scan are added to the same file
+			if(bResume) {
+				// ROOT recovers the tree of the last AutoSave
+				m_pTreeFile = new TFile(m_hDataFilename.c_str(), "UPDATE", "File containing event data for muensterTPCsim");
+			} else if(m_bAppendToFile) {
+				m_pTreeFile = new TFile(m_hDataFilename.c_str(), "UPDATE", "File containing event data for muensterTPCsim");
+			} else {
+				m_pTreeFile = new TFile(m_hDataFilename.c_str(), "RECREATE", "File containing event data for muensterTPCsim");
+				TNamed *G4version = new TNamed("G4VERSION_TAG",G4VERSION_TAG);
+				G4version->Write();
+				TNamed *G4MCname = new TNamed("MC_TAG","muensterTPC");
+				G4MCname->Write();
+				TNamed *G4MCVersion = new TNamed("MCVERSION_TAG","X.Y.Z");
+				G4MCname->Write();
+			}
+
+			// the branches take the compression of the file when they are created
+			if(m_iCompressionSetting != -1)
+				m_pTreeFile->SetCompressionSettings(m_iCompressionSetting);
+		
+			if(bResume) {
+				_events = (m_pTreeFile->IsZombie())?(0):(m_pTreeFile->GetDirectory("events"));
+				if(!_events)
+				{
+					G4cout << "!!!!> No events in " << m_hDataFilename << " to resume!" << G4endl;
+					exit(-1);
+				}
+			} else if(m_hScanDirectory.empty()) {
+				_events = m_pTreeFile->mkdir("events");
+			} else {
+				// point_XXXX/parameters + point_XXXX/events
+				TDirectory *pScanDirectory = m_pTreeFile->mkdir(m_hScanDirectory.c_str());
+				pScanDirectory->cd();
+				TNamed *pScanParameters = new TNamed("parameters", m_hScanDescription.c_str());
+				pScanParameters->Write();
+				_events = pScanDirectory->mkdir("events");
+			}
+			_events->cd();
+
+			// event data output
+			if(m_hOutputFormat == "rntuple")
+				m_pOutputWriter = new muensterTPCNTupleWriter(m_pEventData, _events, m_iCompressionSetting);
+			else if(m_hOutputFormat == "histograms")
+				m_pOutputWriter = new muensterTPCHistogramWriter(m_pEventData,
+					(m_hHistograms.empty())?(muensterTPCHistogramWriter::GetDefaultHistograms()):(m_hHistograms));
+			else
+			{
+				muensterTPCTreeWriter *pTreeWriter = new muensterTPCTreeWriter(m_pEventData, m_hBasketSizes, m_lAutoFlush,
+					(m_bCheckpoints)?(0):(m_lAutoSave), bResume);
+				m_pOutputWriter = pTreeWriter;
+
+				if(bResume)
+				{
+					m_lNbResumedEntries = pTreeWriter->GetResumedEntries();
+					if(m_lNbResumedEntries != m_pCheckpoint->m_lNbEntries)
+						G4cout << "--> warning from AnalysisManager::BeginOfRun : " << m_lNbResumedEntries << " events in the tree, "
+						       << m_pCheckpoint->m_lNbEntries << " in the checkpoint" << G4endl;
+					G4cout << "----> Resuming " << m_hDataFilename << " at event " << m_iEventIdOffset << " with "
+					       << m_lNbResumedEntries << " events and " << m_pCheckpoint->GetNbPostponedTracks() << " postponed tracks" << G4endl;
+				}
+			}
+
+			// Write the number of events in the output file, a resumed run has them already
+			if(!bResume) {
+				m_pNbEventsToSimulateParameter = new TParameter<int>("nbevents", m_iNbEventsToSimulate);
+				m_pNbEventsToSimulateParameter->Write();
+
+				// any event is simulated again with the master seed, run id and its event id
+				TParameter<Long64_t> *pSeedParameter = new TParameter<Long64_t>("seed", m_pPrimaryGeneratorAction->GetMasterSeed());
+				pSeedParameter->Write();
+				TParameter<int> *pRunIdParameter = new TParameter<int>("runid", m_pPrimaryGeneratorAction->GetRunId());
+				pRunIdParameter->Write();
+			}
+
+			// binning of the waveforms in ns
+			if(m_pEventData->HasWaveforms() && !bResume)
+			{
+				TParameter<int> *pNbBinsParameter = new TParameter<int>("wfnbins", m_iNbWaveformBins);
+				pNbBinsParameter->Write();
+				TParameter<double> *pBinWidthParameter = new TParameter<double>("wfbinwidth", m_dWaveformBinWidth/ns);
+				pBinWidthParameter->Write();
+				TParameter<double> *pStartTimeParameter = new TParameter<double>("wfstart", m_dWaveformStartTime/ns);
+				pStartTimeParameter->Write();
+			}
+		}
+
+		// the steps are not needed for the histograms format without step cuts
+		if(!m_pOutputWriter->NeedsSteps())
+			m_pEventData->SetStepFields(iFilterStepFields);
+
+		// the sensitive detectors of this thread write into the event record
+		G4SDManager *pSDManager = G4SDManager::GetSDMpointer();
+		m_pLXeSensitiveDetector = dynamic_cast<muensterTPCLXeSensitiveDetector *>(pSDManager->FindSensitiveDetector("muensterTPC/LXeSD", false));
+		m_pPmtSensitiveDetector = dynamic_cast<muensterTPCPmtSensitiveDetector *>(pSDManager->FindSensitiveDetector("muensterTPC/PmtSD", false));
+
+		if(m_pLXeSensitiveDetector)
+		{
+			m_pLXeSensitiveDetector->SetEventData(m_pEventData);
+			m_pLXeSensitiveDetector->SetStoreHits(m_bStoreHits);
+		}
+		if(m_pPmtSensitiveDetector)
+		{
+			m_pPmtSensitiveDetector->SetEventData(m_pEventData);
+			m_pPmtSensitiveDetector->SetStoreHits(m_bStoreHits);
+		}
+
+		// the postponed tracks of the checkpoint become the primaries of the next events (PrimaryGeneratorAction)
+		if(bResume)
+		{
+			m_bPushingPostponedTracks = true;
+			m_pCheckpoint->PushPostponedTracks(G4EventManager::GetEventManager()->GetStackManager());
+			m_bPushingPostponedTracks = false;
+		}
+
+		m_lNbPrimaries = 0;
+		m_dEndOfEventTime = 0.;
+		m_lNbEndOfEventHits = 0;
+		m_dFillTime = 0.;
+		m_pRunTimer->Start();
 }
 
 //******************************************************************/
-// EndOfRun action/end of the simulation
+// SetScanPoint
 //******************************************************************/
-void muensterTPCAnalysisManager::EndOfRun(const G4Run *pRun) {
-		// write and remove old revisions
-		m_pTreeFile->Write(0,TObject::kOverwrite);
-		//m_pTreeFile->Write();
-		m_pTreeFile->Close();
+void muensterTPCAnalysisManager::SetScanPoint(const G4String &hDirectory, const G4String &hDescription, G4bool bAppendToFile) {
+	m_hScanDirectory = hDirectory;
+	m_hScanDescription = hDescription;
+	m_bAppendToFile = bAppendToFile;
 }
 
 //******************************************************************/
-//	BeginOfEvent action - for each beamed particle
+// GetBinaryFilename - events.root -> events.evb, events_point_XXXX.evb
 //******************************************************************/
-void muensterTPCAnalysisManager::BeginOfEvent(const G4Event *pEvent) {
-	// initialize the HitCollections if needed (-1 = not initialized)
-	//G4cout << "Begin of Event" << G4endl;
-	if(m_iLXeHitsCollectionID == -1)
-	{
-		G4SDManager *pSDManager = G4SDManager::GetSDMpointer();
-		m_iLXeHitsCollectionID = pSDManager->GetCollectionID("LXeHitsCollection");
-	} 
+G4String muensterTPCAnalysisManager::GetBinaryFilename() {
+	G4String hFilename = m_hDataFilename;
+	if(hFilename.size() > 5 && hFilename.substr(hFilename.size()-5) == ".root")
+		hFilename = hFilename.substr(0, hFilename.size()-5);
+
+	if(!m_hScanDirectory.empty())
+		hFilename += "_" + m_hScanDirectory;
+
+	return hFilename + ".evb";
+}
 
-	if(m_iPmtHitsCollectionID == -1)
+//******************************************************************/
+// GetMetadata - header of the binary file
+//******************************************************************/
+G4String muensterTPCAnalysisManager::GetMetadata() {
+	std::stringstream hStream;
+	hStream << "G4VERSION_TAG " << G4VERSION_TAG << "\n";
+	hStream << "MC_TAG muensterTPC\n";
+	hStream << "nbevents " << m_iNbEventsToSimulate << "\n";
+	hStream << "seed " << m_pPrimaryGeneratorAction->GetMasterSeed() << " " << m_pPrimaryGeneratorAction->GetRunId() << "\n";
+	hStream << "fields" << GetStepFieldNames(m_pEventData->GetStepFields()) << "\n";
+	if(m_pEventData->HasWaveforms())
+		hStream << "waveform " << m_iNbWaveformBins << " " << m_dWaveformBinWidth/ns << " " << m_dWaveformStartTime/ns << "\n";
+	if(!m_hScanDirectory.empty())
+		hStream << "directory " << m_hScanDirectory << "\n" << "parameters " << m_hScanDescription << "\n";
+
+	return hStream.str();
+}
+
+//******************************************************************/
+// SetOutputFormat
+//******************************************************************/
+void muensterTPCAnalysisManager::SetOutputFormat(const G4String &hFormat) {
+	if(hFormat == "rntuple" && !muensterTPCNTupleWriter::IsAvailable())
 	{
-		G4SDManager *pSDManager = G4SDManager::GetSDMpointer();
-		m_iPmtHitsCollectionID = pSDManager->GetCollectionID("PmtHitsCollection");
+		G4cout << "--> warning from AnalysisManager::SetOutputFormat : RNTuple needs ROOT 6.34 or newer, keeping the TTree output" << G4endl;
+		return;
 	}
+
+	m_hOutputFormat = hFormat;
+
+	G4cout << "----> Setting output format to " << m_hOutputFormat << G4endl;
 }
 
 //******************************************************************/
-// EndOfEvent action - getting all event data
+// AddHistogram
 //******************************************************************/
-void muensterTPCAnalysisManager::EndOfEvent(const G4Event *pEvent) {
-	G4HCofThisEvent* pHCofThisEvent = pEvent->GetHCofThisEvent();
-	muensterTPCLXeHitsCollection* pLXeHitsCollection = 0;
-	muensterTPCPmtHitsCollection* pPmtHitsCollection = 0;
-
-	G4int iNbLXeHits = 0, iNbPmtHits = 0;
-	
-	if(pHCofThisEvent)
+void muensterTPCAnalysisManager::AddHistogram(const muensterTPCHistogramWriter::Histogram &hHistogram) {
+	for(G4int i=0; i<hHistogram.iDimension; i++)
 	{
-		if(m_iLXeHitsCollectionID != -1)
+		if(!muensterTPCHistogramWriter::IsVariable(hHistogram.hVariables[i]))
 		{
-			pLXeHitsCollection = (muensterTPCLXeHitsCollection *)(pHCofThisEvent->GetHC(m_iLXeHitsCollectionID));
-			iNbLXeHits = (pLXeHitsCollection)?(pLXeHitsCollection->entries()):(0);
+			G4cout << "--> warning from AnalysisManager::AddHistogram : unknown variable " << hHistogram.hVariables[i] << G4endl;
+			return;
 		}
+	}
 
-		if(m_iPmtHitsCollectionID != -1)
+	for(G4int i=0; i<(G4int) m_hHistograms.size(); i++)
+	{
+		if(m_hHistograms[i].hName == hHistogram.hName)
 		{
-			pPmtHitsCollection = (muensterTPCPmtHitsCollection *)(pHCofThisEvent->GetHC(m_iPmtHitsCollectionID));
-			iNbPmtHits = (pPmtHitsCollection)?(pPmtHitsCollection->entries()):(0);
+			G4cout << "--> warning from AnalysisManager::AddHistogram : histogram " << hHistogram.hName << " exists already" << G4endl;
+			return;
 		}
 	}
 
-	m_pEventData->m_iEventId = pEvent->GetEventID();
+	m_hHistograms.push_back(hHistogram);
 
-	m_pEventData->m_pPrimaryParticleType->push_back(m_pPrimaryGeneratorAction->GetParticleTypeOfPrimary());
+	G4cout << "----> Adding " << hHistogram.iDimension << "D histogram " << hHistogram.hName << G4endl;
+}
 
-	m_pEventData->m_fPrimaryEnergy = m_pPrimaryGeneratorAction->GetEnergyOfPrimary()/keV;
-	m_pEventData->m_fPrimaryX = m_pPrimaryGeneratorAction->GetPositionOfPrimary().x()/mm;
-	m_pEventData->m_fPrimaryY = m_pPrimaryGeneratorAction->GetPositionOfPrimary().y()/mm;
-	m_pEventData->m_fPrimaryZ = m_pPrimaryGeneratorAction->GetPositionOfPrimary().z()/mm;
+//******************************************************************/
+// ClearHistograms
+//******************************************************************/
+void muensterTPCAnalysisManager::ClearHistograms() {
+	m_hHistograms.clear();
+}
 
-	G4int iNbSteps = 0;
-	G4float fTotalEnergyDeposited = 0.;
-	
-	if(iNbLXeHits || iNbPmtHits)
+//******************************************************************/
+// SetCompression
+//******************************************************************/
+void muensterTPCAnalysisManager::SetCompression(const G4String &hAlgorithm, G4int iLevel) {
+	// ROOT algorithm numbers and recommended levels (ROOT::RCompressionSetting)
+	G4int iAlgorithm = 0, iDefaultLevel = 0;
+	if(hAlgorithm == "zlib") { iAlgorithm = 1; iDefaultLevel = 1; }
+	else if(hAlgorithm == "lzma") { iAlgorithm = 2; iDefaultLevel = 7; }
+	else if(hAlgorithm == "lz4") { iAlgorithm = 4; iDefaultLevel = 4; }
+	else if(hAlgorithm == "zstd") { iAlgorithm = 5; iDefaultLevel = 5; }
+	else if(hAlgorithm != "default")
+	{
+		G4cout << "--> warning from AnalysisManager::SetCompression : unknown algorithm " << hAlgorithm << G4endl;
+		return;
+	}
+
+	if(hAlgorithm == "default")
+	{
+		m_hCompression = "default";
+		m_iCompressionSetting = -1;
+	}
+	else
+	{
+		if(iLevel < 0)
+			iLevel = iDefaultLevel;
+
+		std::stringstream hStream;
+		hStream << hAlgorithm << " " << iLevel;
+		m_hCompression = hStream.str();
+		m_iCompressionSetting = 100*iAlgorithm + iLevel;
+	}
+
+	G4cout << "----> Setting output compression to " << m_hCompression << G4endl;
+}
+
+//******************************************************************/
+// SetBasketSize
+//******************************************************************/
+void muensterTPCAnalysisManager::SetBasketSize(const G4String &hBranch, G4int iBytes) {
+	m_hBasketSizes.push_back(std::make_pair(hBranch, iBytes));
+
+	G4cout << "----> Setting basket size of " << hBranch << " to " << iBytes << " bytes" << G4endl;
+}
+
+//******************************************************************/
+// SetAutoFlush
+//******************************************************************/
+void muensterTPCAnalysisManager::SetAutoFlush(Long64_t lAutoFlush) {
+	m_lAutoFlush = lAutoFlush;
+
+	G4cout << "----> Setting autoflush to " << lAutoFlush << ((lAutoFlush < 0)?(" bytes"):(" entries")) << G4endl;
+}
+
+//******************************************************************/
+// SetAutoSave
+//******************************************************************/
+void muensterTPCAnalysisManager::SetAutoSave(Long64_t lAutoSave) {
+	m_lAutoSave = lAutoSave;
+
+	G4cout << "----> Setting autosave to every " << ((lAutoSave < 0)?(-lAutoSave):(lAutoSave)) << ((lAutoSave < 0)?(" bytes"):(" entries")) << G4endl;
+}
+
+//******************************************************************/
+// SetStepFields - branch names, "default", "all" or "none"
+//******************************************************************/
+void muensterTPCAnalysisManager::SetStepFields(const G4String &hFields) {
+	std::istringstream hStream(hFields);
+	std::string hName;
+	G4int iStepFields = 0;
+
+	while(hStream >> hName)
 	{
-		// LXe hits
-		for(G4int i=0; i<iNbLXeHits; i++)
+		if(hName == "default")
+			iStepFields |= muensterTPCEventData::eDefaultStepFields;
+		else if(hName == "all")
+			iStepFields |= (1 << muensterTPCEventData::eNbStepFields) - 1;
+		else if(hName == "none")
+			continue;
+		else if(muensterTPCEventData::GetStepField(hName))
+			iStepFields |= muensterTPCEventData::GetStepField(hName);
+		else
 		{
-			muensterTPCLXeHit *pHit = (*pLXeHitsCollection)[i];
+			G4cout << "--> warning from AnalysisManager::SetStepFields : unknown field " << hName << ", fields not changed" << G4endl;
+			return;
+		}
+	}
 
-			if(pHit->GetParticleType() != "opticalphoton")
-			{
-				m_pEventData->m_pTrackId->push_back(pHit->GetTrackId());
-				m_pEventData->m_pParentId->push_back(pHit->GetParentId());
+	m_iStepFields = iStepFields;
 
-				m_pEventData->m_pParticleType->push_back(pHit->GetParticleType());
-				m_pEventData->m_pParentType->push_back(pHit->GetParentType());
-				m_pEventData->m_pCreatorProcess->push_back(pHit->GetCreatorProcess());
-				m_pEventData->m_pDepositingProcess->push_back(pHit->GetDepositingProcess());
+	G4cout << "----> Setting step fields:" << GetStepFieldNames(m_iStepFields) << G4endl;
+}
 
-				m_pEventData->m_pX->push_back(pHit->GetPosition().x()/mm);
-				m_pEventData->m_pY->push_back(pHit->GetPosition().y()/mm);
-				m_pEventData->m_pZ->push_back(pHit->GetPosition().z()/mm);
+//******************************************************************/
+// GetStepFieldNames
+//******************************************************************/
+G4String muensterTPCAnalysisManager::GetStepFieldNames(G4int iStepFields) {
+	G4String hNames;
+	for(G4int i=0; i<muensterTPCEventData::eNbStepFields; i++)
+		if(iStepFields & (1 << i))
+			hNames += G4String(" ") + muensterTPCEventData::GetStepFieldName(i);
 
-				fTotalEnergyDeposited += pHit->GetEnergyDeposited()/keV;
-				m_pEventData->m_pEnergyDeposited->push_back(pHit->GetEnergyDeposited()/keV);
+	return hNames;
+}
 
-				m_pEventData->m_pKineticEnergy->push_back(pHit->GetKineticEnergy()/keV);
-				m_pEventData->m_pTime->push_back(pHit->GetTime()/second);
+//******************************************************************/
+// SetWaveform
+//******************************************************************/
+void muensterTPCAnalysisManager::SetWaveform(G4int iNbBins, G4double dBinWidth, G4double dStartTime) {
+	m_iNbWaveformBins = iNbBins;
+	m_dWaveformBinWidth = dBinWidth;
+	m_dWaveformStartTime = dStartTime;
 
-				iNbSteps++;
-			}
+	if(iNbBins)
+		G4cout << "----> Setting waveforms: " << iNbBins << " bins of " << dBinWidth/ns << " ns from " << dStartTime/ns << " ns" << G4endl;
+	else
+		G4cout << "----> Setting waveforms off" << G4endl;
+}
+
+//******************************************************************/
+// SetSpeResponse - one amplitude per waveform bin, "none" removes it
+//******************************************************************/
+void muensterTPCAnalysisManager::SetSpeResponse(const G4String &hFilename) {
+	std::vector<float> hSpeResponse;
+
+	if(hFilename != "none")
+	{
+		std::ifstream hFile(hFilename.c_str());
+		if(!hFile)
+		{
+			G4cout << "--> warning from AnalysisManager::SetSpeResponse : cannot open " << hFilename << G4endl;
+			return;
+		}
+
+		std::string hLine;
+		while(std::getline(hFile, hLine))
+		{
+			std::istringstream hStream(hLine);
+			float fAmplitude;
+			if(hLine.empty() || hLine[0] == '#' || !(hStream >> fAmplitude))
+				continue;
+			hSpeResponse.push_back(fAmplitude);
+		}
+
+		if(hSpeResponse.empty())
+		{
+			G4cout << "--> warning from AnalysisManager::SetSpeResponse : no values in " << hFilename << G4endl;
+			return;
 		}
+	}
 
-		m_pEventData->m_iNbSteps = iNbSteps;
-		m_pEventData->m_fTotalEnergyDeposited = fTotalEnergyDeposited;
+	m_hSpeResponse = hSpeResponse;
 
-		G4int iNbTopPmts = (G4int) muensterTPCDetectorConstruction::GetGeometryParameter("NbTopPmts");
-		G4int iNbBottomPmts = (G4int) muensterTPCDetectorConstruction::GetGeometryParameter("NbBottomPmts");
-		G4int iNbTopVetoPmts = (G4int) muensterTPCDetectorConstruction::GetGeometryParameter("NbTopVetoPmts");
-		G4int iNbBottomVetoPmts = (G4int) muensterTPCDetectorConstruction::GetGeometryParameter("NbBottomVetoPmts");
+	G4cout << "----> Setting single photoelectron response: " << m_hSpeResponse.size() << " bins" << G4endl;
+}
 
-		m_pEventData->m_pPmtHits->resize(iNbTopPmts+iNbBottomPmts+iNbTopVetoPmts+iNbBottomVetoPmts, 0);
+//******************************************************************/
+// SetCheckpointInterval
+//******************************************************************/
+void muensterTPCAnalysisManager::SetCheckpointInterval(G4int iNbEvents) {
+	m_iCheckpointInterval = iNbEvents;
 
-		// Pmt hits
-		for(G4int i=0; i<iNbPmtHits; i++)
-			(*(m_pEventData->m_pPmtHits))[(*pPmtHitsCollection)[i]->GetPmtNb()]++;
+	if(iNbEvents)
+		G4cout << "----> Setting checkpoints every " << iNbEvents << " events" << G4endl;
+	else
+		G4cout << "----> Setting checkpoints off" << G4endl;
+}
 
-		m_pEventData->m_iNbTopPmtHits =	accumulate(m_pEventData->m_pPmtHits->begin(), m_pEventData->m_pPmtHits->begin()+iNbTopPmts, 0);
-		m_pEventData->m_iNbBottomPmtHits = accumulate(m_pEventData->m_pPmtHits->begin()+iNbTopPmts, m_pEventData->m_pPmtHits->begin()+iNbTopPmts+iNbBottomPmts, 0);
-		// m_pEventData->m_iNbTopVetoPmtHits = accumulate(m_pEventData->m_pPmtHits->begin()+iNbTopPmts+iNbBottomPmts, m_pEventData->m_pPmtHits->begin()+iNbTopPmts+iNbBottomPmts+iNbTopVetoPmts, 0);
-		// m_pEventData->m_iNbBottomVetoPmtHits =	accumulate(m_pEventData->m_pPmtHits->begin()+iNbTopPmts+iNbBottomPmts+iNbTopVetoPmts, m_pEventData->m_pPmtHits->end(), 0);
+//******************************************************************/
+// SetResume - the next run continues the output file of the checkpoint
+//******************************************************************/
+G4bool muensterTPCAnalysisManager::SetResume(const G4String &hCheckpointFilename) {
+	if(!m_pCheckpoint->Read(hCheckpointFilename))
+		return false;
 
-		//if((fTotalEnergyDeposited > 0. || iNbPmtHits > 0) && !FilterEvent(m_pEventData))
-		
-	    // save only energy depositing events
-	    if(writeEmptyEvents) {
-			m_pTree->Fill(); // write all events to the tree
-	    } else {
-		    if(fTotalEnergyDeposited > 0. || iNbPmtHits > 0) m_pTree->Fill(); // only events with some activity are written to the tree
-	    }
+	m_bResume = true;
+	m_hDataFilename = m_pCheckpoint->m_hDataFilename;
+
+	G4cout << "----> Setting resume of " << m_hDataFilename << " after event " << m_pCheckpoint->m_iLastEventId << G4endl;
+
+	return true;
+}
+
+//******************************************************************/
+// GetCheckpointFilename - events.root -> events.root.checkpoint
+//******************************************************************/
+G4String muensterTPCAnalysisManager::GetCheckpointFilename() {
+	return m_hDataFilename + ".checkpoint";
+}
 
-		// auto save functionality to avoid data loss/ROOT can recover aborted simulations
-		if ( pEvent->GetEventID() % 10000 == 0)
-			m_pTree->AutoSave();
+//******************************************************************/
+// SetCalibration - events.root -> events_calibration.root
+//******************************************************************/
+void muensterTPCAnalysisManager::SetCalibration(G4bool bCalibration) {
+	if(bCalibration == m_bCalibration)
+		return;
+
+	m_bCalibration = bCalibration;
 
-		m_pEventData->Clear();
+	if(m_bCalibration)
+	{
+		m_hJobDataFilename = m_hDataFilename;
+		G4String hFilename = m_hDataFilename;
+		if(hFilename.size() > 5 && hFilename.substr(hFilename.size()-5) == ".root")
+			hFilename = hFilename.substr(0, hFilename.size()-5);
+		m_hDataFilename = hFilename + "_calibration.root";
+
+		G4cout << "----> Writing the calibration runs into " << m_hDataFilename << G4endl;
+	}
+	else
+	{
+		// the output of the job is not touched by the calibration
+		std::remove(m_hDataFilename.c_str());
+		std::remove(GetBinaryFilename().c_str());
+		m_hDataFilename = m_hJobDataFilename;
 	}
 }
 
 //******************************************************************/
-//
+// WriteCheckpoint - after the AutoSave, a crash in between is reported at the resume
 //******************************************************************/
-void muensterTPCAnalysisManager::Step(const G4Step *pStep) {
+void muensterTPCAnalysisManager::WriteCheckpoint(G4int iLastEventId) {
+	if(!m_pOutputWriter->Checkpoint())
+		return;
+
+	m_pCheckpoint->m_hDataFilename = m_hDataFilename;
+	m_pCheckpoint->m_iNbEvents = m_iEventIdOffset + m_iNbEventsToSimulate;
+	m_pCheckpoint->m_iLastEventId = iLastEventId;
+	m_pCheckpoint->m_lNbEntries = m_lNbResumedEntries + m_pOutputWriter->GetEntries();
+	m_pCheckpoint->m_lMasterSeed = m_pPrimaryGeneratorAction->GetMasterSeed();
+	m_pCheckpoint->m_iRunId = m_pPrimaryGeneratorAction->GetRunId();
+	m_pCheckpoint->SaveRandomEngine();
+	m_pCheckpoint->Write(GetCheckpointFilename());
 }
 
 //******************************************************************/
-// Event filer function which can be called above
+// SetStoreHits
 //******************************************************************/
-G4bool muensterTPCAnalysisManager::FilterEvent(muensterTPCEventData *pEventData) {
-	G4double dEnergyDepositedSensitiveRegion = 0.;
+void muensterTPCAnalysisManager::SetStoreHits(G4bool bStoreHits) {
+	m_bStoreHits = bStoreHits;
+
+	G4cout << "----> Setting hits collections for the visualization " << ((bStoreHits)?("on"):("off")) << G4endl;
+}
+
+//******************************************************************/
+// EndOfRun action/end of the simulation
+//******************************************************************/
+void muensterTPCAnalysisManager::EndOfRun(const G4Run *pRun) {
+		m_pRunTimer->Stop();
+
+		// throughput, e.g. to compare the physics modes and surface models
+		G4double dRealTime = m_pRunTimer->GetRealElapsed();
+		G4int iNbEvents = pRun->GetNumberOfEvent();
+		G4cout << "Throughput: " << iNbEvents << " events, " << m_lNbPrimaries << " primaries in "
+		       << dRealTime << " s";
+		if(dRealTime > 0.)
+			G4cout << " || E/s " << iNbEvents/dRealTime << " || primaries/s " << m_lNbPrimaries/dRealTime;
+		G4cout << G4endl;
+
+		// cost of EndOfEvent, including the tree fill
+		G4cout << "EndOfEvent: " << m_lNbEndOfEventHits << " hits in " << m_dEndOfEventTime << " s";
+		if(iNbEvents > 0)
+			G4cout << " || us/event " << 1.e6*m_dEndOfEventTime/iNbEvents;
+		if(m_lNbEndOfEventHits > 0)
+			G4cout << " || ns/hit " << 1.e9*m_dEndOfEventTime/m_lNbEndOfEventHits;
+		G4cout << " || reserved steps " << m_pEventData->GetReserveHint() << G4endl;
+
+		// accepted and rejected events
+		m_pEventFilter->EndOfRun();
+
+		// no event record outside of the runs
+		if(m_pLXeSensitiveDetector)
+			m_pLXeSensitiveDetector->SetEventData(0);
+		if(m_pPmtSensitiveDetector)
+			m_pPmtSensitiveDetector->SetEventData(0);
+
+		// the complete run, a resume has no events left
+		if(m_bCheckpoints && iNbEvents > 0)
+			WriteCheckpoint(m_iEventIdOffset + iNbEvents-1);
+
+		// the remaining events of the output format
+		m_pOutputWriter->Close();
+
+		// write and remove old revisions
+		if(m_pTreeFile)
+			m_pTreeFile->Write(0,TObject::kOverwrite);
+		//m_pTreeFile->Write();
+
+		// size and write speed of the output settings
+		const G4double dRawSize = m_pOutputWriter->GetRawSize()/1.e6;
+		const G4double dCompressedSize = m_pOutputWriter->GetCompressedSize()/1.e6;
+		G4cout << "Output: " << m_pOutputWriter->GetDescription() << " || compression " << m_hCompression
+		       << " || " << m_pOutputWriter->GetEntries() << " entries";
+		if(dRawSize >= 0.)
+			G4cout << ", " << dRawSize << " MB -> " << dCompressedSize << " MB";
+		if(dCompressedSize > 0.)
+			G4cout << " (x" << dRawSize/dCompressedSize << ")";
+		if(m_pTreeFile)
+			G4cout << " || file " << m_pTreeFile->GetSize()/1.e6 << " MB";
+		G4cout << " || Fill " << m_dFillTime << " s";
+		if(m_dFillTime > 0. && dRawSize >= 0.)
+			G4cout << " || MB/s " << dRawSize/m_dFillTime;
+		G4cout << G4endl;
+
+		delete m_pOutputWriter;
+		m_pOutputWriter = 0;
+
+		if(m_pTreeFile)
+			m_pTreeFile->Close();
+}
+
+//******************************************************************/
+//	BeginOfEvent action - for each beamed particle
+//******************************************************************/
+void muensterTPCAnalysisManager::BeginOfEvent(const G4Event *pEvent) {
+	// the event record was cleared at the end of the previous event
+}
+
+//******************************************************************/
+// EndOfEvent action - getting all event data
+//******************************************************************/
+void muensterTPCAnalysisManager::EndOfEvent(const G4Event *pEvent) {
+	const std::chrono::steady_clock::time_point hStart = std::chrono::steady_clock::now();
 
-	vector<float> *pX = pEventData->m_pX;
-	vector<float> *pY = pEventData->m_pY;
-	vector<float> *pZ = pEventData->m_pZ;
-	vector<float> *pEnergyDeposited = pEventData->m_pEnergyDeposited;
+	// the steps and pmt hits are already in the event record, no second pass over hits collections
+	const G4int iNbLXeHits = (m_pLXeSensitiveDetector)?(m_pLXeSensitiveDetector->GetNbHits()):(0);
+	const G4int iNbPmtHits = (m_pPmtSensitiveDetector)?(m_pPmtSensitiveDetector->GetNbHits()):(0);
 
-	const G4double dDriftLength = muensterTPCDetectorConstruction::GetGeometryParameter("DriftLength");
-	const G4double dRadius = muensterTPCDetectorConstruction::GetGeometryParameter("TeflonCylinderInnerRadius");
+	for(G4int i=0; i<pEvent->GetNumberOfPrimaryVertex(); i++)
+		m_lNbPrimaries += pEvent->GetPrimaryVertex(i)->GetNumberOfParticle();
 
-	for(G4int i=0; i<pEnergyDeposited->size(); i++)
+	// the event ids of a resumed run continue after the checkpoint
+	const G4int iEventId = m_iEventIdOffset + pEvent->GetEventID();
+	m_pEventData->m_iEventId = iEventId;
+
+	m_pEventData->SetPrimaryParticleType(m_pPrimaryGeneratorAction->GetParticleTypeOfPrimary());
+
+	m_pEventData->m_fPrimaryEnergy = m_pPrimaryGeneratorAction->GetEnergyOfPrimary()/keV;
+	m_pEventData->m_fPrimaryX = m_pPrimaryGeneratorAction->GetPositionOfPrimary().x()/mm;
+	m_pEventData->m_fPrimaryY = m_pPrimaryGeneratorAction->GetPositionOfPrimary().y()/mm;
+	m_pEventData->m_fPrimaryZ = m_pPrimaryGeneratorAction->GetPositionOfPrimary().z()/mm;
+
+	// event filter before anything is written
+	const G4bool bAccepted = m_pEventFilter->Accept(m_pEventData, iNbPmtHits);
+
+	if(bAccepted && (iNbLXeHits || iNbPmtHits))
 	{
-		if((*pZ)[i] < 0. && (*pZ)[i] > -dDriftLength && std::sqrt((*pX)[i]*(*pX)[i] + (*pY)[i]*(*pY)[i]) < dRadius)
-			dEnergyDepositedSensitiveRegion += (*pEnergyDeposited)[i];
+		m_pEventData->Seal();
+		m_pEventData->SealWaveforms();
+
+		const G4int iNbTopPmts = m_iNbTopPmts;
+		const G4int iNbBottomPmts = m_iNbBottomPmts;
+
+		m_pEventData->m_iNbTopPmtHits =	accumulate(m_pEventData->m_pPmtHits->begin(), m_pEventData->m_pPmtHits->begin()+iNbTopPmts, 0);
+		m_pEventData->m_iNbBottomPmtHits = accumulate(m_pEventData->m_pPmtHits->begin()+iNbTopPmts, m_pEventData->m_pPmtHits->begin()+iNbTopPmts+iNbBottomPmts, 0);
+		// m_pEventData->m_iNbTopVetoPmtHits = accumulate(m_pEventData->m_pPmtHits->begin()+iNbTopPmts+iNbBottomPmts, m_pEventData->m_pPmtHits->begin()+iNbTopPmts+iNbBottomPmts+iNbTopVetoPmts, 0);
+		// m_pEventData->m_iNbBottomVetoPmtHits =	accumulate(m_pEventData->m_pPmtHits->begin()+iNbTopPmts+iNbBottomPmts+iNbTopVetoPmts, m_pEventData->m_pPmtHits->end(), 0);
+
+	    // save only energy depositing events
+	    if(writeEmptyEvents || m_pEventData->m_fTotalEnergyDeposited > 0. || iNbPmtHits > 0) {
+			// Fill includes the compression of full baskets and the AutoSave
+			const std::chrono::steady_clock::time_point hFillStart = std::chrono::steady_clock::now();
+			m_pOutputWriter->Fill();
+			m_dFillTime += std::chrono::duration<G4double>(std::chrono::steady_clock::now()-hFillStart).count();
+	    }
 	}
 
-//if(dEnergyDepositedSensitiveRegion > 0. && dEnergyDepositedSensitiveRegion < 100.)
-	if(dEnergyDepositedSensitiveRegion > 0.)
-		return false;
-	else
-		return true;
+	// the event record is reused, also for events without hits
+	m_pEventData->Clear();
+
+	// cost of the event record, see EndOfRun
+	m_dEndOfEventTime += std::chrono::duration<G4double>(std::chrono::steady_clock::now()-hStart).count();
+	m_lNbEndOfEventHits += iNbLXeHits + iNbPmtHits;
+
+	// output file, random engine and postponed stack after this event
+	if(m_bCheckpoints && (iEventId+1) % m_iCheckpointInterval == 0)
+		WriteCheckpoint(iEventId);
+}
+
+//******************************************************************/
+//
+//******************************************************************/
+void muensterTPCAnalysisManager::Step(const G4Step *pStep) {
 }
 
-	
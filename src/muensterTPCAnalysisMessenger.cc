@@ -0,0 +1,278 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Communications with the AnalysisManager class
+ *
+ * @comment
+ ******************************************************************/
+
+#include <G4UIdirectory.hh>
+#include <G4UIcommand.hh>
+#include <G4UIparameter.hh>
+#include <G4UIcmdWithoutParameter.hh>
+#include <G4UIcmdWithAString.hh>
+#include <G4UIcmdWithAnInteger.hh>
+#include <G4UIcmdWithADouble.hh>
+#include <G4UIcmdWithABool.hh>
+#include <G4ios.hh>
+
+#include <sstream>
+
+#include "muensterTPCAnalysisMessenger.hh"
+#include "muensterTPCAnalysisManager.hh"
+#include "muensterTPCHistogramWriter.hh"
+
+muensterTPCAnalysisMessenger::muensterTPCAnalysisMessenger(muensterTPCAnalysisManager *pAnalysisManager):
+  m_pAnalysisManager(pAnalysisManager)
+{
+  // create directory
+  m_pDirectory = new G4UIdirectory("/Xe/output/");
+  m_pDirectory->SetGuidance("Output file control commands.");
+
+  G4UIparameter *pParameter;
+
+  // format of the event data
+  m_pFormatCmd = new G4UIcmdWithAString("/Xe/output/format", this);
+  m_pFormatCmd->SetGuidance("Set the format of the events for the next run.");
+  m_pFormatCmd->SetGuidance("ttree: events/events tree (default)");
+  m_pFormatCmd->SetGuidance("rntuple: events/events RNTuple, the steps as a collection of records (ROOT >= 6.34)");
+  m_pFormatCmd->SetGuidance("binary: chunked columnar file <output>.evb without ROOT at event time,");
+  m_pFormatCmd->SetGuidance("        converted into the ttree format with MuensterTPC-MC -c <file>.evb");
+  m_pFormatCmd->SetGuidance("histograms: only the histograms of /Xe/hist/ in events/");
+  m_pFormatCmd->SetParameterName("Format", false);
+  m_pFormatCmd->SetCandidates("ttree rntuple binary histograms");
+  m_pFormatCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  // compression of the output file
+  m_pCompressionCmd = new G4UIcommand("/Xe/output/compression", this);
+  m_pCompressionCmd->SetGuidance("Set the compression of the output file for the next run.");
+  m_pCompressionCmd->SetGuidance("[usage] /Xe/output/compression algorithm level");
+  m_pCompressionCmd->SetGuidance("        algorithm: lz4 for speed, zstd or lzma for archival, zlib or default (ROOT)");
+  m_pCompressionCmd->SetGuidance("        level: 0 (none) to 9, -1 takes the recommended level of the algorithm");
+  m_pCompressionCmd->SetGuidance("The binary format always uses zlib with this level.");
+  pParameter = new G4UIparameter("algorithm", 's', false);
+  pParameter->SetParameterCandidates("default zlib lzma lz4 zstd");
+  m_pCompressionCmd->SetParameter(pParameter);
+  pParameter = new G4UIparameter("level", 'i', true);
+  pParameter->SetDefaultValue(-1);
+  pParameter->SetParameterRange("level >= -1 && level <= 9");
+  m_pCompressionCmd->SetParameter(pParameter);
+  m_pCompressionCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  // basket size of the branches
+  m_pBasketSizeCmd = new G4UIcommand("/Xe/output/basketSize", this);
+  m_pBasketSizeCmd->SetGuidance("Set the basket size of the branches for the next run (ttree format).");
+  m_pBasketSizeCmd->SetGuidance("[usage] /Xe/output/basketSize branch bytes");
+  m_pBasketSizeCmd->SetGuidance("        branch: name of the branch, wildcards are allowed (* for all)");
+  m_pBasketSizeCmd->SetGuidance("        bytes: basket size (ROOT default 32000), later commands win");
+  pParameter = new G4UIparameter("branch", 's', false);
+  m_pBasketSizeCmd->SetParameter(pParameter);
+  pParameter = new G4UIparameter("bytes", 'i', false);
+  pParameter->SetParameterRange("bytes > 0");
+  m_pBasketSizeCmd->SetParameter(pParameter);
+  m_pBasketSizeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  // clustering of the baskets
+  m_pAutoFlushCmd = new G4UIcmdWithAnInteger("/Xe/output/autoFlush", this);
+  m_pAutoFlushCmd->SetGuidance("Set the clustering of the tree (TTree::SetAutoFlush) for the next run.");
+  m_pAutoFlushCmd->SetGuidance("> 0: flush the baskets every N entries, < 0: every -N bytes,");
+  m_pAutoFlushCmd->SetGuidance("0: no clustering (ROOT default -30000000)");
+  m_pAutoFlushCmd->SetGuidance("Sets the chunk size of the binary format in the same way.");
+  m_pAutoFlushCmd->SetParameterName("AutoFlush", false);
+  m_pAutoFlushCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  // AutoSave cadence
+  m_pAutoSaveCmd = new G4UIcmdWithADouble("/Xe/output/autoSave", this);
+  m_pAutoSaveCmd->SetGuidance("Save the tree header every N entries (N > 0) or every -N written bytes (N < 0),");
+  m_pAutoSaveCmd->SetGuidance("as TTree::SetAutoSave, default -300000000 (300 MB).");
+  m_pAutoSaveCmd->SetGuidance("ROOT can recover aborted simulations up to the last AutoSave, 0 disables it.");
+  m_pAutoSaveCmd->SetParameterName("N", false);
+  m_pAutoSaveCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  // hits objects of the sensitive detectors
+  m_pStoreHitsCmd = new G4UIcmdWithABool("/Xe/output/storeHits", this);
+  m_pStoreHitsCmd->SetGuidance("Keep the hits collections of the sensitive detectors for the visualization.");
+  m_pStoreHitsCmd->SetGuidance("The output is written directly from the steps, the hits are not needed for it.");
+  m_pStoreHitsCmd->SetParameterName("StoreHits", false);
+  m_pStoreHitsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  // step fields
+  m_pFieldsCmd = new G4UIcmdWithAString("/Xe/output/fields", this);
+  m_pFieldsCmd->SetGuidance("Set the step fields which are collected and written for the next run.");
+  m_pFieldsCmd->SetGuidance("[usage] /Xe/output/fields field ...");
+  m_pFieldsCmd->SetGuidance("        field: trackid parentid type parenttype creaproc edproc xp yp zp ed time ekin steplen,");
+  m_pFieldsCmd->SetGuidance("               default (all but ekin and steplen), all or none");
+  m_pFieldsCmd->SetGuidance("Disabled fields are not computed and have no branch.");
+  m_pFieldsCmd->SetParameterName("Fields", false);
+  m_pFieldsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  // waveforms of the pmts
+  m_pWaveformCmd = new G4UIcommand("/Xe/output/waveform", this);
+  m_pWaveformCmd->SetGuidance("Write the photon arrival times per pmt as sparse waveforms for the next run.");
+  m_pWaveformCmd->SetGuidance("[usage] /Xe/output/waveform nbins binwidth start unit");
+  m_pWaveformCmd->SetGuidance("        nbins: time bins per pmt, 0 switches the waveforms off");
+  m_pWaveformCmd->SetGuidance("        binwidth, start: bin width and start of the first bin (global time)");
+  m_pWaveformCmd->SetGuidance("The non-zero bins are written into wfpmt, wfbin and wfamp.");
+  pParameter = new G4UIparameter("nbins", 'i', false);
+  pParameter->SetParameterRange("nbins >= 0");
+  m_pWaveformCmd->SetParameter(pParameter);
+  pParameter = new G4UIparameter("binwidth", 'd', false);
+  pParameter->SetParameterRange("binwidth > 0.");
+  m_pWaveformCmd->SetParameter(pParameter);
+  pParameter = new G4UIparameter("start", 'd', true);
+  pParameter->SetDefaultValue(0.);
+  m_pWaveformCmd->SetParameter(pParameter);
+  pParameter = new G4UIparameter("unit", 's', true);
+  pParameter->SetDefaultValue("ns");
+  pParameter->SetParameterCandidates(G4UIcommand::UnitsList("Time"));
+  m_pWaveformCmd->SetParameter(pParameter);
+  m_pWaveformCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  // single photoelectron response
+  m_pSpeResponseCmd = new G4UIcmdWithAString("/Xe/output/speResponse", this);
+  m_pSpeResponseCmd->SetGuidance("Convolve the waveforms with a single photoelectron response for the next run.");
+  m_pSpeResponseCmd->SetGuidance("[usage] /Xe/output/speResponse file|none");
+  m_pSpeResponseCmd->SetGuidance("        file: amplitude per waveform bin after the photon, one value per line (# comments)");
+  m_pSpeResponseCmd->SetParameterName("File", false);
+  m_pSpeResponseCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  // checkpoints for a resume after a crash
+  m_pCheckpointCmd = new G4UIcmdWithAnInteger("/Xe/output/checkpoint", this);
+  m_pCheckpointCmd->SetGuidance("Write a checkpoint every N events of the next run (ttree format), 0 switches them off.");
+  m_pCheckpointCmd->SetGuidance("The tree is saved with the checkpoint instead of /Xe/output/autoSave, the random engine");
+  m_pCheckpointCmd->SetGuidance("and the postponed tracks are written into <output>.checkpoint.");
+  m_pCheckpointCmd->SetGuidance("The run is continued with MuensterTPC-MC -f <macro> --resume <output>.checkpoint");
+  m_pCheckpointCmd->SetParameterName("NbEvents", false);
+  m_pCheckpointCmd->SetRange("NbEvents >= 0");
+  m_pCheckpointCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  // histograms of the histograms format
+  m_pHistogramDirectory = new G4UIdirectory("/Xe/hist/");
+  m_pHistogramDirectory->SetGuidance("Histograms of the histograms output format.");
+
+  const char *szAxes[3] = {"x", "y", "z"};
+  for(G4int iDimension=1; iDimension<=3; iDimension++)
+  {
+    std::stringstream hStream;
+    hStream << "/Xe/hist/add" << iDimension << "D";
+    m_pAddHistogramCmd[iDimension-1] = new G4UIcommand(hStream.str().c_str(), this);
+    m_pAddHistogramCmd[iDimension-1]->SetGuidance("Add a histogram for the next runs with /Xe/output/format histograms.");
+    m_pAddHistogramCmd[iDimension-1]->SetGuidance("[usage] name (variable nbins min max) per axis");
+    m_pAddHistogramCmd[iDimension-1]->SetGuidance("        variable: etot ntpmthits nbpmthits npmthits asym nsteps e_pri xp_pri yp_pri zp_pri rp_pri");
+    m_pAddHistogramCmd[iDimension-1]->SetGuidance("Without histograms h_etot, h_ntpmthits, h_nbpmthits, h_asym and h_zp_pri are filled.");
+
+    pParameter = new G4UIparameter("name", 's', false);
+    m_pAddHistogramCmd[iDimension-1]->SetParameter(pParameter);
+    for(G4int i=0; i<iDimension; i++)
+    {
+      const G4String hAxis = szAxes[i];
+      pParameter = new G4UIparameter((hAxis+"variable").c_str(), 's', false);
+      m_pAddHistogramCmd[iDimension-1]->SetParameter(pParameter);
+      pParameter = new G4UIparameter((hAxis+"nbins").c_str(), 'i', false);
+      pParameter->SetParameterRange((hAxis+"nbins > 0").c_str());
+      m_pAddHistogramCmd[iDimension-1]->SetParameter(pParameter);
+      pParameter = new G4UIparameter((hAxis+"min").c_str(), 'd', false);
+      m_pAddHistogramCmd[iDimension-1]->SetParameter(pParameter);
+      pParameter = new G4UIparameter((hAxis+"max").c_str(), 'd', false);
+      m_pAddHistogramCmd[iDimension-1]->SetParameter(pParameter);
+    }
+    m_pAddHistogramCmd[iDimension-1]->AvailableForStates(G4State_PreInit, G4State_Idle);
+  }
+
+  m_pClearHistogramsCmd = new G4UIcmdWithoutParameter("/Xe/hist/clear", this);
+  m_pClearHistogramsCmd->SetGuidance("Remove all histograms.");
+  m_pClearHistogramsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+muensterTPCAnalysisMessenger::~muensterTPCAnalysisMessenger()
+{
+  delete m_pFormatCmd;
+  delete m_pCompressionCmd;
+  delete m_pBasketSizeCmd;
+  delete m_pAutoFlushCmd;
+  delete m_pAutoSaveCmd;
+  delete m_pStoreHitsCmd;
+  delete m_pFieldsCmd;
+  delete m_pWaveformCmd;
+  delete m_pSpeResponseCmd;
+  delete m_pCheckpointCmd;
+  delete m_pDirectory;
+
+  for(G4int i=0; i<3; i++)
+    delete m_pAddHistogramCmd[i];
+  delete m_pClearHistogramsCmd;
+  delete m_pHistogramDirectory;
+}
+
+void muensterTPCAnalysisMessenger::SetNewValue(G4UIcommand *pUIcommand, G4String hNewValues)
+{
+  if(pUIcommand == m_pFormatCmd)
+    m_pAnalysisManager->SetOutputFormat(hNewValues);
+
+  if(pUIcommand == m_pCompressionCmd)
+  {
+    std::istringstream hStream(hNewValues);
+    G4String hAlgorithm;
+    G4int iLevel = -1;
+    hStream >> hAlgorithm >> iLevel;
+    m_pAnalysisManager->SetCompression(hAlgorithm, iLevel);
+  }
+
+  if(pUIcommand == m_pBasketSizeCmd)
+  {
+    std::istringstream hStream(hNewValues);
+    G4String hBranch;
+    G4int iBytes = 0;
+    hStream >> hBranch >> iBytes;
+    m_pAnalysisManager->SetBasketSize(hBranch, iBytes);
+  }
+
+  if(pUIcommand == m_pAutoFlushCmd)
+    m_pAnalysisManager->SetAutoFlush(m_pAutoFlushCmd->GetNewIntValue(hNewValues));
+
+  if(pUIcommand == m_pAutoSaveCmd)
+    m_pAnalysisManager->SetAutoSave((Long64_t) m_pAutoSaveCmd->GetNewDoubleValue(hNewValues));
+
+  if(pUIcommand == m_pStoreHitsCmd)
+    m_pAnalysisManager->SetStoreHits(m_pStoreHitsCmd->GetNewBoolValue(hNewValues));
+
+  if(pUIcommand == m_pFieldsCmd)
+    m_pAnalysisManager->SetStepFields(hNewValues);
+
+  if(pUIcommand == m_pWaveformCmd)
+  {
+    std::istringstream hStream(hNewValues);
+    G4int iNbBins = 0;
+    G4double dBinWidth = 0., dStartTime = 0.;
+    G4String hUnit;
+    hStream >> iNbBins >> dBinWidth >> dStartTime >> hUnit;
+    const G4double dUnit = G4UIcommand::ValueOf(hUnit);
+    m_pAnalysisManager->SetWaveform(iNbBins, dBinWidth*dUnit, dStartTime*dUnit);
+  }
+
+  if(pUIcommand == m_pSpeResponseCmd)
+    m_pAnalysisManager->SetSpeResponse(hNewValues);
+
+  if(pUIcommand == m_pCheckpointCmd)
+    m_pAnalysisManager->SetCheckpointInterval(m_pCheckpointCmd->GetNewIntValue(hNewValues));
+
+  for(G4int iDimension=1; iDimension<=3; iDimension++)
+  {
+    if(pUIcommand == m_pAddHistogramCmd[iDimension-1])
+    {
+      std::istringstream hStream(hNewValues);
+      muensterTPCHistogramWriter::Histogram hHistogram;
+      hHistogram.iDimension = iDimension;
+      hStream >> hHistogram.hName;
+      for(G4int i=0; i<iDimension; i++)
+        hStream >> hHistogram.hVariables[i] >> hHistogram.iNbBins[i] >> hHistogram.dMin[i] >> hHistogram.dMax[i];
+
+      m_pAnalysisManager->AddHistogram(hHistogram);
+    }
+  }
+
+  if(pUIcommand == m_pClearHistogramsCmd)
+    m_pAnalysisManager->ClearHistograms();
+}
+
@@ -0,0 +1,681 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Chunked columnar binary output of the event data without ROOT
+ *
+ * @comment
+ ******************************************************************/
+#include <G4ios.hh>
+
+#include <zlib.h>
+
+#include <stdint.h>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+// only used by the converter
+#include <TFile.h>
+#include <TNamed.h>
+#include <TParameter.h>
+#include <TDirectory.h>
+
+#include "muensterTPCBinaryWriter.hh"
+#include "muensterTPCTreeWriter.hh"
+#include "muensterTPCEventData.hh"
+
+static const char szMagic[] = "MTPCEVB1";
+static const G4int iVersion = 1;
+
+// columns of the file, the names are the branch names of the ttree format
+enum {
+	eEventId, eNbTopPmtHits, eNbBottomPmtHits, eTotalEnergyDeposited, eNbSteps, eNbPmts, ePmtHits,
+	eTrackId, eParticleType, eParentId, eParentType, eCreatorProcess, eDepositingProcess,
+	eX, eY, eZ, eEnergyDeposited, eTime, eKineticEnergy, eStepLength,
+	ePrimaryParticleType, ePrimaryEnergy, ePrimaryX, ePrimaryY, ePrimaryZ,
+	eNbWaveformBins, eWaveformPmt, eWaveformBin, eWaveformAmplitude,
+	eNbColumns
+};
+
+static const char *szColumnNames[eNbColumns] = {
+	"eventid", "ntpmthits", "nbpmthits", "etot", "nsteps", "npmts", "pmthits",
+	"trackid", "type", "parentid", "parenttype", "creaproc", "edproc",
+	"xp", "yp", "zp", "ed", "time", "ekin", "steplen",
+	"type_pri", "e_pri", "xp_pri", "yp_pri", "zp_pri",
+	"nwf", "wfpmt", "wfbin", "wfamp"
+};
+
+static const char szColumnTypes[eNbColumns+1] = "iiifiiiisisssfffffffsffffiiif";
+
+// step field of the event record of the step columns, the other columns are always written
+static const G4int iColumnStepFields[eNbColumns] = {
+	0, 0, 0, 0, 0, 0, 0,
+	muensterTPCEventData::eStepTrackId, muensterTPCEventData::eStepType, muensterTPCEventData::eStepParentId,
+	muensterTPCEventData::eStepParentType, muensterTPCEventData::eStepCreatorProcess, muensterTPCEventData::eStepDepositingProcess,
+	muensterTPCEventData::eStepX, muensterTPCEventData::eStepY, muensterTPCEventData::eStepZ, muensterTPCEventData::eStepEnergyDeposited,
+	muensterTPCEventData::eStepTime, muensterTPCEventData::eStepKineticEnergy, muensterTPCEventData::eStepLength,
+	0, 0, 0, 0, 0,
+	0, 0, 0, 0
+};
+
+template<class T> static inline void WriteValue(std::ostream &hStream, T hValue)
+{
+	hStream.write((const char *) &hValue, sizeof(T));
+}
+
+template<class T> static inline G4bool ReadValue(std::istream &hStream, T &hValue)
+{
+	return (G4bool) hStream.read((char *) &hValue, sizeof(T));
+}
+
+// columns of disabled step fields are not in the file
+template<class T> static inline T GetStepValue(const std::vector<T> &hColumn, G4int iStep)
+{
+	return (iStep < (G4int) hColumn.size())?(hColumn[iStep]):(T());
+}
+
+muensterTPCBinaryWriter::muensterTPCBinaryWriter(muensterTPCEventData *pEventData, const G4String &hFilename, const G4String &hMetadata,
+	G4int iCompressionLevel, G4long lChunkSize) {
+	m_pEventData = pEventData;
+	m_hFilename = hFilename;
+	m_iCompressionLevel = iCompressionLevel;
+	m_lChunkSize = lChunkSize;
+
+	m_hColumns.resize(eNbColumns);
+	m_iNbEnabledColumns = 0;
+	for(G4int i=0; i<eNbColumns; i++)
+	{
+		m_hColumns[i].cType = szColumnTypes[i];
+		m_hColumns[i].lNbValues = 0;
+		m_hColumns[i].bEnabled = !iColumnStepFields[i] || pEventData->HasStepField(iColumnStepFields[i]);
+		if(i >= eNbWaveformBins && i <= eWaveformAmplitude)
+			m_hColumns[i].bEnabled = pEventData->HasWaveforms();
+		if(m_hColumns[i].bEnabled)
+			m_iNbEnabledColumns++;
+	}
+
+	m_lNbChunkEvents = 0;
+	m_lNbChunkBytes = 0;
+	m_dRawBytes = 0.;
+	m_dStoredBytes = 0.;
+
+	m_hFile.open(hFilename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if(!m_hFile)
+	{
+		G4cout << "--> warning from BinaryWriter : cannot open " << hFilename << ", no events are written" << G4endl;
+		return;
+	}
+
+	m_hFile.write(szMagic, 8);
+	WriteValue<uint32_t>(m_hFile, iVersion);
+	WriteValue<uint32_t>(m_hFile, hMetadata.size());
+	m_hFile.write(hMetadata.c_str(), hMetadata.size());
+	m_hFile.flush();
+}
+
+muensterTPCBinaryWriter::~muensterTPCBinaryWriter() {
+	Close();
+}
+
+//******************************************************************/
+// Fill
+//******************************************************************/
+void muensterTPCBinaryWriter::Fill() {
+	if(!m_hFile.is_open())
+		return;
+
+	muensterTPCEventData *pEventData = m_pEventData;
+	const G4int iNbSteps = pEventData->m_iNbSteps;
+	const G4int iNbPmts = pEventData->m_pPmtHits->size();
+
+	AppendInts(m_hColumns[eEventId], &pEventData->m_iEventId, 1);
+	AppendInts(m_hColumns[eNbTopPmtHits], &pEventData->m_iNbTopPmtHits, 1);
+	AppendInts(m_hColumns[eNbBottomPmtHits], &pEventData->m_iNbBottomPmtHits, 1);
+	AppendFloats(m_hColumns[eTotalEnergyDeposited], &pEventData->m_fTotalEnergyDeposited, 1);
+	AppendInts(m_hColumns[eNbSteps], &iNbSteps, 1);
+	AppendInts(m_hColumns[eNbPmts], &iNbPmts, 1);
+	AppendInts(m_hColumns[ePmtHits], pEventData->m_pPmtHits->data(), iNbPmts);
+
+	// the vectors of disabled step fields are empty
+	AppendInts(m_hColumns[eTrackId], pEventData->m_pTrackId->data(), pEventData->m_pTrackId->size());
+	AppendStrings(m_hColumns[eParticleType], *pEventData->m_pParticleType);
+	AppendInts(m_hColumns[eParentId], pEventData->m_pParentId->data(), pEventData->m_pParentId->size());
+	AppendStrings(m_hColumns[eParentType], *pEventData->m_pParentType);
+	AppendStrings(m_hColumns[eCreatorProcess], *pEventData->m_pCreatorProcess);
+	AppendStrings(m_hColumns[eDepositingProcess], *pEventData->m_pDepositingProcess);
+	AppendFloats(m_hColumns[eX], pEventData->m_pX->data(), pEventData->m_pX->size());
+	AppendFloats(m_hColumns[eY], pEventData->m_pY->data(), pEventData->m_pY->size());
+	AppendFloats(m_hColumns[eZ], pEventData->m_pZ->data(), pEventData->m_pZ->size());
+	AppendFloats(m_hColumns[eEnergyDeposited], pEventData->m_pEnergyDeposited->data(), pEventData->m_pEnergyDeposited->size());
+	AppendFloats(m_hColumns[eTime], pEventData->m_pTime->data(), pEventData->m_pTime->size());
+	AppendFloats(m_hColumns[eKineticEnergy], pEventData->m_pKineticEnergy->data(), pEventData->m_pKineticEnergy->size());
+	AppendFloats(m_hColumns[eStepLength], pEventData->m_pStepLength->data(), pEventData->m_pStepLength->size());
+
+	// one primary per event
+	std::vector<std::string> hPrimaryParticleType(1, pEventData->m_pPrimaryParticleType->empty()?"":pEventData->m_pPrimaryParticleType->front());
+	AppendStrings(m_hColumns[ePrimaryParticleType], hPrimaryParticleType);
+	AppendFloats(m_hColumns[ePrimaryEnergy], &pEventData->m_fPrimaryEnergy, 1);
+	AppendFloats(m_hColumns[ePrimaryX], &pEventData->m_fPrimaryX, 1);
+	AppendFloats(m_hColumns[ePrimaryY], &pEventData->m_fPrimaryY, 1);
+	AppendFloats(m_hColumns[ePrimaryZ], &pEventData->m_fPrimaryZ, 1);
+
+	// non-zero waveform bins
+	if(pEventData->HasWaveforms())
+	{
+		const G4int iNbWaveformBins = pEventData->m_pWaveformBin->size();
+		AppendInts(m_hColumns[eNbWaveformBins], &iNbWaveformBins, 1);
+		AppendInts(m_hColumns[eWaveformPmt], pEventData->m_pWaveformPmt->data(), iNbWaveformBins);
+		AppendInts(m_hColumns[eWaveformBin], pEventData->m_pWaveformBin->data(), iNbWaveformBins);
+		AppendFloats(m_hColumns[eWaveformAmplitude], pEventData->m_pWaveformAmplitude->data(), iNbWaveformBins);
+	}
+
+	m_lNbEntries++;
+	m_lNbChunkEvents++;
+
+	if((m_lChunkSize > 0 && m_lNbChunkEvents >= m_lChunkSize) || (m_lChunkSize < 0 && m_lNbChunkBytes >= -m_lChunkSize))
+		WriteChunk();
+}
+
+//******************************************************************/
+// Close
+//******************************************************************/
+void muensterTPCBinaryWriter::Close() {
+	if(!m_hFile.is_open())
+		return;
+
+	WriteChunk();
+
+	m_hFile.write("END ", 4);
+	WriteValue<uint64_t>(m_hFile, m_lNbEntries);
+	m_hFile.close();
+}
+
+//******************************************************************/
+// GetDescription
+//******************************************************************/
+G4String muensterTPCBinaryWriter::GetDescription() {
+	std::stringstream hStream;
+	hStream << "binary " << m_hFilename << " || zlib " << m_iCompressionLevel << " || chunk " << m_lChunkSize
+	        << ((m_lChunkSize < 0)?(" bytes"):(" events"));
+
+	return hStream.str();
+}
+
+//******************************************************************/
+// AppendInts
+//******************************************************************/
+void muensterTPCBinaryWriter::AppendInts(Column &hColumn, const int *pValues, G4int iNbValues) {
+	const size_t iSize = iNbValues*sizeof(int32_t);
+	hColumn.hData.resize(hColumn.hData.size()+iSize);
+	std::memcpy(&hColumn.hData[hColumn.hData.size()-iSize], pValues, iSize);
+
+	hColumn.lNbValues += iNbValues;
+	m_lNbChunkBytes += iSize;
+}
+
+//******************************************************************/
+// AppendFloats
+//******************************************************************/
+void muensterTPCBinaryWriter::AppendFloats(Column &hColumn, const float *pValues, G4int iNbValues) {
+	const size_t iSize = iNbValues*sizeof(float);
+	hColumn.hData.resize(hColumn.hData.size()+iSize);
+	std::memcpy(&hColumn.hData[hColumn.hData.size()-iSize], pValues, iSize);
+
+	hColumn.lNbValues += iNbValues;
+	m_lNbChunkBytes += iSize;
+}
+
+//******************************************************************/
+// AppendStrings - particle and process names, a few per chunk
+//******************************************************************/
+void muensterTPCBinaryWriter::AppendStrings(Column &hColumn, const std::vector<std::string> &hValues) {
+	for(G4int i=0; i<(G4int) hValues.size(); i++)
+	{
+		std::map<std::string, G4int>::iterator pIt = hColumn.hDictionary.find(hValues[i]);
+		int32_t iIndex;
+		if(pIt != hColumn.hDictionary.end())
+			iIndex = pIt->second;
+		else
+		{
+			iIndex = hColumn.hStrings.size();
+			hColumn.hDictionary[hValues[i]] = iIndex;
+			hColumn.hStrings.push_back(hValues[i]);
+		}
+
+		AppendInts(hColumn, &iIndex, 1);
+	}
+}
+
+//******************************************************************/
+// WriteChunk
+//******************************************************************/
+void muensterTPCBinaryWriter::WriteChunk() {
+	if(!m_lNbChunkEvents)
+		return;
+
+	m_hFile.write("CHNK", 4);
+	WriteValue<uint32_t>(m_hFile, m_lNbChunkEvents);
+	WriteValue<uint32_t>(m_hFile, m_iNbEnabledColumns);
+
+	std::vector<char> hRaw;
+	for(G4int i=0; i<eNbColumns; i++)
+	{
+		Column &hColumn = m_hColumns[i];
+		if(!hColumn.bEnabled)
+			continue;
+
+		// the dictionary goes in front of the indices
+		const std::vector<char> *pRaw = &hColumn.hData;
+		if(hColumn.cType == 's')
+		{
+			std::ostringstream hStream;
+			WriteValue<uint32_t>(hStream, hColumn.hStrings.size());
+			for(G4int j=0; j<(G4int) hColumn.hStrings.size(); j++)
+			{
+				WriteValue<uint16_t>(hStream, hColumn.hStrings[j].size());
+				hStream.write(hColumn.hStrings[j].c_str(), hColumn.hStrings[j].size());
+			}
+			const std::string hDictionary = hStream.str();
+			hRaw.assign(hDictionary.begin(), hDictionary.end());
+			hRaw.insert(hRaw.end(), hColumn.hData.begin(), hColumn.hData.end());
+			pRaw = &hRaw;
+		}
+
+		uLongf lStoredBytes = pRaw->size();
+		const char *pStored = pRaw->empty()?"":&(*pRaw)[0];
+		if(m_iCompressionLevel > 0 && !pRaw->empty())
+		{
+			m_hBuffer.resize(compressBound(pRaw->size()));
+			uLongf lCompressedBytes = m_hBuffer.size();
+			if(compress2((Bytef *) &m_hBuffer[0], &lCompressedBytes, (const Bytef *) pStored, pRaw->size(), m_iCompressionLevel) == Z_OK
+			   && lCompressedBytes < pRaw->size())
+			{
+				lStoredBytes = lCompressedBytes;
+				pStored = &m_hBuffer[0];
+			}
+		}
+
+		WriteValue<uint8_t>(m_hFile, std::strlen(szColumnNames[i]));
+		m_hFile.write(szColumnNames[i], std::strlen(szColumnNames[i]));
+		WriteValue<uint8_t>(m_hFile, hColumn.cType);
+		WriteValue<uint64_t>(m_hFile, hColumn.lNbValues);
+		WriteValue<uint32_t>(m_hFile, pRaw->size());
+		WriteValue<uint32_t>(m_hFile, lStoredBytes);
+		m_hFile.write(pStored, lStoredBytes);
+
+		m_dRawBytes += pRaw->size();
+		m_dStoredBytes += lStoredBytes;
+
+		// the buffers keep their capacity
+		hColumn.hData.clear();
+		hColumn.hDictionary.clear();
+		hColumn.hStrings.clear();
+		hColumn.lNbValues = 0;
+	}
+
+	// complete on disk
+	m_hFile.flush();
+
+	m_lNbChunkEvents = 0;
+	m_lNbChunkBytes = 0;
+}
+
+//******************************************************************/
+// Convert
+//******************************************************************/
+G4bool muensterTPCBinaryWriter::Convert(const G4String &hBinaryFilename, const G4String &hRootFilename) {
+	std::ifstream hFile(hBinaryFilename.c_str(), std::ios::in | std::ios::binary);
+
+	char szFileMagic[8];
+	uint32_t iFileVersion = 0, iMetadataLength = 0;
+	if(!hFile.read(szFileMagic, 8) || std::strncmp(szFileMagic, szMagic, 8) || !ReadValue(hFile, iFileVersion) || iFileVersion != iVersion)
+	{
+		G4cout << "--> warning from BinaryWriter::Convert : " << hBinaryFilename << " is not an event file of version " << iVersion << G4endl;
+		return false;
+	}
+
+	// metadata
+	std::string hMetadataText;
+	if(ReadValue(hFile, iMetadataLength))
+	{
+		hMetadataText.resize(iMetadataLength);
+		if(iMetadataLength)
+			hFile.read(&hMetadataText[0], iMetadataLength);
+	}
+	if(!hFile)
+	{
+		G4cout << "--> warning from BinaryWriter::Convert : " << hBinaryFilename << " has no complete metadata" << G4endl;
+		return false;
+	}
+
+	std::map<std::string, std::string> hMetadata;
+	std::istringstream hMetadataStream(hMetadataText);
+	std::string hLine;
+	while(std::getline(hMetadataStream, hLine))
+	{
+		const size_t iSeparator = hLine.find(' ');
+		if(iSeparator != std::string::npos)
+			hMetadata[hLine.substr(0, iSeparator)] = hLine.substr(iSeparator+1);
+	}
+
+	// same layout as the AnalysisManager
+	TFile *pFile = new TFile(hRootFilename.c_str(), "RECREATE", "File containing event data for muensterTPCsim");
+	TNamed *pG4Version = new TNamed("G4VERSION_TAG", hMetadata["G4VERSION_TAG"].c_str());
+	pG4Version->Write();
+	TNamed *pMCName = new TNamed("MC_TAG", hMetadata["MC_TAG"].c_str());
+	pMCName->Write();
+
+	TDirectory *pEventsDirectory = 0;
+	if(hMetadata["directory"].empty()) {
+		pEventsDirectory = pFile->mkdir("events");
+	} else {
+		TDirectory *pScanDirectory = pFile->mkdir(hMetadata["directory"].c_str());
+		pScanDirectory->cd();
+		TNamed *pScanParameters = new TNamed("parameters", hMetadata["parameters"].c_str());
+		pScanParameters->Write();
+		pEventsDirectory = pScanDirectory->mkdir("events");
+	}
+	pEventsDirectory->cd();
+
+	// the step fields of the run, all but ekin and steplen in files without the key
+	muensterTPCEventData *pEventData = new muensterTPCEventData();
+	if(hMetadata.count("fields"))
+	{
+		std::istringstream hFieldsStream(hMetadata["fields"]);
+		std::string hField;
+		G4int iStepFields = 0;
+		while(hFieldsStream >> hField)
+			iStepFields |= muensterTPCEventData::GetStepField(hField);
+		pEventData->SetStepFields(iStepFields);
+	}
+
+	// waveform binning, the converter needs no buffer
+	G4int iNbWaveformBins = 0;
+	G4double dWaveformBinWidth = 0., dWaveformStartTime = 0.;
+	if(hMetadata.count("waveform"))
+	{
+		std::istringstream hWaveformStream(hMetadata["waveform"]);
+		hWaveformStream >> iNbWaveformBins >> dWaveformBinWidth >> dWaveformStartTime;
+		pEventData->SetWaveform(0, iNbWaveformBins, dWaveformBinWidth, dWaveformStartTime, std::vector<float>());
+	}
+
+	muensterTPCTreeWriter *pTreeWriter = new muensterTPCTreeWriter(pEventData, std::vector<std::pair<G4String, G4int> >(), -30000000, -300000000);
+
+	TParameter<int> *pNbEventsParameter = new TParameter<int>("nbevents", std::atoi(hMetadata["nbevents"].c_str()));
+	pNbEventsParameter->Write();
+
+	if(hMetadata.count("seed"))
+	{
+		std::istringstream hSeedStream(hMetadata["seed"]);
+		Long64_t lMasterSeed = 0;
+		G4int iRunId = 0;
+		hSeedStream >> lMasterSeed >> iRunId;
+		TParameter<Long64_t> *pSeedParameter = new TParameter<Long64_t>("seed", lMasterSeed);
+		pSeedParameter->Write();
+		TParameter<int> *pRunIdParameter = new TParameter<int>("runid", iRunId);
+		pRunIdParameter->Write();
+	}
+
+	if(pEventData->HasWaveforms())
+	{
+		TParameter<int> *pNbBinsParameter = new TParameter<int>("wfnbins", iNbWaveformBins);
+		pNbBinsParameter->Write();
+		TParameter<double> *pBinWidthParameter = new TParameter<double>("wfbinwidth", dWaveformBinWidth);
+		pBinWidthParameter->Write();
+		TParameter<double> *pStartTimeParameter = new TParameter<double>("wfstart", dWaveformStartTime);
+		pStartTimeParameter->Write();
+	}
+
+	// decoded columns of one chunk
+	std::vector<std::vector<int> > hInts(eNbColumns);
+	std::vector<std::vector<float> > hFloats(eNbColumns);
+	std::vector<std::vector<std::string> > hStrings(eNbColumns);
+	std::vector<char> hRaw, hStored;
+
+	G4bool bComplete = false, bInvalid = false;
+	G4long lNbEvents = 0, lNbEventsInFile = 0;
+	char szTag[4];
+	while(hFile.read(szTag, 4))
+	{
+		if(!std::strncmp(szTag, "END ", 4))
+		{
+			uint64_t lNbEntries = 0;
+			bComplete = ReadValue(hFile, lNbEntries);
+			lNbEventsInFile = lNbEntries;
+			break;
+		}
+
+		uint32_t iNbChunkEvents = 0, iNbColumns = 0;
+		if(std::strncmp(szTag, "CHNK", 4) || !ReadValue(hFile, iNbChunkEvents) || !ReadValue(hFile, iNbColumns))
+			break;
+
+		for(G4int i=0; i<eNbColumns; i++)
+		{
+			hInts[i].clear();
+			hFloats[i].clear();
+			hStrings[i].clear();
+		}
+
+		G4bool bChunkComplete = true;
+		for(G4int i=0; i<(G4int) iNbColumns && bChunkComplete; i++)
+		{
+			uint8_t iNameLength = 0, iType = 0;
+			uint64_t lNbValues = 0;
+			uint32_t iRawBytes = 0, iStoredBytes = 0;
+			char szName[256];
+
+			bChunkComplete = ReadValue(hFile, iNameLength) && hFile.read(szName, iNameLength) && ReadValue(hFile, iType)
+				&& ReadValue(hFile, lNbValues) && ReadValue(hFile, iRawBytes) && ReadValue(hFile, iStoredBytes);
+			if(!bChunkComplete)
+				break;
+
+			hStored.resize(iStoredBytes);
+			if(iStoredBytes && !hFile.read(&hStored[0], iStoredBytes))
+			{
+				bChunkComplete = false;
+				break;
+			}
+
+			hRaw.resize(iRawBytes);
+			if(iStoredBytes == iRawBytes)
+				hRaw.swap(hStored);
+			else
+			{
+				uLongf lRawBytes = iRawBytes;
+				if(!iStoredBytes || !iRawBytes || uncompress((Bytef *) &hRaw[0], &lRawBytes, (const Bytef *) &hStored[0], iStoredBytes) != Z_OK || lRawBytes != iRawBytes)
+				{
+					bChunkComplete = false;
+					break;
+				}
+			}
+
+			// unknown columns of later versions are skipped
+			const std::string hName(szName, iNameLength);
+			G4int iColumn = 0;
+			while(iColumn < eNbColumns && hName != szColumnNames[iColumn])
+				iColumn++;
+			if(iColumn == eNbColumns)
+				continue;
+
+			// every value has to be inside the column, the values are 4 bytes long
+			const char *pRaw = hRaw.empty()?0:&hRaw[0];
+			const char *pRawEnd = pRaw+hRaw.size();
+			bInvalid = (iType != szColumnTypes[iColumn]);
+			if(!bInvalid && iType == 's')
+			{
+				uint32_t iNbStrings = 0;
+				bInvalid = (pRawEnd-pRaw < (G4long) sizeof(uint32_t));
+				if(!bInvalid)
+				{
+					std::memcpy(&iNbStrings, pRaw, sizeof(uint32_t));
+					pRaw += sizeof(uint32_t);
+				}
+				std::vector<std::string> hDictionary;
+				for(G4int j=0; j<(G4int) iNbStrings && !bInvalid; j++)
+				{
+					uint16_t iLength = 0;
+					bInvalid = (pRawEnd-pRaw < (G4long) sizeof(uint16_t));
+					if(bInvalid)
+						break;
+					std::memcpy(&iLength, pRaw, sizeof(uint16_t));
+					pRaw += sizeof(uint16_t);
+					bInvalid = (pRawEnd-pRaw < (G4long) iLength);
+					if(bInvalid)
+						break;
+					hDictionary.push_back(std::string(pRaw, iLength));
+					pRaw += iLength;
+				}
+
+				bInvalid = bInvalid || ((uint64_t) (pRawEnd-pRaw) != lNbValues*sizeof(int32_t));
+				if(!bInvalid)
+					hStrings[iColumn].resize(lNbValues);
+				for(G4int j=0; j<(G4int) lNbValues && !bInvalid; j++)
+				{
+					int32_t iIndex = 0;
+					std::memcpy(&iIndex, pRaw+j*sizeof(int32_t), sizeof(int32_t));
+					bInvalid = (iIndex < 0 || iIndex >= (G4int) hDictionary.size());
+					if(!bInvalid)
+						hStrings[iColumn][j] = hDictionary[iIndex];
+				}
+			}
+			else if(!bInvalid)
+			{
+				bInvalid = ((uint64_t) hRaw.size() != lNbValues*sizeof(int32_t));
+				if(!bInvalid && iType == 'f')
+				{
+					hFloats[iColumn].resize(lNbValues);
+					if(lNbValues)
+						std::memcpy(&hFloats[iColumn][0], pRaw, lNbValues*sizeof(float));
+				}
+				else if(!bInvalid)
+				{
+					hInts[iColumn].resize(lNbValues);
+					if(lNbValues)
+						std::memcpy(&hInts[iColumn][0], pRaw, lNbValues*sizeof(int32_t));
+				}
+			}
+
+			if(bInvalid)
+			{
+				G4cout << "--> warning from BinaryWriter::Convert : invalid column " << hName << " after " << lNbEvents << " events" << G4endl;
+				bChunkComplete = false;
+			}
+		}
+
+		if(!bChunkComplete && !bInvalid)
+		{
+			G4cout << "--> warning from BinaryWriter::Convert : incomplete chunk after " << lNbEvents << " events" << G4endl;
+			break;
+		}
+
+		// the counts of the events have to match the lengths of the columns
+		if(bChunkComplete)
+		{
+			const G4int iEventColumns[] = {eEventId, eNbTopPmtHits, eNbBottomPmtHits, eTotalEnergyDeposited, eNbSteps, eNbPmts,
+				ePrimaryParticleType, ePrimaryEnergy, ePrimaryX, ePrimaryY, ePrimaryZ};
+			for(G4int i=0; i<(G4int) (sizeof(iEventColumns)/sizeof(G4int)) && !bInvalid; i++)
+			{
+				const G4int iColumn = iEventColumns[i];
+				const size_t iNbValues = hInts[iColumn].size()+hFloats[iColumn].size()+hStrings[iColumn].size();
+				bInvalid = (iNbValues != iNbChunkEvents);
+			}
+
+			G4long lNbSteps = 0, lNbPmts = 0, lNbWaveformBins = 0;
+			for(G4int i=0; i<(G4int) iNbChunkEvents && !bInvalid; i++)
+			{
+				bInvalid = (hInts[eNbSteps][i] < 0 || hInts[eNbPmts][i] < 0);
+				lNbSteps += hInts[eNbSteps][i];
+				lNbPmts += hInts[eNbPmts][i];
+				if(i < (G4int) hInts[eNbWaveformBins].size())
+				{
+					bInvalid = bInvalid || (hInts[eNbWaveformBins][i] < 0);
+					lNbWaveformBins += hInts[eNbWaveformBins][i];
+				}
+			}
+
+			// columns of disabled step fields are empty
+			bInvalid = bInvalid || ((G4long) hInts[ePmtHits].size() != lNbPmts);
+			for(G4int iColumn=eTrackId; iColumn<=eStepLength && !bInvalid; iColumn++)
+			{
+				const size_t iNbValues = hInts[iColumn].size()+hFloats[iColumn].size()+hStrings[iColumn].size();
+				bInvalid = (iNbValues && (G4long) iNbValues != lNbSteps);
+			}
+			if(!bInvalid && pEventData->HasWaveforms() && !hInts[eNbWaveformBins].empty())
+				bInvalid = (hInts[eNbWaveformBins].size() != iNbChunkEvents
+					|| (G4long) hInts[eWaveformPmt].size() != lNbWaveformBins
+					|| (G4long) hInts[eWaveformBin].size() != lNbWaveformBins
+					|| (G4long) hFloats[eWaveformAmplitude].size() != lNbWaveformBins);
+
+			if(bInvalid)
+				G4cout << "--> warning from BinaryWriter::Convert : column lengths do not match the events after " << lNbEvents << " events" << G4endl;
+		}
+
+		if(bInvalid)
+			break;
+
+		// events of the chunk
+		G4int iStep = 0, iPmt = 0, iWaveformBin = 0;
+		for(G4int i=0; i<(G4int) iNbChunkEvents; i++)
+		{
+			const G4int iNbSteps = hInts[eNbSteps][i];
+			const G4int iNbPmts = hInts[eNbPmts][i];
+
+			pEventData->m_pPmtHits->assign(hInts[ePmtHits].begin()+iPmt, hInts[ePmtHits].begin()+iPmt+iNbPmts);
+			pEventData->m_iEventId = hInts[eEventId][i];
+			pEventData->m_iNbTopPmtHits = hInts[eNbTopPmtHits][i];
+			pEventData->m_iNbBottomPmtHits = hInts[eNbBottomPmtHits][i];
+			pEventData->m_fTotalEnergyDeposited = hFloats[eTotalEnergyDeposited][i];
+
+			for(G4int j=iStep; j<iStep+iNbSteps; j++)
+				pEventData->AddStep(GetStepValue(hInts[eTrackId], j), GetStepValue(hInts[eParentId], j),
+					GetStepValue(hStrings[eParticleType], j), GetStepValue(hStrings[eParentType], j),
+					GetStepValue(hStrings[eCreatorProcess], j), GetStepValue(hStrings[eDepositingProcess], j),
+					GetStepValue(hFloats[eX], j), GetStepValue(hFloats[eY], j), GetStepValue(hFloats[eZ], j),
+					GetStepValue(hFloats[eEnergyDeposited], j), GetStepValue(hFloats[eKineticEnergy], j),
+					GetStepValue(hFloats[eTime], j), GetStepValue(hFloats[eStepLength], j));
+			pEventData->Seal();
+
+			pEventData->SetPrimaryParticleType(hStrings[ePrimaryParticleType][i]);
+			pEventData->m_fPrimaryEnergy = hFloats[ePrimaryEnergy][i];
+			pEventData->m_fPrimaryX = hFloats[ePrimaryX][i];
+			pEventData->m_fPrimaryY = hFloats[ePrimaryY][i];
+			pEventData->m_fPrimaryZ = hFloats[ePrimaryZ][i];
+
+			if(pEventData->HasWaveforms() && i < (G4int) hInts[eNbWaveformBins].size())
+			{
+				const G4int iNbWaveformBinsOfEvent = hInts[eNbWaveformBins][i];
+				pEventData->m_pWaveformPmt->assign(hInts[eWaveformPmt].begin()+iWaveformBin, hInts[eWaveformPmt].begin()+iWaveformBin+iNbWaveformBinsOfEvent);
+				pEventData->m_pWaveformBin->assign(hInts[eWaveformBin].begin()+iWaveformBin, hInts[eWaveformBin].begin()+iWaveformBin+iNbWaveformBinsOfEvent);
+				pEventData->m_pWaveformAmplitude->assign(hFloats[eWaveformAmplitude].begin()+iWaveformBin, hFloats[eWaveformAmplitude].begin()+iWaveformBin+iNbWaveformBinsOfEvent);
+				iWaveformBin += iNbWaveformBinsOfEvent;
+			}
+
+			pTreeWriter->Fill();
+			pEventData->Clear();
+
+			iStep += iNbSteps;
+			iPmt += iNbPmts;
+			lNbEvents++;
+		}
+	}
+
+	if(bInvalid)
+		G4cout << "--> warning from BinaryWriter::Convert : " << hBinaryFilename << " is corrupt, only the events before are converted" << G4endl;
+	else if(!bComplete)
+		G4cout << "--> warning from BinaryWriter::Convert : " << hBinaryFilename << " is incomplete (aborted run?)" << G4endl;
+	else if(lNbEventsInFile != lNbEvents)
+		G4cout << "--> warning from BinaryWriter::Convert : " << lNbEvents << " of " << lNbEventsInFile << " events converted" << G4endl;
+
+	pTreeWriter->Close();
+	pFile->Write(0, TObject::kOverwrite);
+	pFile->Close();
+
+	delete pTreeWriter;
+	delete pEventData;
+
+	G4cout << "----> Converted " << lNbEvents << " events of " << hBinaryFilename << " into " << hRootFilename << G4endl;
+
+	return !bInvalid;
+}
+
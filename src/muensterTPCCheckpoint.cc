@@ -0,0 +1,272 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Checkpoint of a run to resume it after a crash
+ *
+ * @comment
+ ******************************************************************/
+#include <G4Track.hh>
+#include <G4DynamicParticle.hh>
+#include <G4ParticleDefinition.hh>
+#include <G4ParticleTable.hh>
+#include <G4IonTable.hh>
+#include <G4Ions.hh>
+#include <G4StackManager.hh>
+#include <G4SystemOfUnits.hh>
+#include <G4ios.hh>
+#include <Randomize.hh>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+#include "muensterTPCCheckpoint.hh"
+
+muensterTPCCheckpoint::muensterTPCCheckpoint() {
+	Clear();
+}
+
+muensterTPCCheckpoint::~muensterTPCCheckpoint() {
+}
+
+//******************************************************************/
+// Clear
+//******************************************************************/
+void muensterTPCCheckpoint::Clear() {
+	m_hDataFilename = "";
+	m_iNbEvents = 0;
+	m_iLastEventId = -1;
+	m_lNbEntries = 0;
+	m_lMasterSeed = 0;
+	m_iRunId = 0;
+	m_hEngineState = "";
+	m_hPostponedTracks.clear();
+}
+
+//******************************************************************/
+// Write - into a temporary file which replaces the previous checkpoint
+//******************************************************************/
+G4bool muensterTPCCheckpoint::Write(const G4String &hFilename) {
+	const G4String hTemporaryFilename = hFilename + ".tmp";
+
+	std::ofstream hFile(hTemporaryFilename.c_str());
+	if(!hFile)
+	{
+		G4cout << "--> warning from Checkpoint::Write : cannot open " << hTemporaryFilename << G4endl;
+		return false;
+	}
+
+	hFile << std::setprecision(17);
+	hFile << "# muensterTPCsim checkpoint\n";
+	hFile << "datafile " << m_hDataFilename << "\n";
+	hFile << "nbevents " << m_iNbEvents << "\n";
+	hFile << "event " << m_iLastEventId << "\n";
+	hFile << "entries " << m_lNbEntries << "\n";
+	hFile << "seed " << m_lMasterSeed << " " << m_iRunId << "\n";
+
+	// the engine writes its own format, it is stored with its number of lines
+	G4int iNbLines = 0;
+	std::istringstream hEngineStream(m_hEngineState);
+	std::string hLine;
+	while(std::getline(hEngineStream, hLine))
+		iNbLines++;
+	hFile << "engine " << iNbLines << "\n" << m_hEngineState;
+	if(!m_hEngineState.empty() && m_hEngineState[m_hEngineState.size()-1] != '\n')
+		hFile << "\n";
+
+	// particle Z A excitation ekin [MeV] direction position [mm] polarization time [ns] weight
+	hFile << "postponed " << m_hPostponedTracks.size() << "\n";
+	for(G4int i=0; i<(G4int) m_hPostponedTracks.size(); i++)
+	{
+		const PostponedTrack &hTrack = m_hPostponedTracks[i];
+		hFile << hTrack.hParticle << " " << hTrack.iZ << " " << hTrack.iA << " " << hTrack.dExcitationEnergy/MeV
+			<< " " << hTrack.dKineticEnergy/MeV
+			<< " " << hTrack.hDirection.x() << " " << hTrack.hDirection.y() << " " << hTrack.hDirection.z()
+			<< " " << hTrack.hPosition.x()/mm << " " << hTrack.hPosition.y()/mm << " " << hTrack.hPosition.z()/mm
+			<< " " << hTrack.hPolarization.x() << " " << hTrack.hPolarization.y() << " " << hTrack.hPolarization.z()
+			<< " " << hTrack.dTime/ns << " " << hTrack.dWeight << "\n";
+	}
+
+	hFile.close();
+	if(!hFile)
+	{
+		G4cout << "--> warning from Checkpoint::Write : cannot write " << hTemporaryFilename << G4endl;
+		return false;
+	}
+
+	// a crash during the write keeps the previous checkpoint
+	if(std::rename(hTemporaryFilename.c_str(), hFilename.c_str()))
+	{
+		G4cout << "--> warning from Checkpoint::Write : cannot replace " << hFilename << G4endl;
+		return false;
+	}
+
+	return true;
+}
+
+//******************************************************************/
+// Read
+//******************************************************************/
+G4bool muensterTPCCheckpoint::Read(const G4String &hFilename) {
+	Clear();
+
+	std::ifstream hFile(hFilename.c_str());
+	if(!hFile)
+	{
+		G4cout << "--> warning from Checkpoint::Read : cannot open " << hFilename << G4endl;
+		return false;
+	}
+
+	std::string hLine;
+	while(std::getline(hFile, hLine))
+	{
+		std::istringstream hStream(hLine);
+		std::string hKey;
+		if(hLine.empty() || hLine[0] == '#' || !(hStream >> hKey))
+			continue;
+
+		if(hKey == "datafile")
+		{
+			hStream >> std::ws;
+			std::getline(hStream, hLine);
+			m_hDataFilename = hLine;
+		}
+		else if(hKey == "nbevents")
+			hStream >> m_iNbEvents;
+		else if(hKey == "event")
+			hStream >> m_iLastEventId;
+		else if(hKey == "entries")
+			hStream >> m_lNbEntries;
+		else if(hKey == "seed")
+			hStream >> m_lMasterSeed >> m_iRunId;
+		else if(hKey == "engine")
+		{
+			G4int iNbLines = 0;
+			hStream >> iNbLines;
+			for(G4int i=0; i<iNbLines && std::getline(hFile, hLine); i++)
+				m_hEngineState += hLine + "\n";
+		}
+		else if(hKey == "postponed")
+		{
+			G4int iNbTracks = 0;
+			hStream >> iNbTracks;
+			for(G4int i=0; i<iNbTracks && std::getline(hFile, hLine); i++)
+			{
+				std::istringstream hTrackStream(hLine);
+				PostponedTrack hTrack;
+				G4double dValues[13];
+				hTrackStream >> hTrack.hParticle >> hTrack.iZ >> hTrack.iA;
+				for(G4int j=0; j<13; j++)
+					hTrackStream >> dValues[j];
+				if(!hTrackStream)
+				{
+					G4cout << "--> warning from Checkpoint::Read : invalid postponed track in " << hFilename << G4endl;
+					return false;
+				}
+
+				hTrack.dExcitationEnergy = dValues[0]*MeV;
+				hTrack.dKineticEnergy = dValues[1]*MeV;
+				hTrack.hDirection.set(dValues[2], dValues[3], dValues[4]);
+				hTrack.hPosition.set(dValues[5]*mm, dValues[6]*mm, dValues[7]*mm);
+				hTrack.hPolarization.set(dValues[8], dValues[9], dValues[10]);
+				hTrack.dTime = dValues[11]*ns;
+				hTrack.dWeight = dValues[12];
+				m_hPostponedTracks.push_back(hTrack);
+			}
+		}
+	}
+
+	if(m_hDataFilename.empty() || m_hEngineState.empty())
+	{
+		G4cout << "--> warning from Checkpoint::Read : incomplete checkpoint " << hFilename << G4endl;
+		return false;
+	}
+
+	return true;
+}
+
+//******************************************************************/
+// SaveRandomEngine
+//******************************************************************/
+void muensterTPCCheckpoint::SaveRandomEngine() {
+	std::ostringstream hStream;
+	CLHEP::HepRandom::getTheEngine()->put(hStream);
+	m_hEngineState = hStream.str();
+}
+
+//******************************************************************/
+// RestoreRandomEngine - the engine type has to be the one of the checkpoint
+//******************************************************************/
+G4bool muensterTPCCheckpoint::RestoreRandomEngine() {
+	std::istringstream hStream(m_hEngineState);
+	CLHEP::HepRandom::getTheEngine()->get(hStream);
+
+	if(hStream.fail())
+	{
+		G4cout << "--> warning from Checkpoint::RestoreRandomEngine : engine state does not match "
+		       << CLHEP::HepRandom::getTheEngine()->name() << G4endl;
+		return false;
+	}
+
+	return true;
+}
+
+//******************************************************************/
+// AddPostponedTrack
+//******************************************************************/
+void muensterTPCCheckpoint::AddPostponedTrack(const G4Track *pTrack) {
+	const G4ParticleDefinition *pDefinition = pTrack->GetDefinition();
+	const G4Ions *pIon = dynamic_cast<const G4Ions *>(pDefinition);
+
+	PostponedTrack hTrack;
+	hTrack.hParticle = pDefinition->GetParticleName();
+	hTrack.iZ = (pIon)?(pDefinition->GetAtomicNumber()):(0);
+	hTrack.iA = (pIon)?(pDefinition->GetAtomicMass()):(0);
+	hTrack.dExcitationEnergy = (pIon)?(pIon->GetExcitationEnergy()):(0.);
+	hTrack.dKineticEnergy = pTrack->GetKineticEnergy();
+	hTrack.hDirection = pTrack->GetMomentumDirection();
+	hTrack.hPosition = pTrack->GetPosition();
+	hTrack.hPolarization = pTrack->GetPolarization();
+	hTrack.dTime = pTrack->GetGlobalTime();
+	hTrack.dWeight = pTrack->GetWeight();
+
+	m_hPostponedTracks.push_back(hTrack);
+}
+
+//******************************************************************/
+// PushPostponedTracks - the stacking action has to classify them as postponed
+//******************************************************************/
+G4int muensterTPCCheckpoint::PushPostponedTracks(G4StackManager *pStackManager) {
+	G4int iNbTracks = 0;
+
+	for(G4int i=0; i<(G4int) m_hPostponedTracks.size(); i++)
+	{
+		const PostponedTrack &hTrack = m_hPostponedTracks[i];
+
+		// ions are only created on demand
+		G4ParticleDefinition *pDefinition = G4ParticleTable::GetParticleTable()->FindParticle(hTrack.hParticle);
+		if(!pDefinition && hTrack.iZ > 0)
+			pDefinition = G4IonTable::GetIonTable()->GetIon(hTrack.iZ, hTrack.iA, hTrack.dExcitationEnergy);
+		if(!pDefinition)
+		{
+			G4cout << "--> warning from Checkpoint::PushPostponedTracks : unknown particle " << hTrack.hParticle << G4endl;
+			continue;
+		}
+
+		G4DynamicParticle *pParticle = new G4DynamicParticle(pDefinition, hTrack.hDirection, hTrack.dKineticEnergy);
+		pParticle->SetPolarization(hTrack.hPolarization.x(), hTrack.hPolarization.y(), hTrack.hPolarization.z());
+
+		G4Track *pTrack = new G4Track(pParticle, hTrack.dTime, hTrack.hPosition);
+		pTrack->SetWeight(hTrack.dWeight);
+
+		pStackManager->PushOneTrack(pTrack);
+		iNbTracks++;
+	}
+
+	m_hPostponedTracks.clear();
+
+	return iNbTracks;
+}
+
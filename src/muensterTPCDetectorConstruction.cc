@@ -27,6 +27,22 @@
 #include <G4SystemOfUnits.hh>
 #include <G4UserLimits.hh>
 #include <G4RunManager.hh>
+#include <G4Region.hh>
+#include <G4RegionStore.hh>
+#include <G4StateManager.hh>
+#include <G4LogicalVolumeStore.hh>
+#include <G4SurfaceProperty.hh>
+#include <G4OpticalSurface.hh>
+#include <G4Version.hh>
+#include <G4Navigator.hh>
+#include <G4Timer.hh>
+#include <G4VisExtent.hh>
+#include <G4SmartVoxelHeader.hh>
+#include <G4RandomDirection.hh>
+#include <Randomize.hh>
+#ifdef G4LIB_USE_GDML
+#include <G4GDMLParser.hh>
+#endif
 
 // include C++ classes
 #include <globals.hh>
@@ -36,18 +52,28 @@
 #include <algorithm>
 #include <cmath>
 #include <cassert>
+#include <fstream>
+#include <cstdio>
+#include <iomanip>
+#include <map>
 
 using std::vector;
 using std::stringstream;
 using std::max;
+using std::map;
 
 // include Muenster TPC classes
 #include "muensterTPCLXeSensitiveDetector.hh"
 #include "muensterTPCPmtSensitiveDetector.hh"
 #include "muensterTPCDetectorConstruction.hh"
+#include "muensterTPCPmtParameterisation.hh"
+#include "muensterTPCMeshSurfaceProcess.hh"
 #include "muensterTPCDetectorMessenger.hh"
+#include "muensterTPCPrimaryGeneratorAction.hh"
+#include "muensterTPCRunAction.hh"
+#include "muensterTPCAnalysisManager.hh"
 
-map<G4String, G4double> muensterTPCDetectorConstruction::m_hGeometryParameters;
+muensterTPCDetectorConstruction::GeometryParameters muensterTPCDetectorConstruction::m_hGeometryParameters;
 
 double OuterVesselAlphaChannel = 0.15;
 double InnerVesselAlphaChannel = 0.15;
@@ -85,6 +111,26 @@ muensterTPCDetectorConstruction::muensterTPCDetectorConstruction() {
   m_pRotationX0 = new G4RotationMatrix();
   m_pRotationX0->rotateX(0.*deg);
         
+  m_pTeflonOpticalSurface = 0;
+  m_pGXeTeflonOpticalSurface = 0;
+  m_dTeflonSigmaAlpha = 0.;
+  m_dGXeTeflonSigmaAlpha = 0.;
+
+  m_hGdmlCacheFilename = "";
+  m_bParameterisedPmtArrays = false;
+  m_bMeshSurfaces = false;
+  m_hTeflonSurfaceModel = "unified";
+
+  // offsets w.r.t. the nominal geometry, can be changed between runs
+  m_dLXeLevel = 0.;
+  m_dAnodeMeshOffset = 0.;
+
+  // the geometry parameters are available before the construction
+  DefineGeometryParameters();
+
+  m_iNbMountedTopPmts = (G4int) GetGeometryParameter(NbTopPmts);
+  m_iNbMountedBottomPmts = (G4int) GetGeometryParameter(NbBottomPmts);
+
   m_pDetectorMessenger = new muensterTPCDetectorMessenger(this);
 }
 
@@ -100,24 +146,48 @@ muensterTPCDetectorConstruction::~muensterTPCDetectorConstruction() {
 //******************************************************************/
 G4VPhysicalVolume* muensterTPCDetectorConstruction::Construct() {
 
-  DefineMaterials();
-	LXeMaterial = G4Material::GetMaterial("LXe", false);
-
   DefineGeometryParameters();
 
-  ConstructLaboratory();
+  if(m_bParameterisedPmtArrays && !m_hGdmlCacheFilename.empty())
+    {
+      G4cout << "--> warning from DetectorConstruction::Construct : "
+	     << "the GDML cache is not used with parameterised PMT arrays" << G4endl;
+      m_hGdmlCacheFilename = "";
+    }
+
+  // start from the cached geometry if it was built with the same parameters
+  if(m_hGdmlCacheFilename.empty() || !ImportGdml(m_hGdmlCacheFilename))
+    {
+      DefineMaterials();
+      LXeMaterial = G4Material::GetMaterial("LXe", false);
 
-  ConstructOuterCryostat();
+      ConstructLaboratory();
 
-  ConstructInnerCryostat();
+      ConstructOuterCryostat();
 
-  ConstructXenon();
+      ConstructInnerCryostat();
 
-  ConstructTPC();
+      ConstructXenon();
 
-  ConstructFieldCage();
+      ConstructTPC();
 
-  ConstructPmtArrays();
+      ConstructFieldCage();
+
+      ConstructPmtArrays();
+
+      if(!m_hGdmlCacheFilename.empty())
+        ExportGdml(m_hGdmlCacheFilename, true);
+    }
+
+  ConstructSensitiveDetectors();
+
+  ConstructRegions();
+
+  // all pmts are built, unmount the ones not requested
+  m_hPmtMounted.assign(m_hPmtCasingPhysicalVolumes.size(), true);
+  MountPmts();
+
+  MountMeshes();
   
   //PrintPhysicalVolumes();
 
@@ -129,8 +199,22 @@ G4VPhysicalVolume* muensterTPCDetectorConstruction::Construct() {
 //******************************************************************/
 // GetGeometryParameter
 //******************************************************************/
-G4double muensterTPCDetectorConstruction::GetGeometryParameter(const char *szParameter) {
-  return m_hGeometryParameters[szParameter];
+G4double muensterTPCDetectorConstruction::GetGeometryParameter(GeometryParameter eParameter) {
+  return m_hGeometryParameters[eParameter];
+}
+
+//******************************************************************/
+// GetGeometryParameters
+//******************************************************************/
+const muensterTPCDetectorConstruction::GeometryParameters &muensterTPCDetectorConstruction::GetGeometryParameters() {
+  return m_hGeometryParameters;
+}
+
+//******************************************************************/
+// SetGeometryParameter
+//******************************************************************/
+void muensterTPCDetectorConstruction::SetGeometryParameter(GeometryParameter eParameter, G4double dValue) {
+  m_hGeometryParameters.m_pdValues[eParameter] = dValue;
 }
 
 //******************************************************************/
@@ -415,167 +499,177 @@ void muensterTPCDetectorConstruction::DefineMaterials() {
 //******************************************************************/
 void muensterTPCDetectorConstruction::DefineGeometryParameters() {
   //TPC
-  m_hGeometryParameters["ScreeningMeshToAnode"]   = 7.85*mm;
-  m_hGeometryParameters["AnodeToLiquidLevel"]    = 3.15*mm;
-  m_hGeometryParameters["LiquidLevelToGateMesh"]     = 2.0*mm;
-  m_hGeometryParameters["LiquidLevelToScreenMesh"]     = 11.15*mm;
-
-  m_hGeometryParameters["CathodeToScreenMesh"]     = 19.4*mm;
-  m_hGeometryParameters["TopBottomPMTToScreeningMesh"]     = 3.0*mm;
-  m_hGeometryParameters["BottomTopPMTToScreeningMesh"]     = 3.0*mm;
-
-  m_hGeometryParameters["TeflonCentralCylinderInnerRadius"] = 40.0*mm;
-  m_hGeometryParameters["TeflonCentralCylinderOuterRadius"] = 50.5*mm;
-  m_hGeometryParameters["TeflonCentralCylinderHeight"] = 167.0*mm;
-  m_hGeometryParameters["TeflonCentralCylinderThickness"] = 10.5*mm;
+  //the liquid level and the anode mesh can be shifted w.r.t. the nominal positions
+  SetGeometryParameter(ScreeningMeshToAnode, 7.85*mm-m_dAnodeMeshOffset);
+  SetGeometryParameter(AnodeToLiquidLevel, 3.15*mm+m_dAnodeMeshOffset-m_dLXeLevel);
+  SetGeometryParameter(LiquidLevelToGateMesh, 2.0*mm+m_dLXeLevel);
+  SetGeometryParameter(LiquidLevelToScreenMesh, 11.15*mm-m_dLXeLevel);
+
+  SetGeometryParameter(CathodeToScreenMesh, 19.4*mm);
+  SetGeometryParameter(TopBottomPMTToScreeningMesh, 3.0*mm);
+  SetGeometryParameter(BottomTopPMTToScreeningMesh, 3.0*mm);
+
+  SetGeometryParameter(TeflonCentralCylinderInnerRadius, 40.0*mm);
+  SetGeometryParameter(TeflonCentralCylinderOuterRadius, 50.5*mm);
+  SetGeometryParameter(TeflonCentralCylinderHeight, 167.0*mm);
+  SetGeometryParameter(TeflonCentralCylinderThickness, 10.5*mm);
   
-  m_hGeometryParameters["TeflonOuterCylinderInnerRadius"] = 50.5*mm;
-  m_hGeometryParameters["TeflonOuterCylinderOuterRadius"] = 74.0*mm;
-  m_hGeometryParameters["TeflonOuterCylinderHeight"] = 167.0*mm;
-  m_hGeometryParameters["TeflonOuterCylinderThickness"] = 23.5*mm;
+  SetGeometryParameter(TeflonOuterCylinderInnerRadius, 50.5*mm);
+  SetGeometryParameter(TeflonOuterCylinderOuterRadius, 74.0*mm);
+  SetGeometryParameter(TeflonOuterCylinderHeight, 167.0*mm);
+  SetGeometryParameter(TeflonOuterCylinderThickness, 23.5*mm);
   
   //bottom part TPC
-  m_hGeometryParameters["BottomPMTHolderTopPartThickness"] = 15.4*mm; // goes from middle of pmt to top of pmt NOT to the cathode	
-  m_hGeometryParameters["BottomPMTHolderBottomPartThickness"] = 16.6*mm;	
-  m_hGeometryParameters["BottomPMTBaseHolderThickness"] = 12.0*mm;	
-  m_hGeometryParameters["BottomPMTHolderPlateRadius"]    = 74.0*mm;	
+  SetGeometryParameter(BottomPMTHolderTopPartThickness, 15.4*mm); // goes from middle of pmt to top of pmt NOT to the cathode	
+  SetGeometryParameter(BottomPMTHolderBottomPartThickness, 16.6*mm);	
+  SetGeometryParameter(BottomPMTBaseHolderThickness, 12.0*mm);	
+  SetGeometryParameter(BottomPMTHolderPlateRadius, 74.0*mm);	
   
-  m_hGeometryParameters["BottomPTFESlabThickness"] = 24.4*mm; //slab between top of bottom pmt and the cathode
-  m_hGeometryParameters["BottomPTFESlabInnerRadius"] = 40.0*mm; 
-  m_hGeometryParameters["BottomPTFESlabOuterRadius"] = 74.0*mm; 
+  SetGeometryParameter(BottomPTFESlabThickness, 24.4*mm); //slab between top of bottom pmt and the cathode
+  SetGeometryParameter(BottomPTFESlabInnerRadius, 40.0*mm); 
+  SetGeometryParameter(BottomPTFESlabOuterRadius, 74.0*mm); 
 
-  m_hGeometryParameters["BottomSteelRingThickness"] = 2.0*mm; //slab between top of bottom pmt and the cathode
-  m_hGeometryParameters["BottomSteelRingInnerRadius"] = 47.5*mm; 
-  m_hGeometryParameters["BottomSteelRingOuterRadius"] = 74.0*mm; 
-  m_hGeometryParameters["BottomFlangeCopperRingToTopSteelRing"]=10.2*mm;
+  SetGeometryParameter(BottomSteelRingThickness, 2.0*mm); //slab between top of bottom pmt and the cathode
+  SetGeometryParameter(BottomSteelRingInnerRadius, 47.5*mm); 
+  SetGeometryParameter(BottomSteelRingOuterRadius, 74.0*mm); 
+  SetGeometryParameter(BottomFlangeCopperRingToTopSteelRing, 10.2*mm);
 
   //top part TPC
-  m_hGeometryParameters["TopPMTHolderPlateThickness"] = 34.6*mm;
-  m_hGeometryParameters["TopPMTHolderTopPartThickness"] = 16.6*mm; // goes from middle of pmt to top of pmt NOT to the cathode	
-  m_hGeometryParameters["TopPMTHolderBottomPartThickness"] = 18.0*mm;
-  m_hGeometryParameters["TopPMTHolderPlateRadius"]    = 74.0*mm;
+  SetGeometryParameter(TopPMTHolderPlateThickness, 34.6*mm);
+  SetGeometryParameter(TopPMTHolderTopPartThickness, 16.6*mm); // goes from middle of pmt to top of pmt NOT to the cathode	
+  SetGeometryParameter(TopPMTHolderBottomPartThickness, 18.0*mm);
+  SetGeometryParameter(TopPMTHolderPlateRadius, 74.0*mm);
 
-  m_hGeometryParameters["TopPTFESlabThickness"] = 13.5*mm; //slab between top of bottom pmt and the cathode
-  m_hGeometryParameters["TopPTFESlabInnerRadius"] = 40.0*mm; 
-  m_hGeometryParameters["TopPTFESlabOuterRadius"] = 74.0*mm; 
+  SetGeometryParameter(TopPTFESlabThickness, 13.5*mm); //slab between top of bottom pmt and the cathode
+  SetGeometryParameter(TopPTFESlabInnerRadius, 40.0*mm); 
+  SetGeometryParameter(TopPTFESlabOuterRadius, 74.0*mm); 
 
   //copper rings
-  m_hGeometryParameters["CopperRingsOuterRadius"] = 60.25*mm;
-  m_hGeometryParameters["CopperRingsInnerRadius"] = 50.9*mm;
-  m_hGeometryParameters["CopperRingsThickness"] = 2.0*mm;
-  m_hGeometryParameters["CopperRingsNumber"] = 12;
-  m_hGeometryParameters["CopperRingsSpacing"] = 11.0*mm;
+  SetGeometryParameter(CopperRingsOuterRadius, 60.25*mm);
+  SetGeometryParameter(CopperRingsInnerRadius, 50.9*mm);
+  SetGeometryParameter(CopperRingsThickness, 2.0*mm);
+  SetGeometryParameter(CopperRingsNumber, 12);
+  SetGeometryParameter(CopperRingsSpacing, 11.0*mm);
 
   //meshes
-  m_hGeometryParameters["GridMeshThickness"] = 0.15*mm;
-  m_hGeometryParameters["GridMeshRadius"] = 50.*mm;
-  m_hGeometryParameters["GridMeshNumber"] = 5;
+  SetGeometryParameter(GridMeshThickness, 0.15*mm);
+  SetGeometryParameter(GridMeshRadius, 50.*mm);
+  SetGeometryParameter(GridMeshNumber, 5);
 
-  m_hGeometryParameters["GridMeshBorderInnerRadius"] = 50.*mm;
-  m_hGeometryParameters["GridMeshBorderOuterRadius"] = 55*mm;
+  SetGeometryParameter(GridMeshBorderInnerRadius, 50.*mm);
+  SetGeometryParameter(GridMeshBorderOuterRadius, 55*mm);
 
-  m_hGeometryParameters["GateMeshRingThickness"] = 2.0*mm; //in reality this is the support
+  SetGeometryParameter(GateMeshRingThickness, 2.0*mm); //in reality this is the support
 
-  m_hGeometryParameters["GridMeshSupportThickness"] = 2.0*mm;
-  m_hGeometryParameters["GridMeshSupportInnerRadius"] = 50.9*mm;
-  m_hGeometryParameters["GridMeshSupportOuterRadius"] = 60.25*mm;
-  m_hGeometryParameters["GridMeshSupportNumber"] = 4;
+  SetGeometryParameter(GridMeshSupportThickness, 2.0*mm);
+  SetGeometryParameter(GridMeshSupportInnerRadius, 50.9*mm);
+  SetGeometryParameter(GridMeshSupportOuterRadius, 60.25*mm);
+  SetGeometryParameter(GridMeshSupportNumber, 4);
 
-  m_hGeometryParameters["CathodeGridMeshSupportThickness"] = 2.0*mm;
-  m_hGeometryParameters["CathodeGridMeshSupportInnerRadius"] = 45.0*mm;
-  m_hGeometryParameters["CathodeGridMeshSupportOuterRadius"] = 60.25*mm;
+  SetGeometryParameter(CathodeGridMeshSupportThickness, 2.0*mm);
+  SetGeometryParameter(CathodeGridMeshSupportInnerRadius, 45.0*mm);
+  SetGeometryParameter(CathodeGridMeshSupportOuterRadius, 60.25*mm);
 
   //pmt
-  m_hGeometryParameters["PmtWidth"]                 = 25.4*mm;
-  m_hGeometryParameters["PmtSpacing"]               = 2.0*mm;
-  m_hGeometryParameters["PmtWindowWidth"]           = 25.00*mm;
-  m_hGeometryParameters["PmtWindowThickness"]       = 1.50*mm;
-  m_hGeometryParameters["PmtCasingWidth"]           = 25.40*mm;
-  m_hGeometryParameters["PmtCasingHeight"]          = 27.00*mm;
-  m_hGeometryParameters["PmtCasingThickness"]       = 0.50*mm;
-  m_hGeometryParameters["PmtPhotoCathodeWidth"]     = 22.00*mm;
-  m_hGeometryParameters["PmtPhotoCathodeThickness"] = 0.50*mm;
-  m_hGeometryParameters["PmtBaseThickness"]         = 1.50*mm;
-  m_hGeometryParameters["PmtToPmtBase"]             = 3.00*mm;
-
-  m_hGeometryParameters["NbTopPmtsFirstRow"]   = 2;
-  m_hGeometryParameters["NbTopPmtsSecondRow"]  = 3;
-  m_hGeometryParameters["NbTopPmtsThirdRow"]  = 2;
-  m_hGeometryParameters["NbTopPmts"] = 7;
-
-  m_hGeometryParameters["NbBottomPmtsFirstRow"]   = 2;
-  m_hGeometryParameters["NbBottomPmtsSecondRow"]  = 3;
-  m_hGeometryParameters["NbBottomPmtsThirdRow"]  = 2;
-  m_hGeometryParameters["NbBottomPmts"] = 7;
-
-  m_hGeometryParameters["SpaceBelowTopPMTHeight"] = 3.05*mm;
+  SetGeometryParameter(PmtWidth, 25.4*mm);
+  SetGeometryParameter(PmtSpacing, 2.0*mm);
+  SetGeometryParameter(PmtWindowWidth, 25.00*mm);
+  SetGeometryParameter(PmtWindowThickness, 1.50*mm);
+  SetGeometryParameter(PmtCasingWidth, 25.40*mm);
+  SetGeometryParameter(PmtCasingHeight, 27.00*mm);
+  SetGeometryParameter(PmtCasingThickness, 0.50*mm);
+  SetGeometryParameter(PmtPhotoCathodeWidth, 22.00*mm);
+  SetGeometryParameter(PmtPhotoCathodeThickness, 0.50*mm);
+  SetGeometryParameter(PmtBaseThickness, 1.50*mm);
+  SetGeometryParameter(PmtToPmtBase, 3.00*mm);
+
+  SetGeometryParameter(NbTopPmtsFirstRow, 2);
+  SetGeometryParameter(NbTopPmtsSecondRow, 3);
+  SetGeometryParameter(NbTopPmtsThirdRow, 2);
+  SetGeometryParameter(NbTopPmts, 7);
+
+  SetGeometryParameter(NbBottomPmtsFirstRow, 2);
+  SetGeometryParameter(NbBottomPmtsSecondRow, 3);
+  SetGeometryParameter(NbBottomPmtsThirdRow, 2);
+  SetGeometryParameter(NbBottomPmts, 7);
+
+  // a layout table replaces the rows
+  if(!m_hTopPmtLayout.empty() || !m_hBottomPmtLayout.empty())
+    {
+      SetGeometryParameter(NbTopPmts, m_hTopPmtLayout.size());
+      SetGeometryParameter(NbBottomPmts, m_hBottomPmtLayout.size());
+    }
+
+  SetGeometryParameter(SpaceBelowTopPMTHeight, 3.05*mm);
 
   // inner cryostat
-  m_hGeometryParameters["InnerCryostatBlindFlangeThickness"]     = 22.2*mm;
-  m_hGeometryParameters["InnerCryostatBoreFlangeThickness"]     = 22.2*mm;
-  m_hGeometryParameters["InnerCryostatBoreFlangeOuterRadius"]     = 101.15*mm;
-  m_hGeometryParameters["InnerCryostatBlindFlangeOuterRadius"]     = 101.15*mm;
-  m_hGeometryParameters["BoreFlangeNumber"] =2 ;
-  m_hGeometryParameters["BlindFlangeNumber"] =2 ;
+  SetGeometryParameter(InnerCryostatBlindFlangeThickness, 22.2*mm);
+  SetGeometryParameter(InnerCryostatBoreFlangeThickness, 22.2*mm);
+  SetGeometryParameter(InnerCryostatBoreFlangeOuterRadius, 101.15*mm);
+  SetGeometryParameter(InnerCryostatBlindFlangeOuterRadius, 101.15*mm);
+  SetGeometryParameter(BoreFlangeNumber, 2);
+  SetGeometryParameter(BlindFlangeNumber, 2);
 
-  m_hGeometryParameters["InnerCryostatVesselOuterRadius"]     = 77.5*mm;
-  m_hGeometryParameters["InnerCryostatVesselInnerRadius"]     = 74.0*mm;
-  m_hGeometryParameters["InnerCryostatVesselHeight"]     = 334.0*mm;
-  m_hGeometryParameters["InnerCryostatVesselThickness"]     = 3.5*mm;
+  SetGeometryParameter(InnerCryostatVesselOuterRadius, 77.5*mm);
+  SetGeometryParameter(InnerCryostatVesselInnerRadius, 74.0*mm);
+  SetGeometryParameter(InnerCryostatVesselHeight, 334.0*mm);
+  SetGeometryParameter(InnerCryostatVesselThickness, 3.5*mm);
 
-  m_hGeometryParameters["CryostatToTopPMTCasingSpacing"] = 18.45*mm;
+  SetGeometryParameter(CryostatToTopPMTCasingSpacing, 18.45*mm);
 
-  m_hGeometryParameters["CryostatBottomDistanceBetweenLXeAndPTFE"]=10.2*mm; //this small distance at the bottom of the cryostat where you have LXe and screws etc etc
+  SetGeometryParameter(CryostatBottomDistanceBetweenLXeAndPTFE, 10.2*mm); //this small distance at the bottom of the cryostat where you have LXe and screws etc etc
 
-  m_hGeometryParameters["TopBoreFlangeInnerCryostatToLiquidLevel"]     = 86.4*mm;
+  SetGeometryParameter(TopBoreFlangeInnerCryostatToLiquidLevel, 86.4*mm);
 
-  m_hGeometryParameters["InnerCryostatCopperRingsOuterRadius"]     = 85.5*mm;
-  m_hGeometryParameters["InnerCryostatCopperRingsInnerRadius"]     = 76.5*mm;
-  m_hGeometryParameters["InnerCryostatCopperRingsThickness"]     = 2.0*mm;
-  m_hGeometryParameters["InnerCryostatCopperRingsNumber"] =2 ;
+  SetGeometryParameter(InnerCryostatCopperRingsOuterRadius, 85.5*mm);
+  SetGeometryParameter(InnerCryostatCopperRingsInnerRadius, 76.5*mm);
+  SetGeometryParameter(InnerCryostatCopperRingsThickness, 2.0*mm);
+  SetGeometryParameter(InnerCryostatCopperRingsNumber, 2);
 
   // outer cryostat
-  m_hGeometryParameters["OuterCryostatBlindFlangeThickness"]     = 16.0*mm;
-  m_hGeometryParameters["OuterCryostatBoreFlangeThickness"]     = 16.0*mm;
-  m_hGeometryParameters["OuterCryostatBoreFlangeOuterRadius"]     = 167.5*mm;
-  m_hGeometryParameters["OuterCryostatBoreFlangeInnerRadius"]     = 130.5*mm;
-  m_hGeometryParameters["OuterCryostatBlindFlangeOuterRadius"]     = 167.5*mm;
-  m_hGeometryParameters["OuterCryostatBoreFlangeNumber"] =2 ;
-  m_hGeometryParameters["OuterCryostatBlindFlangeNumber"] =2 ;
-
-	m_hGeometryParameters["OuterCryostatVesselOuterRadius"]     = 136.5*mm;
-  m_hGeometryParameters["OuterCryostatVesselInnerRadius"]     = 133.5*mm;
-  m_hGeometryParameters["OuterCryostatVesselHeight"]     = 1512.0*mm; //inc bore flanges
-  m_hGeometryParameters["OuterCryostatVesselThickness"]     = 3.0*mm;
-
-  m_hGeometryParameters["OuterCryostatToTurboPumpTubeInnerRadius"]=50.0*mm;
-  m_hGeometryParameters["OuterCryostatToTurboPumpTubeOuterRadius"]=52.0*mm;
-  //m_hGeometryParameters["OuterCryostatToTurboPumpTubeHeight"]=
-  m_hGeometryParameters["OuterCryostatToTurboPumpTubeFlangeInnerRadius"]=50.0*mm;
-  m_hGeometryParameters["OuterCryostatToTurboPumpTubeFlangeOuterRadius"]=75.75*mm;
-  m_hGeometryParameters["OuterCryostatToTurboPumpTubeFlangeThickness"]=20.0*mm;
-
-  m_hGeometryParameters["OuterCryostatBottomToTurboPumpTube"]=242.0*mm;
-	m_hGeometryParameters["OuterCryostatTopToTopFlangeTPCCryostat"]=795.0*mm;
- 	m_hGeometryParameters["OuterCryostatBottomToBottomFlangeTPCCryostat"]=264.6*mm;
+  SetGeometryParameter(OuterCryostatBlindFlangeThickness, 16.0*mm);
+  SetGeometryParameter(OuterCryostatBoreFlangeThickness, 16.0*mm);
+  SetGeometryParameter(OuterCryostatBoreFlangeOuterRadius, 167.5*mm);
+  SetGeometryParameter(OuterCryostatBoreFlangeInnerRadius, 130.5*mm);
+  SetGeometryParameter(OuterCryostatBlindFlangeOuterRadius, 167.5*mm);
+  SetGeometryParameter(OuterCryostatBoreFlangeNumber, 2);
+  SetGeometryParameter(OuterCryostatBlindFlangeNumber, 2);
+
+	SetGeometryParameter(OuterCryostatVesselOuterRadius, 136.5*mm);
+  SetGeometryParameter(OuterCryostatVesselInnerRadius, 133.5*mm);
+  SetGeometryParameter(OuterCryostatVesselHeight, 1512.0*mm); //inc bore flanges
+  SetGeometryParameter(OuterCryostatVesselThickness, 3.0*mm);
+
+  SetGeometryParameter(OuterCryostatToTurboPumpTubeInnerRadius, 50.0*mm);
+  SetGeometryParameter(OuterCryostatToTurboPumpTubeOuterRadius, 52.0*mm);
+  //SetGeometryParameter(OuterCryostatToTurboPumpTubeHeight, );
+  SetGeometryParameter(OuterCryostatToTurboPumpTubeFlangeInnerRadius, 50.0*mm);
+  SetGeometryParameter(OuterCryostatToTurboPumpTubeFlangeOuterRadius, 75.75*mm);
+  SetGeometryParameter(OuterCryostatToTurboPumpTubeFlangeThickness, 20.0*mm);
+
+  SetGeometryParameter(OuterCryostatBottomToTurboPumpTube, 242.0*mm);
+	SetGeometryParameter(OuterCryostatTopToTopFlangeTPCCryostat, 795.0*mm);
+ 	SetGeometryParameter(OuterCryostatBottomToBottomFlangeTPCCryostat, 264.6*mm);
 
   // derived quantities
   //LXeHeight is defined as the cryostat so that the LXe can be used as mother volume
- 	m_hGeometryParameters["LXeHeight"] = GetGeometryParameter("InnerCryostatVesselHeight");
+ 	SetGeometryParameter(LXeHeight, GetGeometryParameter(InnerCryostatVesselHeight));
 
-  m_hGeometryParameters["GXeHeight"] = GetGeometryParameter("InnerCryostatBoreFlangeThickness")+GetGeometryParameter("CryostatToTopPMTCasingSpacing")+GetGeometryParameter("TopPMTHolderPlateThickness")+GetGeometryParameter("ScreeningMeshToAnode")+ GetGeometryParameter("AnodeToLiquidLevel")+0.01;
+  SetGeometryParameter(GXeHeight, GetGeometryParameter(InnerCryostatBoreFlangeThickness)+GetGeometryParameter(CryostatToTopPMTCasingSpacing)+GetGeometryParameter(TopPMTHolderPlateThickness)+GetGeometryParameter(ScreeningMeshToAnode)+ GetGeometryParameter(AnodeToLiquidLevel)+0.01);
 
-  m_hGeometryParameters["LXeLevelZeroOffset"] = 0.5*GetGeometryParameter("LXeHeight")-GetGeometryParameter("InnerCryostatBoreFlangeThickness")-GetGeometryParameter("CryostatToTopPMTCasingSpacing")-GetGeometryParameter("TopPMTHolderPlateThickness")-GetGeometryParameter("ScreeningMeshToAnode")-GetGeometryParameter("AnodeToLiquidLevel");//LXe is usually mother volume. Defining liquid level as a zero offset, a reference point for the calculation of all the other offsets when the LXe is the mother volume
+  SetGeometryParameter(LXeLevelZeroOffset, 0.5*GetGeometryParameter(LXeHeight)-GetGeometryParameter(InnerCryostatBoreFlangeThickness)-GetGeometryParameter(CryostatToTopPMTCasingSpacing)-GetGeometryParameter(TopPMTHolderPlateThickness)-GetGeometryParameter(ScreeningMeshToAnode)-GetGeometryParameter(AnodeToLiquidLevel));//LXe is usually mother volume. Defining liquid level as a zero offset, a reference point for the calculation of all the other offsets when the LXe is the mother volume
 
-  const G4double dLXeLevelZeroOffset =GetGeometryParameter("LXeLevelZeroOffset");
+  const G4double dLXeLevelZeroOffset =GetGeometryParameter(LXeLevelZeroOffset);
   //G4cout<<"dLXeLevelZeroOffset: " << dLXeLevelZeroOffset << G4endl;
 
-   m_hGeometryParameters["InnerCryostatVesselOffsetZ"] = -(0.5*GetGeometryParameter("OuterCryostatVesselHeight")-GetGeometryParameter("OuterCryostatBottomToBottomFlangeTPCCryostat")-GetGeometryParameter("InnerCryostatBlindFlangeThickness")-0.5*GetGeometryParameter("InnerCryostatVesselHeight")); //wrt center of outer cryostat
+   SetGeometryParameter(InnerCryostatVesselOffsetZ, -(0.5*GetGeometryParameter(OuterCryostatVesselHeight)-GetGeometryParameter(OuterCryostatBottomToBottomFlangeTPCCryostat)-GetGeometryParameter(InnerCryostatBlindFlangeThickness)-0.5*GetGeometryParameter(InnerCryostatVesselHeight))); //wrt center of outer cryostat
 
-  m_hGeometryParameters["LXeLevelToTopTPCCryostat"] = GetGeometryParameter("AnodeToLiquidLevel")+ GetGeometryParameter("ScreeningMeshToAnode")+ GetGeometryParameter("TopPMTHolderPlateThickness")+ GetGeometryParameter("CryostatToTopPMTCasingSpacing")+ GetGeometryParameter("InnerCryostatBoreFlangeThickness");
+  SetGeometryParameter(LXeLevelToTopTPCCryostat, GetGeometryParameter(AnodeToLiquidLevel)+ GetGeometryParameter(ScreeningMeshToAnode)+ GetGeometryParameter(TopPMTHolderPlateThickness)+ GetGeometryParameter(CryostatToTopPMTCasingSpacing)+ GetGeometryParameter(InnerCryostatBoreFlangeThickness));
+
+  SetGeometryParameter(DriftLength, GetGeometryParameter(TeflonCentralCylinderHeight)); //gate to cathode
 
   // verifications
-  // assert(GetGeometryParameter("TeflonPanelHeight") == GetGeometryParameter("DriftLength")-GetGeometryParameter("GridRingThickness"));
+  // assert(GetGeometryParameter(TeflonPanelHeight) == GetGeometryParameter(DriftLength)-GetGeometryParameter(GridRingThickness));
 }
 
 //******************************************************************/
@@ -616,38 +710,38 @@ void muensterTPCDetectorConstruction::ConstructOuterCryostat() {
    G4Material *SS316LSteel = G4Material::GetMaterial("SS316LSteel");
    G4Material *Copper = G4Material::GetMaterial("Copper");
    
-   const G4double dLXeHeight = GetGeometryParameter("LXeHeight");
+   const G4double dLXeHeight = GetGeometryParameter(LXeHeight);
    const G4double dLXeHalfZ = 0.5*dLXeHeight;
-   const G4double dOuterCryostatBlindFlangeThickness = GetGeometryParameter("OuterCryostatBlindFlangeThickness");
-   const G4double dOuterCryostatBoreFlangeThickness = GetGeometryParameter("OuterCryostatBoreFlangeThickness");
-   const G4double dOuterCryostatBoreFlangeOuterRadius = GetGeometryParameter("OuterCryostatBoreFlangeOuterRadius");
-   const G4double dOuterCryostatBoreFlangeInnerRadius = GetGeometryParameter("OuterCryostatBoreFlangeInnerRadius");
-   const G4double dOuterCryostatBlindFlangeOuterRadius = GetGeometryParameter("OuterCryostatBlindFlangeOuterRadius");
-   const G4int dOuterCryostatBoreFlangeNumber = GetGeometryParameter("OuterCryostatBoreFlangeNumber");
-   const G4int dOuterCryostatBlindFlangeNumber = GetGeometryParameter("OuterCryostatBlindFlangeNumber");
-   const G4double dOuterCryostatVesselOuterRadius = GetGeometryParameter("OuterCryostatVesselOuterRadius");
-   const G4double dOuterCryostatVesselInnerRadius = GetGeometryParameter("OuterCryostatVesselInnerRadius");
-   const G4double dOuterCryostatVesselHeight = GetGeometryParameter("OuterCryostatVesselHeight");
-   const G4double dOuterCryostatVesselThickness = GetGeometryParameter("OuterCryostatVesselThickness");
-   const G4double dOuterCryostatToTurboPumpTubeInnerRadius = GetGeometryParameter("OuterCryostatToTurboPumpTubeInnerRadius");
-   const G4double dOuterCryostatToTurboPumpTubeOuterRadius = GetGeometryParameter("OuterCryostatToTurboPumpTubeOuterRadius");
-   const G4double dOuterCryostatToTurboPumpTubeFlangeInnerRadius = GetGeometryParameter("OuterCryostatToTurboPumpTubeFlangeInnerRadius");
-   const G4double dOuterCryostatToTurboPumpTubeFlangeOuterRadius = GetGeometryParameter("OuterCryostatToTurboPumpTubeFlangeOuterRadius");
-   const G4double dOuterCryostatToTurboPumpTubeFlangeThickness= GetGeometryParameter("OuterCryostatToTurboPumpTubeFlangeThickness");
+   const G4double dOuterCryostatBlindFlangeThickness = GetGeometryParameter(OuterCryostatBlindFlangeThickness);
+   const G4double dOuterCryostatBoreFlangeThickness = GetGeometryParameter(OuterCryostatBoreFlangeThickness);
+   const G4double dOuterCryostatBoreFlangeOuterRadius = GetGeometryParameter(OuterCryostatBoreFlangeOuterRadius);
+   const G4double dOuterCryostatBoreFlangeInnerRadius = GetGeometryParameter(OuterCryostatBoreFlangeInnerRadius);
+   const G4double dOuterCryostatBlindFlangeOuterRadius = GetGeometryParameter(OuterCryostatBlindFlangeOuterRadius);
+   const G4int dOuterCryostatBoreFlangeNumber = GetGeometryParameter(OuterCryostatBoreFlangeNumber);
+   const G4int dOuterCryostatBlindFlangeNumber = GetGeometryParameter(OuterCryostatBlindFlangeNumber);
+   const G4double dOuterCryostatVesselOuterRadius = GetGeometryParameter(OuterCryostatVesselOuterRadius);
+   const G4double dOuterCryostatVesselInnerRadius = GetGeometryParameter(OuterCryostatVesselInnerRadius);
+   const G4double dOuterCryostatVesselHeight = GetGeometryParameter(OuterCryostatVesselHeight);
+   const G4double dOuterCryostatVesselThickness = GetGeometryParameter(OuterCryostatVesselThickness);
+   const G4double dOuterCryostatToTurboPumpTubeInnerRadius = GetGeometryParameter(OuterCryostatToTurboPumpTubeInnerRadius);
+   const G4double dOuterCryostatToTurboPumpTubeOuterRadius = GetGeometryParameter(OuterCryostatToTurboPumpTubeOuterRadius);
+   const G4double dOuterCryostatToTurboPumpTubeFlangeInnerRadius = GetGeometryParameter(OuterCryostatToTurboPumpTubeFlangeInnerRadius);
+   const G4double dOuterCryostatToTurboPumpTubeFlangeOuterRadius = GetGeometryParameter(OuterCryostatToTurboPumpTubeFlangeOuterRadius);
+   const G4double dOuterCryostatToTurboPumpTubeFlangeThickness= GetGeometryParameter(OuterCryostatToTurboPumpTubeFlangeThickness);
    
-   const G4double dOuterCryostatBottomToTurboPumpTube = GetGeometryParameter("OuterCryostatBottomToTurboPumpTube");
-   const G4double dOuterCryostatTopToTopFlangeTPCCryostat = GetGeometryParameter("OuterCryostatTopToTopFlangeTPCCryostat");
-   const G4double dOuterCryostatBottomToBottomFlangeTPCCryostat = GetGeometryParameter("OuterCryostatBottomToBottomFlangeTPCCryostat");
+   const G4double dOuterCryostatBottomToTurboPumpTube = GetGeometryParameter(OuterCryostatBottomToTurboPumpTube);
+   const G4double dOuterCryostatTopToTopFlangeTPCCryostat = GetGeometryParameter(OuterCryostatTopToTopFlangeTPCCryostat);
+   const G4double dOuterCryostatBottomToBottomFlangeTPCCryostat = GetGeometryParameter(OuterCryostatBottomToBottomFlangeTPCCryostat);
 
-   const G4double dInnerCryostatBlindFlangeThickness = GetGeometryParameter("InnerCryostatBlindFlangeThickness");
+   const G4double dInnerCryostatBlindFlangeThickness = GetGeometryParameter(InnerCryostatBlindFlangeThickness);
 
-   const G4double dLXeLevelZeroOffset = GetGeometryParameter("LXeLevelZeroOffset");
-   const G4double dScreeningMeshToAnode= GetGeometryParameter("ScreeningMeshToAnode");
-   const G4double dAnodeToLiquidLevel= GetGeometryParameter("AnodeToLiquidLevel");
-   const G4double dTopPMTHolderPlateThickness= GetGeometryParameter("TopPMTHolderPlateThickness");
-   const G4double dCryostatToTopPMTCasingSpacing= GetGeometryParameter("CryostatToTopPMTCasingSpacing");
+   const G4double dLXeLevelZeroOffset = GetGeometryParameter(LXeLevelZeroOffset);
+   const G4double dScreeningMeshToAnode= GetGeometryParameter(ScreeningMeshToAnode);
+   const G4double dAnodeToLiquidLevel= GetGeometryParameter(AnodeToLiquidLevel);
+   const G4double dTopPMTHolderPlateThickness= GetGeometryParameter(TopPMTHolderPlateThickness);
+   const G4double dCryostatToTopPMTCasingSpacing= GetGeometryParameter(CryostatToTopPMTCasingSpacing);
  
-   const G4double dLXeLevelToTopTPCCryostat= GetGeometryParameter("LXeLevelToTopTPCCryostat");
+   const G4double dLXeLevelToTopTPCCryostat= GetGeometryParameter(LXeLevelToTopTPCCryostat);
    
    //<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<< outer cryostat vessel>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>.
    const G4double dOuterCryostatVesselHalfZ=0.5*dOuterCryostatVesselHeight;
@@ -752,31 +846,31 @@ void muensterTPCDetectorConstruction::ConstructOuterCryostat() {
 //******************************************************************/
 void muensterTPCDetectorConstruction::ConstructInnerCryostat() {
   //<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<< cryostat >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-  const G4double dLXeHeight = GetGeometryParameter("LXeHeight");
+  const G4double dLXeHeight = GetGeometryParameter(LXeHeight);
   const G4double dLXeHalfZ = 0.5*dLXeHeight;
   //const G4double d = GetGeometryParameter("");
 
-  const G4double dInnerCryostatVesselOuterRadius = GetGeometryParameter("InnerCryostatVesselOuterRadius");
-  const G4double dInnerCryostatVesselInnerRadius = GetGeometryParameter("InnerCryostatVesselInnerRadius");
-  const G4double dInnerCryostatVesselHeight = GetGeometryParameter("InnerCryostatVesselHeight");
-  const G4double dOuterCryostatVesselHeight = GetGeometryParameter("OuterCryostatVesselHeight");
-  //const G4double dInnerCryostatVesselThickness = GetGeometryParameter("InnerCryostatVesselThickness");
+  const G4double dInnerCryostatVesselOuterRadius = GetGeometryParameter(InnerCryostatVesselOuterRadius);
+  const G4double dInnerCryostatVesselInnerRadius = GetGeometryParameter(InnerCryostatVesselInnerRadius);
+  const G4double dInnerCryostatVesselHeight = GetGeometryParameter(InnerCryostatVesselHeight);
+  const G4double dOuterCryostatVesselHeight = GetGeometryParameter(OuterCryostatVesselHeight);
+  //const G4double dInnerCryostatVesselThickness = GetGeometryParameter(InnerCryostatVesselThickness);
 
-  //const G4double dCryostatToTopPMTCasingSpacing = GetGeometryParameter("CryostatToTopPMTCasingSpacing");
-  //const G4double dCryostatBottomDistanceBetweenLXeAndPTFE = GetGeometryParameter("CryostatBottomDistanceBetweenLXeAndPTFE");
+  //const G4double dCryostatToTopPMTCasingSpacing = GetGeometryParameter(CryostatToTopPMTCasingSpacing);
+  //const G4double dCryostatBottomDistanceBetweenLXeAndPTFE = GetGeometryParameter(CryostatBottomDistanceBetweenLXeAndPTFE);
 
-  const G4double dInnerCryostatBlindFlangeThickness = GetGeometryParameter("InnerCryostatBlindFlangeThickness");
-  const G4double dInnerCryostatBlindFlangeOuterRadius= GetGeometryParameter("InnerCryostatBlindFlangeOuterRadius");
+  const G4double dInnerCryostatBlindFlangeThickness = GetGeometryParameter(InnerCryostatBlindFlangeThickness);
+  const G4double dInnerCryostatBlindFlangeOuterRadius= GetGeometryParameter(InnerCryostatBlindFlangeOuterRadius);
 
-  const G4double dInnerCryostatBoreFlangeThickness = GetGeometryParameter("InnerCryostatBoreFlangeThickness");
-  const G4double dInnerCryostatBoreFlangeOuterRadius= GetGeometryParameter("InnerCryostatBoreFlangeOuterRadius");
+  const G4double dInnerCryostatBoreFlangeThickness = GetGeometryParameter(InnerCryostatBoreFlangeThickness);
+  const G4double dInnerCryostatBoreFlangeOuterRadius= GetGeometryParameter(InnerCryostatBoreFlangeOuterRadius);
 
-  //const G4double dTopBoreFlangeInnerCryostatToLiquidLevel= GetGeometryParameter("dTopBoreFlangeInnerCryostatToLiquidLevel");
+  //const G4double dTopBoreFlangeInnerCryostatToLiquidLevel= GetGeometryParameter(dTopBoreFlangeInnerCryostatToLiquidLevel);
 
   const G4double dInnerCryostatVesselHalfZ = dInnerCryostatVesselHeight*0.5;
   const G4double dOuterCryostatVesselHalfZ = dOuterCryostatVesselHeight*0.5;
   const G4double dTotalTPCHalfZ = dOuterCryostatVesselHeight*0.5;
-  const G4double dOuterCryostatBottomToBottomFlangeTPCCryostat= GetGeometryParameter("OuterCryostatBottomToBottomFlangeTPCCryostat");
+  const G4double dOuterCryostatBottomToBottomFlangeTPCCryostat= GetGeometryParameter(OuterCryostatBottomToBottomFlangeTPCCryostat);
 
   G4Material *SS304LSteel = G4Material::GetMaterial("SS304LSteel");
   G4Material *Vacuum = G4Material::GetMaterial("Vacuum");
@@ -786,7 +880,7 @@ void muensterTPCDetectorConstruction::ConstructInnerCryostat() {
   G4Material *GXeTeflon = G4Material::GetMaterial("GXeTeflon");
 
   //=============================== cryostat vessel ===============================
-  const G4double dInnerCryostatVesselOffsetZ = GetGeometryParameter("InnerCryostatVesselOffsetZ"); 
+  const G4double dInnerCryostatVesselOffsetZ = GetGeometryParameter(InnerCryostatVesselOffsetZ); 
  
   //G4cout << "InnerCryostatVesselOffsetZ: " << dInnerCryostatVesselOffsetZ << G4endl;
 
@@ -800,7 +894,7 @@ void muensterTPCDetectorConstruction::ConstructInnerCryostat() {
 
   // =========================== bore flanges  ====================================
   const G4double dInnerCryostatBoreFlangeHalfZ = dInnerCryostatBoreFlangeThickness*0.5;
-  const G4int dBoreFlangeNumber = GetGeometryParameter("BoreFlangeNumber");
+  const G4int dBoreFlangeNumber = GetGeometryParameter(BoreFlangeNumber);
 	
   const G4double dInnerCryostatBottomBoreFlangeOffsetZ = (dInnerCryostatVesselOffsetZ-dLXeHalfZ+dInnerCryostatBoreFlangeHalfZ);//-(dLXeHalfZ-dInnerCryostatBoreFlangeHalfZ);// -(dLXeHalfZ+dTopBoreFlangeInnerCryostatToLiquidLevel-dInnerCryostatBoreFlangeHalfZ);
 
@@ -832,7 +926,7 @@ void muensterTPCDetectorConstruction::ConstructInnerCryostat() {
 
   // ======================== blind flanges ==========================================
   const G4double dInnerCryostatBlindFlangeHalfZ = dInnerCryostatBlindFlangeThickness*0.5;
-  const G4int dBlindFlangeNumber = GetGeometryParameter("BlindFlangeNumber");
+  const G4int dBlindFlangeNumber = GetGeometryParameter(BlindFlangeNumber);
 	
   const G4double dInnerCryostatBottomBlindFlangeOffsetZ = (dInnerCryostatVesselOffsetZ-dLXeHalfZ-dInnerCryostatBoreFlangeThickness+dInnerCryostatBlindFlangeHalfZ);//(dLXeHalfZ+dInnerCryostatBlindFlangeHalfZ);// -(dLXeHalfZ+dTopBlindFlangeInnerCryostatToLiquidLevel-dInnerCryostatBlindFlangeHalfZ);
 
@@ -863,12 +957,12 @@ void muensterTPCDetectorConstruction::ConstructInnerCryostat() {
   // ========================== copper rings =============================
   //the 2 copper rings between the blind and bore flanges
 
-  const G4double dInnerCryostatCopperRingsOuterRadius = GetGeometryParameter("InnerCryostatCopperRingsOuterRadius");
-  const G4double dInnerCryostatCopperRingsInnerRadius = GetGeometryParameter("InnerCryostatCopperRingsInnerRadius");
-  const G4double dInnerCryostatCopperRingsThickness = GetGeometryParameter("InnerCryostatCopperRingsThickness");
-  const G4int dInnerCryostatCopperRingsNumber= GetGeometryParameter("InnerCryostatCopperRingsNumber");
+  const G4double dInnerCryostatCopperRingsOuterRadius = GetGeometryParameter(InnerCryostatCopperRingsOuterRadius);
+  const G4double dInnerCryostatCopperRingsInnerRadius = GetGeometryParameter(InnerCryostatCopperRingsInnerRadius);
+  const G4double dInnerCryostatCopperRingsThickness = GetGeometryParameter(InnerCryostatCopperRingsThickness);
+  const G4int dInnerCryostatCopperRingsNumber= GetGeometryParameter(InnerCryostatCopperRingsNumber);
 
-  const G4double dInnerCryostatCopperRingsHalfZ = 0.5*GetGeometryParameter("InnerCryostatCopperRingsThickness");
+  const G4double dInnerCryostatCopperRingsHalfZ = 0.5*GetGeometryParameter(InnerCryostatCopperRingsThickness);
 
   const G4double dInnerCryostatBottomCopperRingsOffsetZ =(dInnerCryostatVesselOffsetZ-dLXeHalfZ+dInnerCryostatCopperRingsHalfZ);// -(dLXeHalfZ+dInnerCryostatCopperRingsHalfZ);// -(dLXeHalfZ+dTopCopperRingsInnerCryostatToLiquidLevel-dInnerCryostatCopperRingsHalfZ);
   
@@ -927,21 +1021,21 @@ void muensterTPCDetectorConstruction::ConstructInnerCryostat() {
 void muensterTPCDetectorConstruction::ConstructXenon() {
   //<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<< xenon >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 
-  const G4double dLXeRadius = GetGeometryParameter("InnerCryostatVesselOuterRadius");
+  const G4double dLXeRadius = GetGeometryParameter(InnerCryostatVesselOuterRadius);
 
   //G4cout << "LXe radius: " << dLXeRadius << G4endl;
 
-  const G4double dLXeHeight = GetGeometryParameter("LXeHeight");
-  const G4double dGXeHeight = GetGeometryParameter("GXeHeight");
+  const G4double dLXeHeight = GetGeometryParameter(LXeHeight);
+  const G4double dGXeHeight = GetGeometryParameter(GXeHeight);
 
   //G4cout << "dLXeHeight: " << dLXeHeight << G4endl;
   //G4cout << "dGXeHeight: " << dGXeHeight << G4endl;
 
-  // const G4double dZeroOffset = (m_pMotherLogicalVolume==m_pLXeLogicalVolume)?(GetGeometryParameter("GateMeshZeroOffset")):(0.);
+  // const G4double dZeroOffset = (m_pMotherLogicalVolume==m_pLXeLogicalVolume)?(GetGeometryParameter(GateMeshZeroOffset)):(0.);
   // G4cout<<"dZeroOffset: " << dZeroOffset << G4endl;
 
-  const G4double dLiquidLevelToGateMesh = GetGeometryParameter("LiquidLevelToGateMesh");
-  const G4double dInnerCryostatVesselOffsetZ = GetGeometryParameter("InnerCryostatVesselOffsetZ"); 
+  const G4double dLiquidLevelToGateMesh = GetGeometryParameter(LiquidLevelToGateMesh);
+  const G4double dInnerCryostatVesselOffsetZ = GetGeometryParameter(InnerCryostatVesselOffsetZ); 
 
   //G4Material *LXe = G4Material::GetMaterial("LXe");
 	G4Material *LXe = LXeMaterial;
@@ -964,15 +1058,11 @@ void muensterTPCDetectorConstruction::ConstructXenon() {
   m_pLXePhysicalVolume = new G4PVPlacement(0, G4ThreeVector(0., 0., dLXeOffsetZ),
 					   m_pLXeLogicalVolume, LXeMaterial->GetName(), m_pOuterCryostatVacuumLogicalVolume, false, 0);
 
-	//TackLimit for opticalphotons (see physics list)
-  G4double maxTrack = 100000;
-  fStepLimit = new G4UserLimits(DBL_MAX,maxTrack);
-  m_pLXeLogicalVolume->SetUserLimits(fStepLimit);
 	
   //================================ gaseous xenon ================================
   //defined as a G4Tubs inside the LXe G4Tubs
 		
-  const G4double dGXeRadius = dLXeRadius;//GetGeometryParameter("InnerCryostatVesselInnerRadius");
+  const G4double dGXeRadius = dLXeRadius;//GetGeometryParameter(InnerCryostatVesselInnerRadius);
   const G4double dGXeHalfZ = 0.5*dGXeHeight;
   const G4double dGXeOffsetZ = dLXeHalfZ-dGXeHalfZ;
 
@@ -987,14 +1077,6 @@ void muensterTPCDetectorConstruction::ConstructXenon() {
 					   m_pGXeLogicalVolume, "GXe", m_pLXeLogicalVolume, false, 0);
 
 
-  //------------------------------ xenon sensitivity ------------------------------
-  G4SDManager *pSDManager = G4SDManager::GetSDMpointer();
-
-  muensterTPCLXeSensitiveDetector *pLXeSD = new muensterTPCLXeSensitiveDetector("muensterTPC/LXeSD");
-  pSDManager->AddNewDetector(pLXeSD);
-  m_pLXeLogicalVolume->SetSensitiveDetector(pLXeSD);
-  m_pGXeLogicalVolume->SetSensitiveDetector(pLXeSD);
-
   //================================== attributes =================================
   G4Colour hLXeColor(0.0,0.0,1.0,DetectorMaterialAlphaChannel); //blue
   G4Colour hGXeColor(0.0,1.0,1.0,DetectorMaterialAlphaChannel); //cyan
@@ -1014,34 +1096,34 @@ void muensterTPCDetectorConstruction::ConstructXenon() {
 void muensterTPCDetectorConstruction::ConstructTPC() {
   //<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<< TPC >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 
-  const G4double dLXeLevelZeroOffset =GetGeometryParameter("LXeLevelZeroOffset");
+  const G4double dLXeLevelZeroOffset =GetGeometryParameter(LXeLevelZeroOffset);
 
-  const G4double dLXeHeight = GetGeometryParameter("LXeHeight");
+  const G4double dLXeHeight = GetGeometryParameter(LXeHeight);
   const G4double dLXeHalfZ = 0.5*dLXeHeight;
-  const G4double dLiquidLevelToGateMesh = GetGeometryParameter("LiquidLevelToGateMesh");
+  const G4double dLiquidLevelToGateMesh = GetGeometryParameter(LiquidLevelToGateMesh);
 
-  const G4double dGXeHeight = GetGeometryParameter("GXeHeight");
+  const G4double dGXeHeight = GetGeometryParameter(GXeHeight);
   const G4double dGXeHalfZ = 0.5*dGXeHeight;
 
-  const G4double dTeflonCentralCylinderInnerRadius= GetGeometryParameter("TeflonCentralCylinderInnerRadius");
-  const G4double dTeflonCentralCylinderOuterRadius= GetGeometryParameter("TeflonCentralCylinderOuterRadius");
-  const G4double dTeflonCentralCylinderHeight =  GetGeometryParameter("TeflonCentralCylinderHeight");
+  const G4double dTeflonCentralCylinderInnerRadius= GetGeometryParameter(TeflonCentralCylinderInnerRadius);
+  const G4double dTeflonCentralCylinderOuterRadius= GetGeometryParameter(TeflonCentralCylinderOuterRadius);
+  const G4double dTeflonCentralCylinderHeight =  GetGeometryParameter(TeflonCentralCylinderHeight);
   const G4double dTeflonCentralCylinderHalfZ =  0.5*dTeflonCentralCylinderHeight;
   
   //G4cout << "TeflonCentralCylinderHeight: " << dTeflonCentralCylinderHeight << G4endl;
   //G4cout << "TeflonCentralCylinderInnerRadius: " << dTeflonCentralCylinderInnerRadius << G4endl;
   //G4cout << "TeflonCentralCylinderOuterRadius: " << dTeflonCentralCylinderOuterRadius << G4endl;
 
-  const G4double dTeflonOuterCylinderInnerRadius= GetGeometryParameter("TeflonOuterCylinderInnerRadius");
-  const G4double dTeflonOuterCylinderOuterRadius= GetGeometryParameter("TeflonOuterCylinderOuterRadius");
-  const G4double dTeflonOuterCylinderHeight =  GetGeometryParameter("TeflonOuterCylinderHeight");
+  const G4double dTeflonOuterCylinderInnerRadius= GetGeometryParameter(TeflonOuterCylinderInnerRadius);
+  const G4double dTeflonOuterCylinderOuterRadius= GetGeometryParameter(TeflonOuterCylinderOuterRadius);
+  const G4double dTeflonOuterCylinderHeight =  GetGeometryParameter(TeflonOuterCylinderHeight);
   const G4double dTeflonOuterCylinderHalfZ =  0.5*dTeflonOuterCylinderHeight;
   
   //G4cout << "TeflonOuterCylinderHeight: " << dTeflonOuterCylinderHeight << G4endl;
   //G4cout << "TeflonOuterCylinderInnerRadius: " << dTeflonOuterCylinderInnerRadius << G4endl;
   //G4cout << "TeflonOuterCylinderOuterRadius: " << dTeflonOuterCylinderOuterRadius << G4endl;
 
-  const G4double dCryostatBottomDistanceBetweenLXeAndPTFE= GetGeometryParameter("CryostatBottomDistanceBetweenLXeAndPTFE");
+  const G4double dCryostatBottomDistanceBetweenLXeAndPTFE= GetGeometryParameter(CryostatBottomDistanceBetweenLXeAndPTFE);
 
   G4Material *SS316LSteel = G4Material::GetMaterial("SS316LSteel");
   G4Material *PTFE = G4Material::GetMaterial("Teflon");
@@ -1075,9 +1157,9 @@ void muensterTPCDetectorConstruction::ConstructTPC() {
   //==========================  PTFE bottom PMT holder ==========================
   //includes in reality 3 slabs. top part of pmt holder, bottom part of pmt holder, pmt base holder
   //const G4double = GetGeometryParameter("");
-  const G4double dBottomPMTHolderTopPartThickness = GetGeometryParameter("BottomPMTHolderTopPartThickness");
-  const G4double dBottomPMTHolderBottomPartThickness= GetGeometryParameter("BottomPMTHolderBottomPartThickness");
-  const G4double dBottomPMTBaseHolderThickness= GetGeometryParameter("BottomPMTBaseHolderThickness");
+  const G4double dBottomPMTHolderTopPartThickness = GetGeometryParameter(BottomPMTHolderTopPartThickness);
+  const G4double dBottomPMTHolderBottomPartThickness= GetGeometryParameter(BottomPMTHolderBottomPartThickness);
+  const G4double dBottomPMTBaseHolderThickness= GetGeometryParameter(BottomPMTBaseHolderThickness);
   
   const G4double dPTFEBottomPMTHolderHalfZ = 0.5*(dBottomPMTHolderTopPartThickness+dBottomPMTHolderBottomPartThickness+dBottomPMTBaseHolderThickness);
   //G4cout << "PTFEBottomPMTHolderHalfZ: " << dPTFEBottomPMTHolderHalfZ << G4endl;
@@ -1094,9 +1176,9 @@ void muensterTPCDetectorConstruction::ConstructTPC() {
 
   
   //=========================== PTFE slab between bottom pmt and cathode ==========================
-  const G4double dBottomPTFESlabThickness= GetGeometryParameter("BottomPTFESlabThickness");
-  const G4double dBottomPTFESlabInnerRadius = GetGeometryParameter("BottomPTFESlabInnerRadius");
-  const G4double dBottomPTFESlabOuterRadius = GetGeometryParameter("BottomPTFESlabOuterRadius");
+  const G4double dBottomPTFESlabThickness= GetGeometryParameter(BottomPTFESlabThickness);
+  const G4double dBottomPTFESlabInnerRadius = GetGeometryParameter(BottomPTFESlabInnerRadius);
+  const G4double dBottomPTFESlabOuterRadius = GetGeometryParameter(BottomPTFESlabOuterRadius);
 
   const G4double dBottomPTFESlabHalfZ = dBottomPTFESlabThickness*0.5;
   //G4cout << "BottomPTFESlabHalfZ: " << dBottomPTFESlabHalfZ << G4endl;
@@ -1114,9 +1196,9 @@ void muensterTPCDetectorConstruction::ConstructTPC() {
 
   //==================PTFE slab between gate mesh and top pmt ========================
   // in reality two small slabs
-  const G4double dTopPTFESlabThickness= GetGeometryParameter("TopPTFESlabThickness");
-  const G4double dTopPTFESlabInnerRadius = GetGeometryParameter("TopPTFESlabInnerRadius");
-  const G4double dTopPTFESlabOuterRadius = GetGeometryParameter("TopPTFESlabOuterRadius");
+  const G4double dTopPTFESlabThickness= GetGeometryParameter(TopPTFESlabThickness);
+  const G4double dTopPTFESlabInnerRadius = GetGeometryParameter(TopPTFESlabInnerRadius);
+  const G4double dTopPTFESlabOuterRadius = GetGeometryParameter(TopPTFESlabOuterRadius);
 
   const G4double dTopPTFESlabHalfZ = dTopPTFESlabThickness*0.5;
   //G4cout << "TopPTFESlabHalfZ: " << dTopPTFESlabHalfZ << G4endl;
@@ -1137,10 +1219,10 @@ void muensterTPCDetectorConstruction::ConstructTPC() {
 
   //================ PTFE Top PMT Holder====================
   // includes two slabs to hold pmt
-  const G4double dTopPMTHolderTopPartThickness = GetGeometryParameter("TopPMTHolderTopPartThickness");
-  const G4double dTopPMTHolderBottomPartThickness= GetGeometryParameter("TopPMTHolderBottomPartThickness");
-  const G4double  dTopPMTHolderPlateRadius = GetGeometryParameter("TopPMTHolderPlateRadius");
-  const G4double  dLiquidLevelToScreenMesh= GetGeometryParameter("LiquidLevelToScreenMesh");
+  const G4double dTopPMTHolderTopPartThickness = GetGeometryParameter(TopPMTHolderTopPartThickness);
+  const G4double dTopPMTHolderBottomPartThickness= GetGeometryParameter(TopPMTHolderBottomPartThickness);
+  const G4double  dTopPMTHolderPlateRadius = GetGeometryParameter(TopPMTHolderPlateRadius);
+  const G4double  dLiquidLevelToScreenMesh= GetGeometryParameter(LiquidLevelToScreenMesh);
 
   const G4double dPTFETopPMTHolderHalfZ = 0.5*(dTopPMTHolderTopPartThickness+dTopPMTHolderBottomPartThickness);
   //G4cout << "PTFETopPMTHolderHalfZ: " << dPTFETopPMTHolderHalfZ << G4endl;
@@ -1160,10 +1242,10 @@ void muensterTPCDetectorConstruction::ConstructTPC() {
 
 
  //================ Steel ring at the bottom on which the PTFE slabs rest ===================
-  const G4double dBottomSteelRingThickness=GetGeometryParameter("BottomSteelRingThickness");
-	const G4double dBottomSteelRingInnerRadius=GetGeometryParameter("BottomSteelRingInnerRadius");
-  const G4double dBottomSteelRingOuterRadius=GetGeometryParameter("BottomSteelRingOuterRadius");
-  const G4double dBottomFlangeCopperRingToTopSteelRing=GetGeometryParameter("BottomFlangeCopperRingToTopSteelRing");
+  const G4double dBottomSteelRingThickness=GetGeometryParameter(BottomSteelRingThickness);
+	const G4double dBottomSteelRingInnerRadius=GetGeometryParameter(BottomSteelRingInnerRadius);
+  const G4double dBottomSteelRingOuterRadius=GetGeometryParameter(BottomSteelRingOuterRadius);
+  const G4double dBottomFlangeCopperRingToTopSteelRing=GetGeometryParameter(BottomFlangeCopperRingToTopSteelRing);
 
   const G4double dBottomSteelRingHalfZ = 0.5*dBottomSteelRingThickness;
   //G4cout << "BottomSteelRingHalfZ: " << dBottomSteelRingHalfZ << G4endl;
@@ -1191,6 +1273,10 @@ void muensterTPCDetectorConstruction::ConstructTPC() {
 	pTeflonOpticalSurface->SetMaterialPropertiesTable(PTFE->GetMaterialPropertiesTable());
 	pSS316LSteelOpticalSurface->SetMaterialPropertiesTable(SS316LSteel->GetMaterialPropertiesTable());
 	pGXeTeflonOpticalSurface->SetMaterialPropertiesTable(GXeTeflon->GetMaterialPropertiesTable());
+
+	m_pTeflonOpticalSurface = pTeflonOpticalSurface;
+	m_pGXeTeflonOpticalSurface = pGXeTeflonOpticalSurface;
+	SaveTeflonSurfaceModel();
 	
 	new G4LogicalBorderSurface("LXeTeflonCylinderLogicalBorderSurface",
 		m_pLXePhysicalVolume, m_pPTFEInnerCylinderPhysicalVolume, pTeflonOpticalSurface);
@@ -1251,9 +1337,9 @@ void muensterTPCDetectorConstruction::ConstructTPC() {
 //******************************************************************/
 void muensterTPCDetectorConstruction::ConstructFieldCage() {
   //<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<< field cage >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-  const G4double dLXeHeight = GetGeometryParameter("LXeHeight");
+  const G4double dLXeHeight = GetGeometryParameter(LXeHeight);
   const G4double dLXeHalfZ = 0.5*dLXeHeight;
-  const G4double dLiquidLevelToGateMesh = GetGeometryParameter("LiquidLevelToGateMesh");
+  const G4double dLiquidLevelToGateMesh = GetGeometryParameter(LiquidLevelToGateMesh);
  
   G4Material *SS316LSteel = G4Material::GetMaterial("SS316LSteel");
   G4Material *Teflon = G4Material::GetMaterial("Teflon");
@@ -1261,15 +1347,15 @@ void muensterTPCDetectorConstruction::ConstructFieldCage() {
   G4Material *GridMeshSS316LSteelLXe = G4Material::GetMaterial("GridMeshSS316LSteelLXe");
   G4Material *GridMeshSS316LSteelGXe = G4Material::GetMaterial("GridMeshSS316LSteelGXe");
 
-  const G4double dLXeLevelZeroOffset = GetGeometryParameter("LXeLevelZeroOffset");
+  const G4double dLXeLevelZeroOffset = GetGeometryParameter(LXeLevelZeroOffset);
 
   //================================= CopperRings ===============================
-  const G4double dCopperRingsOuterRadius= GetGeometryParameter("CopperRingsOuterRadius");
-  const G4double dCopperRingsInnerRadius= GetGeometryParameter("CopperRingsInnerRadius");
-  const G4double dCopperRingsThickness= GetGeometryParameter("CopperRingsThickness");
-  const G4int dCopperRingsNumber= GetGeometryParameter("CopperRingsNumber");
-  const G4double dCopperRingsSpacing= GetGeometryParameter("CopperRingsSpacing");
-  const G4double dGateMeshRingThickness= GetGeometryParameter("GateMeshRingThickness");
+  const G4double dCopperRingsOuterRadius= GetGeometryParameter(CopperRingsOuterRadius);
+  const G4double dCopperRingsInnerRadius= GetGeometryParameter(CopperRingsInnerRadius);
+  const G4double dCopperRingsThickness= GetGeometryParameter(CopperRingsThickness);
+  const G4int dCopperRingsNumber= GetGeometryParameter(CopperRingsNumber);
+  const G4double dCopperRingsSpacing= GetGeometryParameter(CopperRingsSpacing);
+  const G4double dGateMeshRingThickness= GetGeometryParameter(GateMeshRingThickness);
 
   const G4double dFirstCopperRingOffsetZ = dLXeLevelZeroOffset-dLiquidLevelToGateMesh-dGateMeshRingThickness-dCopperRingsSpacing-0.5*dCopperRingsThickness;//(dLXeHalfZ-dLiquidLevelToGateMesh-dGateMeshRingThickness-dCopperRingsSpacing-0.5*dCopperRingsThickness);
 
@@ -1290,32 +1376,32 @@ void muensterTPCDetectorConstruction::ConstructFieldCage() {
       //G4cout<<"pdCopperRingsZ[i]: "<<pdCopperRingsZ[i]<<G4endl;                                                                               
     }
 
-  const G4double dGridMeshThickness= GetGeometryParameter("GridMeshThickness");
-  const G4double dGridMeshRadius= GetGeometryParameter("GridMeshRadius");
-  const G4int dGridMeshNumber= GetGeometryParameter("GridMeshNumber");
+  const G4double dGridMeshThickness= GetGeometryParameter(GridMeshThickness);
+  const G4double dGridMeshRadius= GetGeometryParameter(GridMeshRadius);
+  const G4int dGridMeshNumber= GetGeometryParameter(GridMeshNumber);
 
-  const G4double dGridMeshBorderInnerRadius= GetGeometryParameter("GridMeshBorderInnerRadius");
-  const G4double dGridMeshBorderOuterRadius= GetGeometryParameter("GridMeshBorderOuterRadius");
+  const G4double dGridMeshBorderInnerRadius= GetGeometryParameter(GridMeshBorderInnerRadius);
+  const G4double dGridMeshBorderOuterRadius= GetGeometryParameter(GridMeshBorderOuterRadius);
 
-  const G4double dGridMeshSupportThickness= GetGeometryParameter("GridMeshSupportThickness");
-  const G4double dGridMeshSupportInnerRadius= GetGeometryParameter("GridMeshSupportInnerRadius");
-  const G4double dGridMeshSupportOuterRadius= GetGeometryParameter("GridMeshSupportOuterRadius");
-  const G4int dGridMeshSupportNumber= GetGeometryParameter("GridMeshSupportNumber");
+  const G4double dGridMeshSupportThickness= GetGeometryParameter(GridMeshSupportThickness);
+  const G4double dGridMeshSupportInnerRadius= GetGeometryParameter(GridMeshSupportInnerRadius);
+  const G4double dGridMeshSupportOuterRadius= GetGeometryParameter(GridMeshSupportOuterRadius);
+  const G4int dGridMeshSupportNumber= GetGeometryParameter(GridMeshSupportNumber);
 		
-  const G4double dCathodeGridMeshSupportThickness= GetGeometryParameter("CathodeGridMeshSupportThickness");
-  const G4double dCathodeGridMeshSupportInnerRadius = GetGeometryParameter("CathodeGridMeshSupportInnerRadius");
-  const G4double dCathodeGridMeshSupportOuterRadius = GetGeometryParameter("CathodeGridMeshSupportOuterRadius");
+  const G4double dCathodeGridMeshSupportThickness= GetGeometryParameter(CathodeGridMeshSupportThickness);
+  const G4double dCathodeGridMeshSupportInnerRadius = GetGeometryParameter(CathodeGridMeshSupportInnerRadius);
+  const G4double dCathodeGridMeshSupportOuterRadius = GetGeometryParameter(CathodeGridMeshSupportOuterRadius);
   //const G4double d = GetGeometryParameter("");
 
-  const G4double dAnodeToLiquidLevel = GetGeometryParameter("AnodeToLiquidLevel");
-  const G4double dScreeningMeshToAnode = GetGeometryParameter("ScreeningMeshToAnode");
-  const G4double dCathodeToScreenMesh = GetGeometryParameter("CathodeToScreenMesh");
+  const G4double dAnodeToLiquidLevel = GetGeometryParameter(AnodeToLiquidLevel);
+  const G4double dScreeningMeshToAnode = GetGeometryParameter(ScreeningMeshToAnode);
+  const G4double dCathodeToScreenMesh = GetGeometryParameter(CathodeToScreenMesh);
 
-  const G4double dCryostatBottomDistanceBetweenLXeAndPTFE = GetGeometryParameter("CryostatBottomDistanceBetweenLXeAndPTFE");
-  const G4double dBottomPMTHolderBottomPartThickness = GetGeometryParameter("BottomPMTHolderBottomPartThickness");
-  const G4double dBottomPMTHolderTopPartThickness = GetGeometryParameter("BottomPMTHolderTopPartThickness");
-  const G4double dBottomPMTBaseHolderThickness = GetGeometryParameter("BottomPMTBaseHolderThickness");
-  const G4double dTopBottomPMTToScreeningMesh = GetGeometryParameter("TopBottomPMTToScreeningMesh");
+  const G4double dCryostatBottomDistanceBetweenLXeAndPTFE = GetGeometryParameter(CryostatBottomDistanceBetweenLXeAndPTFE);
+  const G4double dBottomPMTHolderBottomPartThickness = GetGeometryParameter(BottomPMTHolderBottomPartThickness);
+  const G4double dBottomPMTHolderTopPartThickness = GetGeometryParameter(BottomPMTHolderTopPartThickness);
+  const G4double dBottomPMTBaseHolderThickness = GetGeometryParameter(BottomPMTBaseHolderThickness);
+  const G4double dTopBottomPMTToScreeningMesh = GetGeometryParameter(TopBottomPMTToScreeningMesh);
 
   //================================= Meshes Support ===============================	
   //---------------------------screen meshes + gate mesh + anode -------------------------------
@@ -1382,7 +1468,7 @@ void muensterTPCDetectorConstruction::ConstructFieldCage() {
 
   //================================= Meshes ===============================	
   //the actual grid - same for all
-	const G4double dGXeHalfZ = 0.5*GetGeometryParameter("GXeHeight");
+	const G4double dGXeHalfZ = 0.5*GetGeometryParameter(GXeHeight);
   //	const G4double dFirstGridMeshOffsetZ = (dLXeHalfZ+dAnodeToLiquidLevel+dScreeningMeshToAnode-0.5*dGridMeshThickness);
 
   G4Tubs *pGridMeshTubs = new G4Tubs("GridMeshTube", 0,dGridMeshRadius, 0.5*dGridMeshThickness, 0.*deg, 360.*deg);
@@ -1457,19 +1543,19 @@ pdGridMeshZ[1] = pdGridMeshZ[0]- dScreeningMeshToAnode+0.5*dGridMeshThickness;
 void muensterTPCDetectorConstruction::ConstructPmtArrays() {
   //G4cout << "----- ConstructPMTs" << G4endl;
   //<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<< pmt arrays >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-  const G4double dPmtWindowWidth = GetGeometryParameter("PmtWindowWidth");
-  const G4double dPmtWindowThickness = GetGeometryParameter("PmtWindowThickness");
+  const G4double dPmtWindowWidth = GetGeometryParameter(PmtWindowWidth);
+  const G4double dPmtWindowThickness = GetGeometryParameter(PmtWindowThickness);
 
-  const G4double dPmtCasingWidth = GetGeometryParameter("PmtCasingWidth");
-  const G4double dPmtCasingHeight = GetGeometryParameter("PmtCasingHeight");
-  const G4double dPmtCasingThickness = GetGeometryParameter("PmtCasingThickness");
+  const G4double dPmtCasingWidth = GetGeometryParameter(PmtCasingWidth);
+  const G4double dPmtCasingHeight = GetGeometryParameter(PmtCasingHeight);
+  const G4double dPmtCasingThickness = GetGeometryParameter(PmtCasingThickness);
 
-  const G4double dPmtPhotoCathodeWidth = GetGeometryParameter("PmtPhotoCathodeWidth");
-  const G4double dPmtPhotoCathodeThickness = GetGeometryParameter("PmtPhotoCathodeThickness");
+  const G4double dPmtPhotoCathodeWidth = GetGeometryParameter(PmtPhotoCathodeWidth);
+  const G4double dPmtPhotoCathodeThickness = GetGeometryParameter(PmtPhotoCathodeThickness);
 
-  const G4double dPmtBaseThickness = GetGeometryParameter("PmtBaseThickness");
+  const G4double dPmtBaseThickness = GetGeometryParameter(PmtBaseThickness);
 
-  const G4double dSpaceBelowTopPMTHeight= GetGeometryParameter("SpaceBelowTopPMTHeight");
+  const G4double dSpaceBelowTopPMTHeight= GetGeometryParameter(SpaceBelowTopPMTHeight);
 
   G4Material *Quartz = G4Material::GetMaterial("Quartz"); //for the window
   G4Material *SS304LSteel = G4Material::GetMaterial("SS304LSteel"); //for the frames
@@ -1535,91 +1621,88 @@ void muensterTPCDetectorConstruction::ConstructPmtArrays() {
 
   m_pSpaceBelowTopPMTLogicalVolume = new G4LogicalVolume(pSpaceBelowTopPMTBox, GXe, "SpaceBelowTopPMTLogicalVolume", 0, 0, 0);
 
-  //================================== top array ==================================
-  G4int iNbTopPmts = (G4int) GetGeometryParameter("NbTopPmts");
-	
-  stringstream hVolumeName;
-  for(G4int iPmtNb=0; iPmtNb<iNbTopPmts; iPmtNb++)
-    {
-      //G4cout << "----- TopPMT " << iPmtNb << " of " << iNbTopPmts-1 << G4endl;
-      hVolumeName.str(""); hVolumeName << "PmtWindowNo" << iPmtNb;
-      m_hPmtWindowPhysicalVolumes.push_back(new G4PVPlacement(GetPmtRotation(iPmtNb, PMT_WINDOW),
-							      GetPmtPosition(iPmtNb, PMT_WINDOW), 
-							      m_pPmtWindowLogicalVolume,
-							      hVolumeName.str(), 
-							      m_pPTFETopPMTHolderLogicalVolume,
-							      false, iPmtNb));
+  G4int iNbTopPmts = (G4int) GetGeometryParameter(NbTopPmts);
+  G4int iNbBottomPmts = (G4int) GetGeometryParameter(NbBottomPmts);
 
-      hVolumeName.str(""); hVolumeName << "PmtCasingNo" << iPmtNb;
-
-      m_hPmtCasingPhysicalVolumes.push_back(new G4PVPlacement(GetPmtRotation(iPmtNb, PMT_CASING),
-							      GetPmtPosition(iPmtNb, PMT_CASING), 
-							      m_pPmtCasingLogicalVolume,
-							      hVolumeName.str(), 
-							      m_pPTFETopPMTHolderLogicalVolume,
-							      false, iPmtNb));
-
-      hVolumeName.str(""); hVolumeName << "SpaceBelowTopPMTNo" << iPmtNb;
-
-      m_hSpaceBelowTopPMTPhysicalVolumes.push_back(new G4PVPlacement(GetPmtRotation(iPmtNb, PMT_SPACE),
-							      GetPmtPosition(iPmtNb, PMT_SPACE), 
-							      m_pSpaceBelowTopPMTLogicalVolume,
-							      hVolumeName.str(), 
-							      m_pPTFETopPMTHolderLogicalVolume, 
-							      false, iPmtNb));
-
-      hVolumeName.str(""); hVolumeName << "PmtBaseNo" << iPmtNb;
-
-      m_hPmtBasePhysicalVolumes.push_back(new G4PVPlacement(GetPmtRotation(iPmtNb, PMT_BASE),
-							    GetPmtPosition(iPmtNb, PMT_BASE), 
-							    m_pPmtBaseLogicalVolume, hVolumeName.str(),
-							    m_pPTFETopPMTHolderLogicalVolume, 
-							    false, iPmtNb));
-    }
-	
-  //================================ bottom array =================================
-  G4int iNbBottomPmts = (G4int) GetGeometryParameter("NbBottomPmts");
-
-  for(G4int iPmtNb=iNbTopPmts; iPmtNb<iNbTopPmts+iNbBottomPmts; iPmtNb++)
+  if(m_bParameterisedPmtArrays)
+    ConstructParameterisedPmtArrays();
+  else
     {
-      //G4cout << "----- BottomPMT " << iPmtNb << " of " << iNbTopPmts+iNbBottomPmts-1 << G4endl;
-      hVolumeName.str(""); hVolumeName << "PmtWindowNo" << iPmtNb;
-      m_hPmtWindowPhysicalVolumes.push_back(new G4PVPlacement(GetPmtRotation(iPmtNb, PMT_WINDOW),
-							      GetPmtPosition(iPmtNb, PMT_WINDOW), 
-							      m_pPmtWindowLogicalVolume,
-							      hVolumeName.str(), 
-							      m_pPTFEBottomPMTHolderLogicalVolume, 
-							      false, iPmtNb));
-
-      hVolumeName.str(""); hVolumeName << "PmtCasingNo" << iPmtNb;
-
-      m_hPmtCasingPhysicalVolumes.push_back(new G4PVPlacement(GetPmtRotation(iPmtNb, PMT_CASING),
-							      GetPmtPosition(iPmtNb, PMT_CASING), 
-							      m_pPmtCasingLogicalVolume,
-							      hVolumeName.str(),
-							      m_pPTFEBottomPMTHolderLogicalVolume, 
-							      false, iPmtNb));
-
-      hVolumeName.str(""); hVolumeName << "PmtBaseNo" << iPmtNb;
-
-      m_hPmtBasePhysicalVolumes.push_back(new G4PVPlacement(GetPmtRotation(iPmtNb, PMT_BASE),
-      							    GetPmtPosition(iPmtNb, PMT_BASE), 
-							    m_pPmtBaseLogicalVolume, hVolumeName.str(),
-      							    m_pPTFEBottomPMTHolderLogicalVolume, 
-							    false, iPmtNb));
-
-      // m_pLXeLogicalVolume,
-      //G4cout << hVolumeName.str() << G4endl;
+      stringstream hVolumeName;
+
+      //================================== top array ==================================
+      for(G4int iPmtNb=0; iPmtNb<iNbTopPmts; iPmtNb++)
+        {
+          //G4cout << "----- TopPMT " << iPmtNb << " of " << iNbTopPmts-1 << G4endl;
+          hVolumeName.str(""); hVolumeName << "PmtWindowNo" << iPmtNb;
+          m_hPmtWindowPhysicalVolumes.push_back(new G4PVPlacement(GetPmtRotation(iPmtNb, PMT_WINDOW),
+    							      GetPmtPosition(iPmtNb, PMT_WINDOW), 
+    							      m_pPmtWindowLogicalVolume,
+    							      hVolumeName.str(), 
+    							      m_pPTFETopPMTHolderLogicalVolume,
+    							      false, iPmtNb));
+
+          hVolumeName.str(""); hVolumeName << "PmtCasingNo" << iPmtNb;
+
+          m_hPmtCasingPhysicalVolumes.push_back(new G4PVPlacement(GetPmtRotation(iPmtNb, PMT_CASING),
+    							      GetPmtPosition(iPmtNb, PMT_CASING), 
+    							      m_pPmtCasingLogicalVolume,
+    							      hVolumeName.str(), 
+    							      m_pPTFETopPMTHolderLogicalVolume,
+    							      false, iPmtNb));
+
+          hVolumeName.str(""); hVolumeName << "SpaceBelowTopPMTNo" << iPmtNb;
+
+          m_hSpaceBelowTopPMTPhysicalVolumes.push_back(new G4PVPlacement(GetPmtRotation(iPmtNb, PMT_SPACE),
+    							      GetPmtPosition(iPmtNb, PMT_SPACE), 
+    							      m_pSpaceBelowTopPMTLogicalVolume,
+    							      hVolumeName.str(), 
+    							      m_pPTFETopPMTHolderLogicalVolume, 
+    							      false, iPmtNb));
+
+          hVolumeName.str(""); hVolumeName << "PmtBaseNo" << iPmtNb;
+
+          m_hPmtBasePhysicalVolumes.push_back(new G4PVPlacement(GetPmtRotation(iPmtNb, PMT_BASE),
+    							    GetPmtPosition(iPmtNb, PMT_BASE), 
+    							    m_pPmtBaseLogicalVolume, hVolumeName.str(),
+    							    m_pPTFETopPMTHolderLogicalVolume, 
+    							    false, iPmtNb));
+        }
+	
+      //================================ bottom array =================================
+      for(G4int iPmtNb=iNbTopPmts; iPmtNb<iNbTopPmts+iNbBottomPmts; iPmtNb++)
+        {
+          //G4cout << "----- BottomPMT " << iPmtNb << " of " << iNbTopPmts+iNbBottomPmts-1 << G4endl;
+          hVolumeName.str(""); hVolumeName << "PmtWindowNo" << iPmtNb;
+          m_hPmtWindowPhysicalVolumes.push_back(new G4PVPlacement(GetPmtRotation(iPmtNb, PMT_WINDOW),
+    							      GetPmtPosition(iPmtNb, PMT_WINDOW), 
+    							      m_pPmtWindowLogicalVolume,
+    							      hVolumeName.str(), 
+    							      m_pPTFEBottomPMTHolderLogicalVolume, 
+    							      false, iPmtNb));
+
+          hVolumeName.str(""); hVolumeName << "PmtCasingNo" << iPmtNb;
+
+          m_hPmtCasingPhysicalVolumes.push_back(new G4PVPlacement(GetPmtRotation(iPmtNb, PMT_CASING),
+    							      GetPmtPosition(iPmtNb, PMT_CASING), 
+    							      m_pPmtCasingLogicalVolume,
+    							      hVolumeName.str(),
+    							      m_pPTFEBottomPMTHolderLogicalVolume, 
+    							      false, iPmtNb));
+
+          hVolumeName.str(""); hVolumeName << "PmtBaseNo" << iPmtNb;
+
+          m_hPmtBasePhysicalVolumes.push_back(new G4PVPlacement(GetPmtRotation(iPmtNb, PMT_BASE),
+          							    GetPmtPosition(iPmtNb, PMT_BASE), 
+    							    m_pPmtBaseLogicalVolume, hVolumeName.str(),
+          							    m_pPTFEBottomPMTHolderLogicalVolume, 
+    							    false, iPmtNb));
+
+          // m_pLXeLogicalVolume,
+          //G4cout << hVolumeName.str() << G4endl;
+        }
     }
 
-  //------------------------------- pmt sensitivity -------------------------------
-  //G4cout << "----- PMT sensitivity " << G4endl;
-  G4SDManager *pSDManager = G4SDManager::GetSDMpointer();
-
-  muensterTPCPmtSensitiveDetector *pPmtSD = new muensterTPCPmtSensitiveDetector("muensterTPC/PmtSD");
-  pSDManager->AddNewDetector(pPmtSD);
-  m_pPmtPhotoCathodeLogicalVolume->SetSensitiveDetector(pPmtSD);
-
   //================================== optical surface =================================	
   //G4cout << "----- optical surface " << G4endl;
 	G4OpticalSurface *pSS304LSteelOpticalSurface = new G4OpticalSurface("SS304LSteelOpticalSurface",
@@ -1629,6 +1712,9 @@ void muensterTPCDetectorConstruction::ConstructPmtArrays() {
 	stringstream hStream;
 	for(G4int iPmtNb=iNbTopPmts; iPmtNb<iNbTopPmts+iNbBottomPmts; iPmtNb++)
 	{
+		// the pmts of a parameterised array share one casing
+		if(iPmtNb > iNbTopPmts && m_hPmtCasingPhysicalVolumes[iPmtNb] == m_hPmtCasingPhysicalVolumes[iPmtNb-1])
+			continue;
 		hStream.str("PmtCasingLogicalBorderSurfacePmt");
 		hStream << iPmtNb;
 		new G4LogicalBorderSurface(hStream.str(),
@@ -1638,6 +1724,8 @@ void muensterTPCDetectorConstruction::ConstructPmtArrays() {
 	stringstream hStream2;
 	for(G4int iPmtNb=0; iPmtNb<iNbTopPmts; iPmtNb++)
 	{
+		if(iPmtNb > 0 && m_hPmtCasingPhysicalVolumes[iPmtNb] == m_hPmtCasingPhysicalVolumes[iPmtNb-1])
+			continue;
 		hStream2.str("PmtCasingGXeLogicalBorderSurfacePmt");
 		hStream2 << iPmtNb;
 		new G4LogicalBorderSurface(hStream2.str(),
@@ -1677,13 +1765,157 @@ void muensterTPCDetectorConstruction::ConstructPmtArrays() {
   //G4cout << "----- ConstructPMTs -- END." << G4endl;
 }
 
+//******************************************************************/
+// ConstructParameterisedPmtArrays
+//******************************************************************/
+void muensterTPCDetectorConstruction::ConstructParameterisedPmtArrays() {
+  // every pmt (window, casing, base and the space below the top pmts) is
+  // put into a box of the holder material, the boxes are the only daughter
+  // of the holders and are placed by a parameterisation
+  const G4int iNbTopPmts = (G4int) GetGeometryParameter(NbTopPmts);
+  const G4int iNbBottomPmts = (G4int) GetGeometryParameter(NbBottomPmts);
+
+  const G4double dPmtUnitHalfX = 0.5*max(GetGeometryParameter(PmtCasingWidth), GetGeometryParameter(PmtWindowWidth));
+
+  for(G4int iArray=0; iArray<2; iArray++)
+    {
+      const G4bool bTopArray = (iArray == 0);
+      const G4int iFirstPmtNb = (bTopArray)?(0):(iNbTopPmts);
+      const G4int iNbPmts = (bTopArray)?(iNbTopPmts):(iNbBottomPmts);
+      const G4String hArrayName = (bTopArray)?("Top"):("Bottom");
+      G4LogicalVolume *pHolderLogicalVolume = (bTopArray)?(m_pPTFETopPMTHolderLogicalVolume):(m_pPTFEBottomPMTHolderLogicalVolume);
+
+      if(!iNbPmts)
+	continue;
+
+      vector<PmtPart> hParts;
+      vector<G4LogicalVolume *> hPartLogicalVolumes;
+      vector<G4String> hPartNames;
+      hParts.push_back(PMT_WINDOW); hPartLogicalVolumes.push_back(m_pPmtWindowLogicalVolume); hPartNames.push_back("PmtWindow");
+      hParts.push_back(PMT_CASING); hPartLogicalVolumes.push_back(m_pPmtCasingLogicalVolume); hPartNames.push_back("PmtCasing");
+      hParts.push_back(PMT_BASE); hPartLogicalVolumes.push_back(m_pPmtBaseLogicalVolume); hPartNames.push_back("PmtBase");
+      if(bTopArray)
+	{
+	  hParts.push_back(PMT_SPACE); hPartLogicalVolumes.push_back(m_pSpaceBelowTopPMTLogicalVolume); hPartNames.push_back("SpaceBelowTopPMT");
+	}
+
+      //--------------------------------- pmt unit ----------------------------------
+      // z range of all parts in the holder
+      G4double dUnitMinZ = DBL_MAX;
+      G4double dUnitMaxZ = -DBL_MAX;
+      for(G4int iPart=0; iPart<(G4int) hParts.size(); iPart++)
+	{
+	  const G4double dPartZ = GetPmtPosition(iFirstPmtNb, hParts[iPart]).z();
+	  const G4double dPartHalfZ = ((G4Box *) hPartLogicalVolumes[iPart]->GetSolid())->GetZHalfLength();
+	  dUnitMinZ = std::min(dUnitMinZ, dPartZ-dPartHalfZ);
+	  dUnitMaxZ = max(dUnitMaxZ, dPartZ+dPartHalfZ);
+	}
+
+      const G4double dPmtUnitHalfZ = 0.5*(dUnitMaxZ-dUnitMinZ);
+      const G4double dPmtUnitOffsetZ = 0.5*(dUnitMaxZ+dUnitMinZ);
+
+      G4Box *pPmtUnitBox = new G4Box(hArrayName+"PmtUnitBox", dPmtUnitHalfX, dPmtUnitHalfX, dPmtUnitHalfZ);
+
+      G4LogicalVolume *pPmtUnitLogicalVolume = new G4LogicalVolume(pPmtUnitBox, pHolderLogicalVolume->GetMaterial(),
+								   hArrayName+"PmtUnitLogicalVolume", 0, 0, 0);
+      pPmtUnitLogicalVolume->SetVisAttributes(G4VisAttributes::Invisible);
+
+      vector<G4VPhysicalVolume *> hPartPhysicalVolumes;
+      for(G4int iPart=0; iPart<(G4int) hParts.size(); iPart++)
+	{
+	  const G4double dPartZ = GetPmtPosition(iFirstPmtNb, hParts[iPart]).z();
+	  hPartPhysicalVolumes.push_back(new G4PVPlacement(GetPmtRotation(iFirstPmtNb, hParts[iPart]),
+							   G4ThreeVector(0., 0., dPartZ-dPmtUnitOffsetZ),
+							   hPartLogicalVolumes[iPart], hPartNames[iPart],
+							   pPmtUnitLogicalVolume, false, 0));
+	}
+
+      //--------------------------------- pmt array ---------------------------------
+      vector<G4ThreeVector> hPositions;
+      for(G4int iPmtNb=iFirstPmtNb; iPmtNb<iFirstPmtNb+iNbPmts; iPmtNb++)
+	{
+	  G4ThreeVector hPos = GetPmtPosition(iPmtNb, PMT_CASING);
+	  hPos.setZ(dPmtUnitOffsetZ);
+	  hPositions.push_back(hPos);
+	}
+
+      G4VPhysicalVolume *pPmtArrayPhysicalVolume =
+	new G4PVParameterised(hArrayName+"PmtArray", pPmtUnitLogicalVolume, pHolderLogicalVolume,
+			      kUndefined, iNbPmts, new muensterTPCPmtParameterisation(iFirstPmtNb, hPositions));
+
+      // the rim of the boxes around the pmts is holder material facing the
+      // xenon, it gets the teflon surface of the holder
+      if(bTopArray)
+	new G4LogicalBorderSurface("GXeTeflonTopPmtArrayLogicalBorderSurface",
+				   m_pGXePhysicalVolume, pPmtArrayPhysicalVolume, m_pGXeTeflonOpticalSurface);
+      else
+	new G4LogicalBorderSurface("LXeTeflonBottomPmtArrayLogicalBorderSurface",
+				   m_pLXePhysicalVolume, pPmtArrayPhysicalVolume, m_pTeflonOpticalSurface);
+
+      // all pmts of the array refer to the parts of the unit
+      for(G4int iPmtNb=iFirstPmtNb; iPmtNb<iFirstPmtNb+iNbPmts; iPmtNb++)
+	{
+	  m_hPmtWindowPhysicalVolumes.push_back(hPartPhysicalVolumes[0]);
+	  m_hPmtCasingPhysicalVolumes.push_back(hPartPhysicalVolumes[1]);
+	  m_hPmtBasePhysicalVolumes.push_back(hPartPhysicalVolumes[2]);
+	  if(bTopArray)
+	    m_hSpaceBelowTopPMTPhysicalVolumes.push_back(hPartPhysicalVolumes[3]);
+	}
+    }
+}
+
+//******************************************************************/
+// ConstructSensitiveDetectors
+//******************************************************************/
+void muensterTPCDetectorConstruction::ConstructSensitiveDetectors() {
+	//TackLimit for opticalphotons (see physics list)
+  G4double maxTrack = 100000;
+  fStepLimit = new G4UserLimits(DBL_MAX,maxTrack);
+  m_pLXeLogicalVolume->SetUserLimits(fStepLimit);
+
+  G4SDManager *pSDManager = G4SDManager::GetSDMpointer();
+
+  //------------------------------ xenon sensitivity ------------------------------
+  muensterTPCLXeSensitiveDetector *pLXeSD = new muensterTPCLXeSensitiveDetector("muensterTPC/LXeSD");
+  pSDManager->AddNewDetector(pLXeSD);
+  m_pLXeLogicalVolume->SetSensitiveDetector(pLXeSD);
+  m_pGXeLogicalVolume->SetSensitiveDetector(pLXeSD);
+
+  //------------------------------- pmt sensitivity -------------------------------
+  muensterTPCPmtSensitiveDetector *pPmtSD = new muensterTPCPmtSensitiveDetector("muensterTPC/PmtSD");
+  pSDManager->AddNewDetector(pPmtSD);
+  m_pPmtPhotoCathodeLogicalVolume->SetSensitiveDetector(pPmtSD);
+}
+
+//******************************************************************/
+// ConstructRegions
+//******************************************************************/
+void muensterTPCDetectorConstruction::ConstructRegions() {
+  // the production cuts of these regions are set in the physics list,
+  // everything that is not part of a region (lab) uses the default cuts
+
+  //================================ xenon region =================================
+  // LXe with all its daughters (GXe, PTFE, field cage, meshes and PMTs)
+  G4Region *pXenonRegion = G4RegionStore::GetInstance()->FindOrCreateRegion("XenonRegion");
+  pXenonRegion->AddRootLogicalVolume(m_pLXeLogicalVolume);
+
+  //=============================== cryostat region ===============================
+  // outer cryostat vessel, flanges and the insulation vacuum with the
+  // inner cryostat, the xenon region inside the vacuum keeps its own cuts
+  G4Region *pCryostatRegion = G4RegionStore::GetInstance()->FindOrCreateRegion("CryostatRegion");
+  pCryostatRegion->AddRootLogicalVolume(m_pOuterCryostatVesselLogicalVolume);
+  pCryostatRegion->AddRootLogicalVolume(m_pOuterCryostatBoreFlangeLogicalVolume);
+  pCryostatRegion->AddRootLogicalVolume(m_pOuterCryostatBlindFlangeLogicalVolume);
+  pCryostatRegion->AddRootLogicalVolume(m_pOuterCryostatVacuumLogicalVolume);
+}
+
 //******************************************************************/
 // GetPmtPosition
 //******************************************************************/
 G4ThreeVector muensterTPCDetectorConstruction::GetPmtPosition(G4int iPmtNb, PmtPart ePmtPart) {
 //iPmtNb is the pmt number so ranging from 0 to 6 in both top and bottom array, ePmtPart is the different cases found in GetPmtPositionTopArray i.e PMT_WINDOW, PMT_CASING etc etc...
-  const G4int iNbTopPmts = (G4int) GetGeometryParameter("NbTopPmts");
-  const G4int iNbBottomPmts = (G4int) GetGeometryParameter("NbBottomPmts");
+  const G4int iNbTopPmts = (G4int) GetGeometryParameter(NbTopPmts);
+  const G4int iNbBottomPmts = (G4int) GetGeometryParameter(NbBottomPmts);
 
   G4ThreeVector hPos;
 
@@ -1702,29 +1934,29 @@ G4ThreeVector
 muensterTPCDetectorConstruction::GetPmtPositionTopArray(G4int iPmtNb, PmtPart ePmtPart)
 {
 
-  const G4double dLXeLevelZeroOffset = GetGeometryParameter("LXeLevelZeroOffset");
+  const G4double dLXeLevelZeroOffset = GetGeometryParameter(LXeLevelZeroOffset);
 
   //<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<< top array >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-  const G4double dLXeHeight = GetGeometryParameter("LXeHeight");
+  const G4double dLXeHeight = GetGeometryParameter(LXeHeight);
 
-  const G4double dPmtWindowThickness = GetGeometryParameter("PmtWindowThickness");
-  const G4double dPmtCasingHeight = GetGeometryParameter("PmtCasingHeight");
-  const G4double dPmtBaseThickness = GetGeometryParameter("PmtBaseThickness");
+  const G4double dPmtWindowThickness = GetGeometryParameter(PmtWindowThickness);
+  const G4double dPmtCasingHeight = GetGeometryParameter(PmtCasingHeight);
+  const G4double dPmtBaseThickness = GetGeometryParameter(PmtBaseThickness);
 
-  const G4double dPmtToPmtBase= GetGeometryParameter("PmtToPmtBase");
-  const G4double dBottomTopPMTToScreeningMesh= GetGeometryParameter("BottomTopPMTToScreeningMesh");
+  const G4double dPmtToPmtBase= GetGeometryParameter(PmtToPmtBase);
+  const G4double dBottomTopPMTToScreeningMesh= GetGeometryParameter(BottomTopPMTToScreeningMesh);
  
-  const G4double dSpaceBelowTopPMTHeight= GetGeometryParameter("SpaceBelowTopPMTHeight");
+  const G4double dSpaceBelowTopPMTHeight= GetGeometryParameter(SpaceBelowTopPMTHeight);
 
-  const G4double dAnodeToLiquidLevel = GetGeometryParameter("AnodeToLiquidLevel");
-  const G4double dScreeningMeshToAnode = GetGeometryParameter("ScreeningMeshToAnode");
+  const G4double dAnodeToLiquidLevel = GetGeometryParameter(AnodeToLiquidLevel);
+  const G4double dScreeningMeshToAnode = GetGeometryParameter(ScreeningMeshToAnode);
   //	const G4double= GetGeometryParameter("");
   //	const G4double= GetGeometryParameter("");
 
   vector<G4int> hTopPmtsPerRow;
-  hTopPmtsPerRow.push_back((G4int) GetGeometryParameter("NbTopPmtsFirstRow"));
-  hTopPmtsPerRow.push_back((G4int) GetGeometryParameter("NbTopPmtsSecondRow"));
-  hTopPmtsPerRow.push_back((G4int) GetGeometryParameter("NbTopPmtsThirdRow"));
+  hTopPmtsPerRow.push_back((G4int) GetGeometryParameter(NbTopPmtsFirstRow));
+  hTopPmtsPerRow.push_back((G4int) GetGeometryParameter(NbTopPmtsSecondRow));
+  hTopPmtsPerRow.push_back((G4int) GetGeometryParameter(NbTopPmtsThirdRow));
 
   //================================ top array ================================-
   const G4double dLXeHalfZ = 0.5*dLXeHeight;
@@ -1743,7 +1975,7 @@ muensterTPCDetectorConstruction::GetPmtPositionTopArray(G4int iPmtNb, PmtPart eP
   //G4cout << "dTopPmtCasingOffsetZ: " << dTopPmtCasingOffsetZ<< G4endl;
   //G4cout << "dTopPmtWindowOffsetZ: " << dTopPmtWindowOffsetZ<< G4endl;
 
-  G4ThreeVector hPos = ComputeXYPmtPositionForGridPattern(iPmtNb, hTopPmtsPerRow);
+  G4ThreeVector hPos = (m_hTopPmtLayout.empty())?(ComputeXYPmtPositionForGridPattern(iPmtNb, hTopPmtsPerRow)):(m_hTopPmtLayout[iPmtNb]);
 
   switch(ePmtPart)
     {
@@ -1772,31 +2004,31 @@ muensterTPCDetectorConstruction::GetPmtPositionTopArray(G4int iPmtNb, PmtPart eP
 // GetPmtPositionBottomArray
 //******************************************************************/
 G4ThreeVector muensterTPCDetectorConstruction::GetPmtPositionBottomArray(G4int iPmtNb, PmtPart ePmtPart) {
-  //const G4double dLXeLevelZeroOffset =GetGeometryParameter("LXeLevelZeroOffset");
+  //const G4double dLXeLevelZeroOffset =GetGeometryParameter(LXeLevelZeroOffset);
 
   //<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<< bottom array >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-  const G4double dLXeHeight = GetGeometryParameter("LXeHeight");
+  const G4double dLXeHeight = GetGeometryParameter(LXeHeight);
 
-  const G4int iNbTopPmts = (G4int) GetGeometryParameter("NbTopPmts");
+  const G4int iNbTopPmts = (G4int) GetGeometryParameter(NbTopPmts);
 
-  const G4double dPmtWindowThickness = GetGeometryParameter("PmtWindowThickness");
-  const G4double dPmtCasingHeight = GetGeometryParameter("PmtCasingHeight");
-  const G4double dPmtBaseThickness = GetGeometryParameter("PmtBaseThickness");
-  const G4double dPmtPhotoCathodeThickness= GetGeometryParameter("PmtPhotoCathodeThickness");
+  const G4double dPmtWindowThickness = GetGeometryParameter(PmtWindowThickness);
+  const G4double dPmtCasingHeight = GetGeometryParameter(PmtCasingHeight);
+  const G4double dPmtBaseThickness = GetGeometryParameter(PmtBaseThickness);
+  const G4double dPmtPhotoCathodeThickness= GetGeometryParameter(PmtPhotoCathodeThickness);
   
-  const G4double dPmtToPmtBase= GetGeometryParameter("PmtToPmtBase");
+  const G4double dPmtToPmtBase= GetGeometryParameter(PmtToPmtBase);
   
-  const G4double dBottomPMTBaseHolderThickness= GetGeometryParameter("BottomPMTBaseHolderThickness");
-  const G4double dBottomPMTHolderTopPartThickness= GetGeometryParameter("BottomPMTHolderTopPartThickness");
-  const G4double dBottomPMTHolderBottomPartThickness= GetGeometryParameter("BottomPMTHolderBottomPartThickness");
-  const G4double dCryostatBottomDistanceBetweenLXeAndPTFE= GetGeometryParameter("CryostatBottomDistanceBetweenLXeAndPTFE");
+  const G4double dBottomPMTBaseHolderThickness= GetGeometryParameter(BottomPMTBaseHolderThickness);
+  const G4double dBottomPMTHolderTopPartThickness= GetGeometryParameter(BottomPMTHolderTopPartThickness);
+  const G4double dBottomPMTHolderBottomPartThickness= GetGeometryParameter(BottomPMTHolderBottomPartThickness);
+  const G4double dCryostatBottomDistanceBetweenLXeAndPTFE= GetGeometryParameter(CryostatBottomDistanceBetweenLXeAndPTFE);
 
   const G4double dPTFEBottomPMTHolderHalfZ = 0.5*(dBottomPMTHolderTopPartThickness+dBottomPMTHolderBottomPartThickness+dBottomPMTBaseHolderThickness);
 
   vector<G4int> hBottomPmtsPerRow;
-  hBottomPmtsPerRow.push_back((G4int) GetGeometryParameter("NbBottomPmtsFirstRow"));
-  hBottomPmtsPerRow.push_back((G4int) GetGeometryParameter("NbBottomPmtsSecondRow"));
-  hBottomPmtsPerRow.push_back((G4int) GetGeometryParameter("NbBottomPmtsThirdRow"));
+  hBottomPmtsPerRow.push_back((G4int) GetGeometryParameter(NbBottomPmtsFirstRow));
+  hBottomPmtsPerRow.push_back((G4int) GetGeometryParameter(NbBottomPmtsSecondRow));
+  hBottomPmtsPerRow.push_back((G4int) GetGeometryParameter(NbBottomPmtsThirdRow));
 
   //================================ bottom array ================================-
   const G4double dLXeHalfZ = 0.5*dLXeHeight;
@@ -1815,7 +2047,7 @@ G4ThreeVector muensterTPCDetectorConstruction::GetPmtPositionBottomArray(G4int i
   //G4cout << "dBottomPmtCasingOffsetZ: " << dBottomPmtCasingOffsetZ<< G4endl;
   //G4cout << "dBottomPmtWindowOffsetZ: " << dBottomPmtWindowOffsetZ<< G4endl;
 
-  G4ThreeVector hPos = ComputeXYPmtPositionForGridPattern(iPmtNb-iNbTopPmts, hBottomPmtsPerRow);
+  G4ThreeVector hPos = (m_hBottomPmtLayout.empty())?(ComputeXYPmtPositionForGridPattern(iPmtNb-iNbTopPmts, hBottomPmtsPerRow)):(m_hBottomPmtLayout[iPmtNb-iNbTopPmts]);
 
   switch(ePmtPart)
     {
@@ -1839,8 +2071,8 @@ G4ThreeVector muensterTPCDetectorConstruction::GetPmtPositionBottomArray(G4int i
 // GetPmtRotation
 //******************************************************************/
 G4RotationMatrix* muensterTPCDetectorConstruction::GetPmtRotation(G4int iPmtNb, PmtPart ePmtPart) {
-  const G4int iNbTopPmts = (G4int) GetGeometryParameter("NbTopPmts");
-  const G4int iNbBottomPmts = (G4int) GetGeometryParameter("NbBottomPmts");
+  const G4int iNbTopPmts = (G4int) GetGeometryParameter(NbTopPmts);
+  const G4int iNbBottomPmts = (G4int) GetGeometryParameter(NbBottomPmts);
 
 
   G4RotationMatrix *pRotationMatrix;
@@ -1857,8 +2089,8 @@ G4RotationMatrix* muensterTPCDetectorConstruction::GetPmtRotation(G4int iPmtNb,
 // ComputeXYPmtPositionForGridPattern
 //******************************************************************/
 G4ThreeVector muensterTPCDetectorConstruction::ComputeXYPmtPositionForGridPattern(G4int iPmtNb, const vector<G4int> &hPmtsPerRow) {
-  G4double dPmtWidth = muensterTPCDetectorConstruction::GetGeometryParameter("PmtWidth");
-  G4double dPmtSpacing = muensterTPCDetectorConstruction::GetGeometryParameter("PmtSpacing");
+  G4double dPmtWidth = muensterTPCDetectorConstruction::GetGeometryParameter(PmtWidth);
+  G4double dPmtSpacing = muensterTPCDetectorConstruction::GetGeometryParameter(PmtSpacing);
 
   G4int iRow = 0, iColumn;
   G4int iTotal = hPmtsPerRow[0];
@@ -1968,22 +2200,190 @@ void muensterTPCDetectorConstruction::SetLXeScintillation(G4bool bScintillation)
 //******************************************************************/
 // SetLXeLevel
 //******************************************************************/
-void muensterTPCDetectorConstruction::SetLXeLevel(G4double dlevel) {
-	G4cout << "----> Setting LXe(GXe) level to " << dlevel/cm << " cm" << G4endl;
-	G4cout << "----> default: 0 mm | no LXe: X mm | no GXe: -Y mm" << G4endl;
-	
- 	// Open geometry for the physical volume to be modified ...
- 	//G4GeometryManager::OpenGeometry(m_pGXePhysicalVolume);
- 
- 	// Modify dimension of the solid ...
- 	//m_pGXePhysicalVolume->GetLogicalVolume()->GetSolid()->SetXHalfLength(dlevel);
- 
- 	// Close geometry for the portion modified ...
- 	//G4GeometryManager::CloseGeometry(m_pGXePhysicalVolume);
-	
-	//m_pGXePhysicalVolume = new G4PVPlacement(0, G4ThreeVector(0., 0., dGXeOffsetZ),
-	//				   m_pGXeLogicalVolume, "GXe", m_pLXeLogicalVolume, false, 0);
+void muensterTPCDetectorConstruction::SetLXeLevel(G4double dLXeLevel) {
+  // the liquid level moves between gate and anode, the TPC stays in place
+  const G4double dGridMeshThickness = GetGeometryParameter(GridMeshThickness);
+  const G4double dMinLXeLevel = m_dLXeLevel-GetGeometryParameter(LiquidLevelToGateMesh);
+  const G4double dMaxLXeLevel = m_dLXeLevel+GetGeometryParameter(AnodeToLiquidLevel)-0.5*dGridMeshThickness;
 
+  if(dLXeLevel < dMinLXeLevel || dLXeLevel > dMaxLXeLevel)
+    {
+      G4cout << "--> warning from DetectorConstruction::SetLXeLevel : "
+	     << dLXeLevel/mm << " mm not between gate and anode ("
+	     << dMinLXeLevel/mm << " mm, " << dMaxLXeLevel/mm << " mm)" << G4endl;
+      return;
+    }
+
+  G4cout << "----> Setting LXe level to " << dLXeLevel/mm << " mm" << G4endl;
+  G4cout << "----> default: 0 mm | raised: > 0 mm | lowered: < 0 mm" << G4endl;
+
+  m_dLXeLevel = dLXeLevel;
+  DefineGeometryParameters();
+
+  if(G4StateManager::GetStateManager()->GetCurrentState() != G4State_Idle)
+    return;
+
+  // resize and move the GXe, its daughters keep their position w.r.t. the LXe
+  G4Tubs *pGXeTubs = (G4Tubs *) m_pGXeLogicalVolume->GetSolid();
+
+  const G4double dGXeHalfZ = 0.5*GetGeometryParameter(GXeHeight);
+  const G4double dDaughterShiftZ = dGXeHalfZ-pGXeTubs->GetZHalfLength();
+
+  pGXeTubs->SetZHalfLength(dGXeHalfZ);
+  m_pGXePhysicalVolume->SetTranslation(G4ThreeVector(0., 0., 0.5*GetGeometryParameter(LXeHeight)-dGXeHalfZ));
+
+  for(G4int i=0; i<m_pGXeLogicalVolume->GetNoDaughters(); i++)
+    {
+      G4VPhysicalVolume *pDaughter = m_pGXeLogicalVolume->GetDaughter(i);
+      pDaughter->SetTranslation(pDaughter->GetTranslation()+G4ThreeVector(0., 0., dDaughterShiftZ));
+    }
+
+  // meshes removed by the surface mesh model
+  for(G4int i=0; i<(G4int) m_hGridMeshPhysicalVolumes.size(); i++)
+    {
+      G4VPhysicalVolume *pMesh = m_hGridMeshPhysicalVolumes[i];
+      if(pMesh->GetMotherLogical() == m_pGXeLogicalVolume && !m_pGXeLogicalVolume->IsDaughter(pMesh))
+	pMesh->SetTranslation(pMesh->GetTranslation()+G4ThreeVector(0., 0., dDaughterShiftZ));
+    }
+
+  // LXe and GXe
+  ReoptimiseGeometry(m_pGXePhysicalVolume);
+  UpdateMeshPlanes();
+}
+
+//******************************************************************/
+// SetAnodeMeshOffset
+//******************************************************************/
+void muensterTPCDetectorConstruction::SetAnodeMeshOffset(G4double dOffset) {
+  // the anode mesh has to stay above the liquid and below the screening mesh
+  const G4double dMinOffset = m_dAnodeMeshOffset-GetGeometryParameter(AnodeToLiquidLevel)+0.5*GetGeometryParameter(GridMeshThickness);
+  const G4double dMaxOffset = m_dAnodeMeshOffset+GetGeometryParameter(ScreeningMeshToAnode)-2*GetGeometryParameter(GridMeshSupportThickness);
+
+  if(dOffset < dMinOffset || dOffset > dMaxOffset)
+    {
+      G4cout << "--> warning from DetectorConstruction::SetAnodeMeshOffset : "
+	     << dOffset/mm << " mm not between liquid level and screening mesh ("
+	     << dMinOffset/mm << " mm, " << dMaxOffset/mm << " mm)" << G4endl;
+      return;
+    }
+
+  G4cout << "----> Setting anode mesh offset to " << dOffset/mm << " mm" << G4endl;
+
+  const G4double dShiftZ = dOffset-m_dAnodeMeshOffset;
+
+  m_dAnodeMeshOffset = dOffset;
+  DefineGeometryParameters();
+
+  if(G4StateManager::GetStateManager()->GetCurrentState() != G4State_Idle)
+    return;
+
+  // mesh (in the GXe), border and support (in the LXe)
+  G4VPhysicalVolume *pAnodeMesh = m_hGridMeshPhysicalVolumes[1];
+  G4VPhysicalVolume *pAnodeMeshBorder = m_hGridMeshBorderPhysicalVolumes[1];
+  G4VPhysicalVolume *pAnodeMeshSupport = m_hGridMeshSupportPhysicalVolumes[1];
+
+  pAnodeMesh->SetTranslation(pAnodeMesh->GetTranslation()+G4ThreeVector(0., 0., dShiftZ));
+  pAnodeMeshBorder->SetTranslation(pAnodeMeshBorder->GetTranslation()+G4ThreeVector(0., 0., dShiftZ));
+  pAnodeMeshSupport->SetTranslation(pAnodeMeshSupport->GetTranslation()+G4ThreeVector(0., 0., dShiftZ));
+
+  ReoptimiseGeometry(pAnodeMesh);
+  ReoptimiseGeometry(pAnodeMeshBorder);
+  UpdateMeshPlanes();
+}
+
+//******************************************************************/
+// SetNbMountedTopPmts
+//******************************************************************/
+void muensterTPCDetectorConstruction::SetNbMountedTopPmts(G4int iNbPmts) {
+  const G4int iNbTopPmts = (G4int) GetGeometryParameter(NbTopPmts);
+
+  if(iNbPmts < 0 || iNbPmts > iNbTopPmts)
+    {
+      G4cout << "--> warning from DetectorConstruction::SetNbMountedTopPmts : "
+	     << iNbPmts << " not between 0 and " << iNbTopPmts << G4endl;
+      return;
+    }
+
+  G4cout << "----> Mounting " << iNbPmts << " of " << iNbTopPmts << " top PMTs" << G4endl;
+
+  m_iNbMountedTopPmts = iNbPmts;
+
+  if(G4StateManager::GetStateManager()->GetCurrentState() != G4State_Idle)
+    return;
+
+  // the casing still refers to the holder when it is unmounted
+  MountPmts();
+  ReoptimiseGeometry(m_hPmtCasingPhysicalVolumes[0]);
+}
+
+//******************************************************************/
+// SetNbMountedBottomPmts
+//******************************************************************/
+void muensterTPCDetectorConstruction::SetNbMountedBottomPmts(G4int iNbPmts) {
+  const G4int iNbBottomPmts = (G4int) GetGeometryParameter(NbBottomPmts);
+
+  if(iNbPmts < 0 || iNbPmts > iNbBottomPmts)
+    {
+      G4cout << "--> warning from DetectorConstruction::SetNbMountedBottomPmts : "
+	     << iNbPmts << " not between 0 and " << iNbBottomPmts << G4endl;
+      return;
+    }
+
+  G4cout << "----> Mounting " << iNbPmts << " of " << iNbBottomPmts << " bottom PMTs" << G4endl;
+
+  m_iNbMountedBottomPmts = iNbPmts;
+
+  if(G4StateManager::GetStateManager()->GetCurrentState() != G4State_Idle)
+    return;
+
+  MountPmts();
+  ReoptimiseGeometry(m_hPmtCasingPhysicalVolumes[(G4int) GetGeometryParameter(NbTopPmts)]);
+}
+
+//******************************************************************/
+// MountPmts
+//******************************************************************/
+void muensterTPCDetectorConstruction::MountPmts() {
+  // unmounted pmts are removed from their holder, the channel numbers are kept
+  const G4int iNbTopPmts = (G4int) GetGeometryParameter(NbTopPmts);
+  const G4int iNbBottomPmts = (G4int) GetGeometryParameter(NbBottomPmts);
+
+  // all pmts of a parameterised array are one volume
+  if(m_bParameterisedPmtArrays)
+    {
+      if(m_iNbMountedTopPmts != iNbTopPmts || m_iNbMountedBottomPmts != iNbBottomPmts)
+	G4cout << "--> warning from DetectorConstruction::MountPmts : "
+	       << "single PMTs cannot be unmounted from parameterised PMT arrays" << G4endl;
+      return;
+    }
+
+  for(G4int iPmtNb=0; iPmtNb<iNbTopPmts+iNbBottomPmts; iPmtNb++)
+    {
+      const G4bool bTopPmt = (iPmtNb < iNbTopPmts);
+      const G4bool bMount = (bTopPmt)?(iPmtNb < m_iNbMountedTopPmts):(iPmtNb-iNbTopPmts < m_iNbMountedBottomPmts);
+
+      if(bMount == m_hPmtMounted[iPmtNb])
+	continue;
+
+      vector<G4VPhysicalVolume *> hPmtParts;
+      hPmtParts.push_back(m_hPmtWindowPhysicalVolumes[iPmtNb]);
+      hPmtParts.push_back(m_hPmtCasingPhysicalVolumes[iPmtNb]);
+      hPmtParts.push_back(m_hPmtBasePhysicalVolumes[iPmtNb]);
+      if(bTopPmt)
+	hPmtParts.push_back(m_hSpaceBelowTopPMTPhysicalVolumes[iPmtNb]);
+
+      G4LogicalVolume *pHolderLogicalVolume = (bTopPmt)?(m_pPTFETopPMTHolderLogicalVolume):(m_pPTFEBottomPMTHolderLogicalVolume);
+
+      for(G4int iPart=0; iPart<(G4int) hPmtParts.size(); iPart++)
+	{
+	  if(bMount)
+	    pHolderLogicalVolume->AddDaughter(hPmtParts[iPart]);
+	  else
+	    pHolderLogicalVolume->RemoveDaughter(hPmtParts[iPart]);
+	}
+
+      m_hPmtMounted[iPmtNb] = bMount;
+    }
 }
 
 //******************************************************************/
@@ -1999,6 +2399,7 @@ void muensterTPCDetectorConstruction::SetLXeMeshMaterial(const G4String& name) {
   if(mat && mat != LXeMaterial) {
 		m_pGridMeshLXeLogicalVolume->SetMaterial(mat);
     UpdateGeometry();
+    UpdateMeshPlanes();
 		G4cout << "----> New LXeMesh material " << mat->GetName() << G4endl;
   }
 
@@ -2021,6 +2422,7 @@ void muensterTPCDetectorConstruction::SetGXeMeshMaterial(const G4String& name) {
   if(mat && mat != LXeMaterial) {
 		m_pGridMeshGXeLogicalVolume->SetMaterial(mat);
     UpdateGeometry();
+    UpdateMeshPlanes();
 		G4cout << "----> New GXeMesh material " << mat->GetName() << G4endl;
   }
 
@@ -2099,9 +2501,21 @@ void muensterTPCDetectorConstruction::SetLXeRayScatterLength(G4double dRayScatte
               
       G4double LXe_PP[] = {6.91*eV, 6.98*eV, 7.05*eV};
       G4double LXe_SCAT[] = {dRayScatterLength, dRayScatterLength, dRayScatterLength};
-      pLXePropertiesTable->RemoveProperty("RAYLEIGH");
-      pLXePropertiesTable->AddProperty("RAYLEIGH", LXe_PP, LXe_SCAT, 3);
- 
+
+      // the OpRayleigh table points to this vector, update it in place so that
+      // the new length is used between runs without rebuilding the physics tables
+      G4MaterialPropertyVector *pLXeRayleigh = pLXePropertiesTable->GetProperty("RAYLEIGH");
+      if(pLXeRayleigh && pLXeRayleigh->GetVectorLength() == 3)
+        {
+          for(G4int i=0; i<3; i++)
+            pLXeRayleigh->PutValue(i, LXe_SCAT[i]);
+        }
+      else
+        {
+          pLXePropertiesTable->RemoveProperty("RAYLEIGH");
+          pLXePropertiesTable->AddProperty("RAYLEIGH", LXe_PP, LXe_SCAT, 3);
+        }
+
     }
   else
     {
@@ -2118,7 +2532,7 @@ void muensterTPCDetectorConstruction::SetGXeMeshTransparency(G4double dTranspare
   if(pMeshMaterial)
     {
       G4cout << "----> Setting grid transparency to " << dTransparency*100 << " %" << G4endl;
-      G4double dAbsorptionLength =  ((G4double)GetGeometryParameter("GridMeshThickness"))/(-log(dTransparency)); 
+      G4double dAbsorptionLength =  ((G4double)GetGeometryParameter(GridMeshThickness))/(-log(dTransparency)); 
       G4MaterialPropertiesTable *pGateMeshPropertiesTable = pMeshMaterial->GetMaterialPropertiesTable();
       const G4int iNbEntries = 3;
       G4double pdMeshPhotonMomentum[iNbEntries] = {6.91*eV, 6.98*eV, 7.05*eV};
@@ -2140,7 +2554,7 @@ void muensterTPCDetectorConstruction::SetLXeMeshTransparency(G4double dTranspare
   if(pMeshMaterial)
     {
       G4cout << "----> Setting grid transparency to " << dTransparency*100 << " %" << G4endl;
-      G4double dAbsorptionLength =  ((G4double)GetGeometryParameter("GridMeshThickness"))/(-log(dTransparency)); 
+      G4double dAbsorptionLength =  ((G4double)GetGeometryParameter(GridMeshThickness))/(-log(dTransparency)); 
       G4MaterialPropertiesTable *pGateMeshPropertiesTable = pMeshMaterial->GetMaterialPropertiesTable();
       const G4int iNbEntries = 3;
       G4double pdMeshPhotonMomentum[iNbEntries] = {6.91*eV, 6.98*eV, 7.05*eV};
@@ -2228,6 +2642,104 @@ void muensterTPCDetectorConstruction::SetGXeTeflonReflectivity(G4double dGXeRefl
     }
 }
 
+//******************************************************************/
+// SetTeflonSurfaceModel
+//******************************************************************/
+void muensterTPCDetectorConstruction::SetTeflonSurfaceModel(const G4String &hModel) {
+  // unified:    ground surfaces with microfacets, sigma alpha and the
+  //             SPECULARLOBE/SPIKE/BACKSCATTER constants as constructed
+  // lambertian: reduced model without facet sampling, all reflected light
+  //             is diffuse (sigma alpha = 0, lobe/spike/backscatter = 0)
+  if(!m_pTeflonOpticalSurface || !m_pGXeTeflonOpticalSurface)
+    {
+      G4cout << "!!!!> Teflon optical surfaces not constructed yet!" << G4endl;
+      return;
+    }
+
+  if(hModel != "unified" && hModel != "lambertian")
+    {
+      G4cout << "--> warning from DetectorConstruction::SetTeflonSurfaceModel : "
+             << hModel << " not known" << G4endl;
+      return;
+    }
+
+  G4cout << "----> Setting Teflon surface model to " << hModel << G4endl;
+  m_hTeflonSurfaceModel = hModel;
+
+  const G4bool bUnified = (hModel == "unified");
+
+  m_pTeflonOpticalSurface->SetSigmaAlpha((bUnified)?(m_dTeflonSigmaAlpha):(0.));
+  m_pGXeTeflonOpticalSurface->SetSigmaAlpha((bUnified)?(m_dGXeTeflonSigmaAlpha):(0.));
+
+  const G4String hMaterials[] = {"Teflon", "GXeTeflon"};
+  const G4String hConstants[] = {"SPECULARLOBECONSTANT", "SPECULARSPIKECONSTANT", "BACKSCATTERCONSTANT"};
+  for(G4int i = 0; i < 2; i++)
+    {
+      G4MaterialPropertiesTable *pPropertiesTable = G4Material::GetMaterial(hMaterials[i])->GetMaterialPropertiesTable();
+
+      for(G4int j = 0; j < 3; j++)
+	{
+	  const G4String hKey = hMaterials[i] + "/" + hConstants[j];
+	  pPropertiesTable->RemoveProperty(hConstants[j]);
+
+	  if(bUnified)
+	    {
+	      // constants which were not defined stay undefined
+	      vector<G4double> &hEnergies = m_hTeflonSurfaceEnergies[hKey];
+	      vector<G4double> &hConstant = m_hTeflonSurfaceConstants[hKey];
+	      if(!hEnergies.empty())
+		pPropertiesTable->AddProperty(hConstants[j], &hEnergies[0], &hConstant[0], (G4int) hEnergies.size());
+	    }
+	  else
+	    {
+	      G4double pdPhotonMomentum[] = { 6.91 * eV, 6.98 * eV, 7.05 * eV };
+	      G4double pdConstant[] = {0., 0., 0.};
+	      pPropertiesTable->AddProperty(hConstants[j], pdPhotonMomentum, pdConstant, 3);
+	    }
+	}
+    }
+}
+
+//******************************************************************/
+// SaveTeflonSurfaceModel
+//******************************************************************/
+void muensterTPCDetectorConstruction::SaveTeflonSurfaceModel() {
+  // the surfaces are saved with the unified model, switching back to it
+  // restores sigma alpha and the constants of the materials
+  if(m_hTeflonSurfaceModel != "unified")
+    return;
+
+  m_dTeflonSigmaAlpha = m_pTeflonOpticalSurface->GetSigmaAlpha();
+  m_dGXeTeflonSigmaAlpha = m_pGXeTeflonOpticalSurface->GetSigmaAlpha();
+
+  m_hTeflonSurfaceEnergies.clear();
+  m_hTeflonSurfaceConstants.clear();
+
+  const G4String hMaterials[] = {"Teflon", "GXeTeflon"};
+  const G4String hConstants[] = {"SPECULARLOBECONSTANT", "SPECULARSPIKECONSTANT", "BACKSCATTERCONSTANT"};
+  for(G4int i = 0; i < 2; i++)
+    {
+      G4Material *pMaterial = G4Material::GetMaterial(hMaterials[i], false);
+      G4MaterialPropertiesTable *pPropertiesTable = (pMaterial)?(pMaterial->GetMaterialPropertiesTable()):(0);
+      if(!pPropertiesTable)
+	continue;
+
+      for(G4int j = 0; j < 3; j++)
+	{
+	  G4MaterialPropertyVector *pConstant = pPropertiesTable->GetProperty(hConstants[j]);
+	  if(!pConstant)
+	    continue;
+
+	  const G4String hKey = hMaterials[i] + "/" + hConstants[j];
+	  for(size_t k = 0; k < pConstant->GetVectorLength(); k++)
+	    {
+	      m_hTeflonSurfaceEnergies[hKey].push_back(pConstant->Energy(k));
+	      m_hTeflonSurfaceConstants[hKey].push_back((*pConstant)[k]);
+	    }
+	}
+    }
+}
+
 //******************************************************************/
 // UpdateGeometry
 //******************************************************************/
@@ -2235,4 +2747,614 @@ void muensterTPCDetectorConstruction::UpdateGeometry() {
   G4RunManager::GetRunManager()->GeometryHasBeenModified();
 }
 
+//******************************************************************/
+// ReoptimiseGeometry
+//******************************************************************/
+void muensterTPCDetectorConstruction::ReoptimiseGeometry(G4VPhysicalVolume *pPhysicalVolume) {
+  // rebuilds the voxels of the mother of the modified volume and of the
+  // volume itself, the optimisation of all other volumes is kept
+  G4GeometryManager *pGeometryManager = G4GeometryManager::GetInstance();
+
+  pGeometryManager->OpenGeometry(pPhysicalVolume);
+  pGeometryManager->CloseGeometry(true, false, pPhysicalVolume);
+}
+
+//******************************************************************/
+// SetGdmlCache
+//******************************************************************/
+void muensterTPCDetectorConstruction::SetGdmlCache(const G4String &hFilename) {
+#ifdef G4LIB_USE_GDML
+  G4cout << "----> Using GDML geometry cache " << hFilename << G4endl;
+  m_hGdmlCacheFilename = hFilename;
+#else
+  G4cout << "--> warning from DetectorConstruction::SetGdmlCache : "
+	 << "Geant4 was built without GDML, " << hFilename << " is not used" << G4endl;
+#endif
+}
+
+//******************************************************************/
+// GetGeometryHash
+//******************************************************************/
+G4String muensterTPCDetectorConstruction::GetGeometryHash() {
+  // FNV-1a over all geometry parameters, the Geant4 version and the
+  // build of this file (changes of the construction code)
+  std::stringstream hInput;
+  hInput << std::setprecision(17);
+  for(G4int i=0; i<NbGeometryParameters; i++)
+    hInput << m_hGeometryParameters.m_pdValues[i] << ";";
+  for(size_t i=0; i<m_hTopPmtLayout.size(); i++)
+    hInput << m_hTopPmtLayout[i].x() << "," << m_hTopPmtLayout[i].y() << ";";
+  for(size_t i=0; i<m_hBottomPmtLayout.size(); i++)
+    hInput << m_hBottomPmtLayout[i].x() << "," << m_hBottomPmtLayout[i].y() << ";";
+  hInput << G4Version << ";" << __DATE__ << " " << __TIME__;
+
+  const std::string hBytes = hInput.str();
+  unsigned long long lHash = 14695981039346656037ULL;
+  for(size_t i=0; i<hBytes.size(); i++)
+    {
+      lHash ^= (unsigned char) hBytes[i];
+      lHash *= 1099511628211ULL;
+    }
+
+  std::stringstream hHash;
+  hHash << std::hex << std::setw(16) << std::setfill('0') << lHash;
+
+  return hHash.str();
+}
+
+//******************************************************************/
+// ExportGdml
+//******************************************************************/
+void muensterTPCDetectorConstruction::ExportGdml(const G4String &hFilename, G4bool bWriteHash) {
+#ifdef G4LIB_USE_GDML
+  G4cout << "----> Writing geometry to " << hFilename << G4endl;
+
+  // the parser refuses to overwrite existing files
+  std::remove(hFilename.c_str());
+
+  // materials (incl. optical properties), solids, volumes and surfaces
+  G4GDMLParser hParser;
+  hParser.Write(hFilename, m_pLabPhysicalVolume, true);
+
+  if(bWriteHash)
+    {
+      std::ofstream hHashFile((hFilename + ".hash").c_str());
+      hHashFile << GetGeometryHash() << std::endl;
+    }
+#else
+  G4cout << "--> warning from DetectorConstruction::ExportGdml : "
+	 << "Geant4 was built without GDML, " << hFilename << " is not written" << G4endl;
+#endif
+}
+
+//******************************************************************/
+// ImportGdml
+//******************************************************************/
+G4bool muensterTPCDetectorConstruction::ImportGdml(const G4String &hFilename) {
+#ifdef G4LIB_USE_GDML
+  std::ifstream hHashFile((hFilename + ".hash").c_str());
+  std::string hCachedHash;
+  if(!(hHashFile >> hCachedHash) || hCachedHash != GetGeometryHash())
+    {
+      G4cout << "----> Geometry changed or not cached, building it from scratch" << G4endl;
+      return false;
+    }
+
+  G4cout << "----> Reading cached geometry from " << hFilename << G4endl;
+
+  G4GDMLParser hParser;
+  hParser.Read(hFilename, false);
+
+  // surface names are not stripped by the parser
+  const G4SurfacePropertyTable *pSurfaceTable = G4SurfaceProperty::GetSurfacePropertyTable();
+  for(size_t i=0; i<pSurfaceTable->size(); i++)
+    {
+      G4SurfaceProperty *pSurface = (*pSurfaceTable)[i];
+      const G4String hName = pSurface->GetName();
+      if(hName.find("0x") != std::string::npos)
+	pSurface->SetName(hName.substr(0, hName.find("0x")));
+    }
+
+  LXeMaterial = G4Material::GetMaterial("LXe", false);
+
+  // volumes which are modified after the construction
+  G4LogicalVolumeStore *pLogicalVolumeStore = G4LogicalVolumeStore::GetInstance();
+
+  m_pLabPhysicalVolume = hParser.GetWorldVolume();
+
+  m_pLXeLogicalVolume = pLogicalVolumeStore->GetVolume("LXeVolume");
+  m_pGXeLogicalVolume = pLogicalVolumeStore->GetVolume("GXeLogicalVolume");
+  m_pGridMeshLXeLogicalVolume = pLogicalVolumeStore->GetVolume("LXeGridMeshLogicalVolume");
+  m_pGridMeshGXeLogicalVolume = pLogicalVolumeStore->GetVolume("GXeGridMeshLogicalVolume");
+  m_pPTFETopPMTHolderLogicalVolume = pLogicalVolumeStore->GetVolume("PTFETopPMTHolderLogicalVolume");
+  m_pPTFEBottomPMTHolderLogicalVolume = pLogicalVolumeStore->GetVolume("PTFEBottomPMTHolderLogicalVolume");
+  m_pPmtPhotoCathodeLogicalVolume = pLogicalVolumeStore->GetVolume("PmtPhotoCathodeLogicalVolume");
+  m_pOuterCryostatVesselLogicalVolume = pLogicalVolumeStore->GetVolume("OuterCryostatVesselLogicalVolume");
+  m_pOuterCryostatBoreFlangeLogicalVolume = pLogicalVolumeStore->GetVolume("OuterCryostatBoreFlangeLogicalVolume");
+  m_pOuterCryostatBlindFlangeLogicalVolume = pLogicalVolumeStore->GetVolume("OuterCryostatBlindFlangeLogicalVolume");
+  m_pOuterCryostatVacuumLogicalVolume = pLogicalVolumeStore->GetVolume("OuterCryostatVacuumLogicalVolume");
+
+  m_pOuterCryostatVesselPhysicalVolume = FindPhysicalVolume("OuterCryostatVessel", 0);
+  m_pOuterCryostatVacuumPhysicalVolume = FindPhysicalVolume("OuterCryostatVacuum", 0);
+  m_pLXePhysicalVolume = FindPhysicalVolume("LXe", 0);
+  m_pGXePhysicalVolume = FindPhysicalVolume("GXe", 0);
+
+  const G4int iNbGridMeshes = (G4int) GetGeometryParameter(GridMeshNumber);
+  const G4int iNbGridMeshSupports = (G4int) GetGeometryParameter(GridMeshSupportNumber);
+
+  m_hGridMeshPhysicalVolumes.clear();
+  m_hGridMeshBorderPhysicalVolumes.clear();
+  for(G4int i=0; i<iNbGridMeshes; i++)
+    {
+      m_hGridMeshPhysicalVolumes.push_back(FindPhysicalVolume((i<2)?("GXeGridMesh"):("LXeGridMesh"), i));
+      m_hGridMeshBorderPhysicalVolumes.push_back(FindPhysicalVolume("GridMeshBorder", i));
+    }
+
+  m_hGridMeshSupportPhysicalVolumes.clear();
+  for(G4int i=0; i<iNbGridMeshSupports; i++)
+    m_hGridMeshSupportPhysicalVolumes.push_back(FindPhysicalVolume("GridMeshSupport", i));
+
+  const G4int iNbTopPmts = (G4int) GetGeometryParameter(NbTopPmts);
+  const G4int iNbBottomPmts = (G4int) GetGeometryParameter(NbBottomPmts);
+
+  m_hPmtWindowPhysicalVolumes.clear();
+  m_hPmtCasingPhysicalVolumes.clear();
+  m_hPmtBasePhysicalVolumes.clear();
+  m_hSpaceBelowTopPMTPhysicalVolumes.clear();
+
+  stringstream hVolumeName;
+  for(G4int iPmtNb=0; iPmtNb<iNbTopPmts+iNbBottomPmts; iPmtNb++)
+    {
+      hVolumeName.str(""); hVolumeName << "PmtWindowNo" << iPmtNb;
+      m_hPmtWindowPhysicalVolumes.push_back(FindPhysicalVolume(hVolumeName.str(), iPmtNb));
+      hVolumeName.str(""); hVolumeName << "PmtCasingNo" << iPmtNb;
+      m_hPmtCasingPhysicalVolumes.push_back(FindPhysicalVolume(hVolumeName.str(), iPmtNb));
+      hVolumeName.str(""); hVolumeName << "PmtBaseNo" << iPmtNb;
+      m_hPmtBasePhysicalVolumes.push_back(FindPhysicalVolume(hVolumeName.str(), iPmtNb));
+      if(iPmtNb < iNbTopPmts)
+	{
+	  hVolumeName.str(""); hVolumeName << "SpaceBelowTopPMTNo" << iPmtNb;
+	  m_hSpaceBelowTopPMTPhysicalVolumes.push_back(FindPhysicalVolume(hVolumeName.str(), iPmtNb));
+	}
+    }
+
+  m_pTeflonOpticalSurface = dynamic_cast<G4OpticalSurface *>(G4SurfaceProperty::GetSurfaceProperty("TeflonOpticalSurface"));
+  m_pGXeTeflonOpticalSurface = dynamic_cast<G4OpticalSurface *>(G4SurfaceProperty::GetSurfaceProperty("GXeTeflonOpticalSurface"));
+  if(m_pTeflonOpticalSurface && m_pGXeTeflonOpticalSurface)
+    SaveTeflonSurfaceModel();
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+//******************************************************************/
+// FindPhysicalVolume
+//******************************************************************/
+G4VPhysicalVolume *muensterTPCDetectorConstruction::FindPhysicalVolume(const G4String &hName, G4int iCopyNb) {
+  G4PhysicalVolumeStore *pPhysicalVolumeStore = G4PhysicalVolumeStore::GetInstance();
+
+  for(size_t i=0; i<pPhysicalVolumeStore->size(); i++)
+    {
+      G4VPhysicalVolume *pPhysicalVolume = (*pPhysicalVolumeStore)[i];
+      if(pPhysicalVolume->GetName() == hName && pPhysicalVolume->GetCopyNo() == iCopyNb)
+	return pPhysicalVolume;
+    }
+
+  G4cout << "!!!!> " << hName << " (" << iCopyNb << ") not found in the GDML geometry!" << G4endl;
+  exit(-1);
+}
+
+//******************************************************************/
+// AuditGeometry
+//******************************************************************/
+void muensterTPCDetectorConstruction::AuditGeometry(G4int iNbPoints) {
+  G4PhysicalVolumeStore *pPhysicalVolumeStore = G4PhysicalVolumeStore::GetInstance();
+
+  //================================== overlaps ===================================
+  G4cout << "----> Checking overlaps of " << pPhysicalVolumeStore->size() << " placements" << G4endl;
+
+  G4int iNbOverlaps = 0;
+  for(size_t i=0; i<pPhysicalVolumeStore->size(); i++)
+    {
+      G4VPhysicalVolume *pPhysicalVolume = (*pPhysicalVolumeStore)[i];
+      if(pPhysicalVolume->GetMotherLogical() && pPhysicalVolume->CheckOverlaps(1000, 0., false))
+	{
+	  G4cout << "--> warning from DetectorConstruction::AuditGeometry : "
+		 << pPhysicalVolume->GetName() << " (" << pPhysicalVolume->GetCopyNo() << ") overlaps" << G4endl;
+	  iNbOverlaps++;
+	}
+    }
+
+  //================================= navigation ==================================
+  // random points in the bounding box of the outer cryostat, sorted by the
+  // logical volume they are located in, then the navigation is timed per volume
+  G4Navigator *pNavigator = new G4Navigator();
+  pNavigator->SetWorldVolume(m_pLabPhysicalVolume);
+
+  const G4VisExtent hExtent = m_pOuterCryostatVesselPhysicalVolume->GetLogicalVolume()->GetSolid()->GetExtent();
+  const G4ThreeVector hOffset = m_pOuterCryostatVesselPhysicalVolume->GetTranslation();
+
+  map<G4LogicalVolume *, vector<G4ThreeVector> > hPoints;
+  for(G4int i=0; i<iNbPoints; i++)
+    {
+      G4ThreeVector hPoint(hExtent.GetXmin() + G4UniformRand()*(hExtent.GetXmax()-hExtent.GetXmin()),
+			   hExtent.GetYmin() + G4UniformRand()*(hExtent.GetYmax()-hExtent.GetYmin()),
+			   hExtent.GetZmin() + G4UniformRand()*(hExtent.GetZmax()-hExtent.GetZmin()));
+      hPoint += hOffset;
+
+      G4VPhysicalVolume *pPhysicalVolume = pNavigator->LocateGlobalPointAndSetup(hPoint, 0, false, true);
+      if(pPhysicalVolume)
+	hPoints[pPhysicalVolume->GetLogicalVolume()].push_back(hPoint);
+    }
+
+  G4cout << "----> Navigation timing with " << iNbPoints << " random points" << G4endl;
+  G4cout << std::setw(40) << std::left << "logical volume" << std::right
+	 << std::setw(10) << "points" << std::setw(10) << "daughters" << std::setw(10) << "smartless"
+	 << std::setw(8) << "voxels" << std::setw(14) << "locate [us]" << std::setw(14) << "step [us]" << G4endl;
+
+  G4Timer hTimer;
+  G4double dSafety = 0.;
+  for(map<G4LogicalVolume *, vector<G4ThreeVector> >::iterator pIt = hPoints.begin(); pIt != hPoints.end(); ++pIt)
+    {
+      G4LogicalVolume *pLogicalVolume = pIt->first;
+      const vector<G4ThreeVector> &hVolumePoints = pIt->second;
+      const G4int iNbVolumePoints = hVolumePoints.size();
+
+      vector<G4ThreeVector> hDirections(iNbVolumePoints);
+      for(G4int i=0; i<iNbVolumePoints; i++)
+	hDirections[i] = G4RandomDirection();
+
+      hTimer.Start();
+      for(G4int i=0; i<iNbVolumePoints; i++)
+	pNavigator->LocateGlobalPointAndSetup(hVolumePoints[i], 0, false, true);
+      hTimer.Stop();
+      const G4double dLocateTime = hTimer.GetUserElapsed();
+
+      // compute step needs a located point, the locate time is subtracted
+      hTimer.Start();
+      for(G4int i=0; i<iNbVolumePoints; i++)
+	{
+	  pNavigator->LocateGlobalPointAndSetup(hVolumePoints[i], &hDirections[i], false, true);
+	  pNavigator->ComputeStep(hVolumePoints[i], hDirections[i], kInfinity, dSafety);
+	}
+      hTimer.Stop();
+      const G4double dStepTime = max(hTimer.GetUserElapsed() - dLocateTime, 0.);
+
+      G4cout << std::setw(40) << std::left << pLogicalVolume->GetName() << std::right
+	     << std::setw(10) << iNbVolumePoints
+	     << std::setw(10) << pLogicalVolume->GetNoDaughters()
+	     << std::setw(10) << pLogicalVolume->GetSmartless()
+	     << std::setw(8) << ((pLogicalVolume->GetVoxelHeader())?("yes"):("no"))
+	     << std::setw(14) << 1e6*dLocateTime/iNbVolumePoints
+	     << std::setw(14) << 1e6*dStepTime/iNbVolumePoints << G4endl;
+    }
+
+  delete pNavigator;
+
+  G4cout << "----> " << iNbOverlaps << " overlapping placements found" << G4endl;
+}
+
+//******************************************************************/
+// SetPmtPlacement
+//******************************************************************/
+void muensterTPCDetectorConstruction::SetPmtPlacement(const G4String &hPlacement) {
+  // placement:     one G4PVPlacement per pmt part (default)
+  // parameterised: one G4PVParameterised pmt unit per array
+  if(hPlacement != "placement" && hPlacement != "parameterised")
+    {
+      G4cout << "--> warning from DetectorConstruction::SetPmtPlacement : "
+	     << hPlacement << " not known" << G4endl;
+      return;
+    }
+
+  G4cout << "----> Setting PMT placement to " << hPlacement << G4endl;
+  m_bParameterisedPmtArrays = (hPlacement == "parameterised");
+}
+
+//******************************************************************/
+// SetPmtLayout
+//******************************************************************/
+void muensterTPCDetectorConstruction::SetPmtLayout(const G4String &hFilename) {
+  // one pmt per line: top|bottom, x [mm], y [mm], the order of the
+  // lines gives the pmt numbers (top array first), # starts a comment
+  std::ifstream hFile(hFilename.c_str());
+  if(!hFile)
+    {
+      G4cout << "--> warning from DetectorConstruction::SetPmtLayout : "
+	     << hFilename << " not found, the default layout is kept" << G4endl;
+      return;
+    }
+
+  vector<G4ThreeVector> hTopPmtLayout, hBottomPmtLayout;
+
+  std::string hLine;
+  G4int iLineNb = 0;
+  while(std::getline(hFile, hLine))
+    {
+      iLineNb++;
+
+      if(hLine.find('#') != std::string::npos)
+	hLine.erase(hLine.find('#'));
+      std::replace(hLine.begin(), hLine.end(), ',', ' ');
+
+      std::istringstream hStream(hLine);
+      std::string hArray;
+      G4double dX, dY;
 
+      if(!(hStream >> hArray))
+	continue;
+
+      if(!(hStream >> dX >> dY) || (hArray != "top" && hArray != "bottom"))
+	{
+	  G4cout << "--> warning from DetectorConstruction::SetPmtLayout : "
+		 << hFilename << ":" << iLineNb << " not understood, the default layout is kept" << G4endl;
+	  return;
+	}
+
+      if(hArray == "top")
+	hTopPmtLayout.push_back(G4ThreeVector(dX*mm, dY*mm, 0.));
+      else
+	hBottomPmtLayout.push_back(G4ThreeVector(dX*mm, dY*mm, 0.));
+    }
+
+  // the pmts are squares of the same orientation, they must not overlap
+  const G4double dPmtWidth = max(GetGeometryParameter(PmtCasingWidth), GetGeometryParameter(PmtWindowWidth));
+  for(G4int iArray=0; iArray<2; iArray++)
+    {
+      const vector<G4ThreeVector> &hLayout = (iArray == 0)?(hTopPmtLayout):(hBottomPmtLayout);
+      const G4int iFirstPmtNb = (iArray == 0)?(0):((G4int) hTopPmtLayout.size());
+
+      for(size_t i=0; i<hLayout.size(); i++)
+	for(size_t j=i+1; j<hLayout.size(); j++)
+	  if(std::fabs(hLayout[i].x()-hLayout[j].x()) < dPmtWidth && std::fabs(hLayout[i].y()-hLayout[j].y()) < dPmtWidth)
+	    {
+	      G4cout << "--> warning from DetectorConstruction::SetPmtLayout : "
+		     << "PMTs " << iFirstPmtNb+i << " and " << iFirstPmtNb+j
+		     << " overlap, the default layout is kept" << G4endl;
+	      return;
+	    }
+    }
+
+  // the whole pmt has to be inside the holders, its outermost corner
+  // decides, layouts with pmts sticking out of a holder are rejected
+  const G4double dTopHolderRadius = GetGeometryParameter(TopPMTHolderPlateRadius);
+  const G4double dBottomHolderRadius = GetGeometryParameter(TeflonOuterCylinderOuterRadius);
+  for(G4int iArray=0; iArray<2; iArray++)
+    {
+      const vector<G4ThreeVector> &hLayout = (iArray == 0)?(hTopPmtLayout):(hBottomPmtLayout);
+      const G4int iFirstPmtNb = (iArray == 0)?(0):((G4int) hTopPmtLayout.size());
+      const G4double dHolderRadius = (iArray == 0)?(dTopHolderRadius):(dBottomHolderRadius);
+
+      for(size_t i=0; i<hLayout.size(); i++)
+	{
+	  const G4double dCornerX = std::fabs(hLayout[i].x())+0.5*dPmtWidth;
+	  const G4double dCornerY = std::fabs(hLayout[i].y())+0.5*dPmtWidth;
+	  if(std::sqrt(dCornerX*dCornerX+dCornerY*dCornerY) > dHolderRadius)
+	    {
+	      G4cout << "--> warning from DetectorConstruction::SetPmtLayout : "
+		     << "PMT " << iFirstPmtNb+i << " is not inside the holder (radius " << dHolderRadius/mm
+		     << " mm), the default layout is kept" << G4endl;
+	      return;
+	    }
+	}
+    }
+
+  G4cout << "----> Setting PMT layout from " << hFilename << ": "
+	 << hTopPmtLayout.size() << " top, " << hBottomPmtLayout.size() << " bottom PMTs" << G4endl;
+
+  m_hTopPmtLayout = hTopPmtLayout;
+  m_hBottomPmtLayout = hBottomPmtLayout;
+
+  const G4int iPreviousNbTopPmts = (G4int) GetGeometryParameter(NbTopPmts);
+  const G4int iPreviousNbBottomPmts = (G4int) GetGeometryParameter(NbBottomPmts);
+
+  DefineGeometryParameters();
+
+  const G4int iNbTopPmts = (G4int) GetGeometryParameter(NbTopPmts);
+  const G4int iNbBottomPmts = (G4int) GetGeometryParameter(NbBottomPmts);
+
+  // full arrays follow the table, numbers set with setNbTopPmts/setNbBottomPmts are kept
+  if(m_iNbMountedTopPmts == iPreviousNbTopPmts || m_iNbMountedTopPmts > iNbTopPmts)
+    {
+      if(m_iNbMountedTopPmts != iPreviousNbTopPmts)
+	G4cout << "--> warning from DetectorConstruction::SetPmtLayout : "
+	       << m_iNbMountedTopPmts << " mounted top PMTs reduced to " << iNbTopPmts << G4endl;
+      m_iNbMountedTopPmts = iNbTopPmts;
+    }
+  if(m_iNbMountedBottomPmts == iPreviousNbBottomPmts || m_iNbMountedBottomPmts > iNbBottomPmts)
+    {
+      if(m_iNbMountedBottomPmts != iPreviousNbBottomPmts)
+	G4cout << "--> warning from DetectorConstruction::SetPmtLayout : "
+	       << m_iNbMountedBottomPmts << " mounted bottom PMTs reduced to " << iNbBottomPmts << G4endl;
+      m_iNbMountedBottomPmts = iNbBottomPmts;
+    }
+}
+
+//******************************************************************/
+// SetSmartless
+//******************************************************************/
+void muensterTPCDetectorConstruction::SetSmartless(const G4String &hVolumeName, G4double dSmartless) {
+  G4LogicalVolume *pLogicalVolume = G4LogicalVolumeStore::GetInstance()->GetVolume(hVolumeName, false);
+
+  if(!pLogicalVolume)
+    {
+      G4cout << "--> warning from DetectorConstruction::SetSmartless : "
+	     << hVolumeName << " not found" << G4endl;
+      return;
+    }
+
+  pLogicalVolume->SetSmartless(dSmartless);
+
+  // the voxels of the volume are rebuilt through one of its daughters
+  if(G4StateManager::GetStateManager()->GetCurrentState() == G4State_Idle && pLogicalVolume->GetNoDaughters())
+    ReoptimiseGeometry(pLogicalVolume->GetDaughter(0));
+}
+
+//******************************************************************/
+// TuneSmartless
+//******************************************************************/
+void muensterTPCDetectorConstruction::TuneSmartless(G4int iNbEvents) {
+  // every mother volume is tuned in turn with short runs of the current
+  // source (e.g. optical photons), all runs simulate the same events
+  // (same run id for the event seeds), the best value of a volume is
+  // kept for the following ones
+  const G4double pdCandidates[] = {0.5, 1., 2., 4., 8., 16.};
+  const G4int iNbCandidates = sizeof(pdCandidates)/sizeof(G4double);
+  const G4int iMinNbDaughters = 3;
+
+  G4RunManager *pRunManager = G4RunManager::GetRunManager();
+  muensterTPCPrimaryGeneratorAction *pPrimaryGeneratorAction =
+    (muensterTPCPrimaryGeneratorAction *) pRunManager->GetUserPrimaryGeneratorAction();
+  muensterTPCAnalysisManager *pAnalysisManager =
+    ((muensterTPCRunAction *) pRunManager->GetUserRunAction())->GetAnalysisManager();
+
+  G4LogicalVolumeStore *pLogicalVolumeStore = G4LogicalVolumeStore::GetInstance();
+  vector<G4LogicalVolume *> hMotherVolumes;
+  for(size_t i=0; i<pLogicalVolumeStore->size(); i++)
+    if((*pLogicalVolumeStore)[i]->GetNoDaughters() >= iMinNbDaughters)
+      hMotherVolumes.push_back((*pLogicalVolumeStore)[i]);
+
+  G4Timer hTimer;
+  G4double dStartTime = 0., dBestTime = 0.;
+
+  G4cout << "----> Tuning smartless of " << hMotherVolumes.size() << " mother volumes with "
+	 << iNbEvents << " events per trial" << G4endl;
+
+  // the trials do not touch the output file of the job
+  if(pAnalysisManager)
+    pAnalysisManager->SetCalibration(true);
+
+  // untimed warm-up, builds the physics tables and closes the geometry,
+  // its run id seeds the events of all trials
+  pRunManager->BeamOn(iNbEvents);
+  const G4int iRunId = pPrimaryGeneratorAction->GetRunId();
+
+  for(G4int iVolume=-1; iVolume<(G4int) hMotherVolumes.size(); iVolume++)
+    {
+      // the first trial measures the current settings
+      G4LogicalVolume *pLogicalVolume = (iVolume < 0)?(0):(hMotherVolumes[iVolume]);
+      const G4double dCurrentSmartless = (pLogicalVolume)?(pLogicalVolume->GetSmartless()):(0.);
+      G4double dBestSmartless = dCurrentSmartless;
+
+      for(G4int iCandidate=0; iCandidate<((pLogicalVolume)?(iNbCandidates):(1)); iCandidate++)
+	{
+	  if(pLogicalVolume)
+	    {
+	      if(pdCandidates[iCandidate] == dCurrentSmartless)
+		continue;
+	      SetSmartless(pLogicalVolume->GetName(), pdCandidates[iCandidate]);
+	    }
+
+	  pPrimaryGeneratorAction->SetFirstEvent(0, iRunId);
+
+	  hTimer.Start();
+	  pRunManager->BeamOn(iNbEvents);
+	  hTimer.Stop();
+
+	  if(!pLogicalVolume)
+	    dStartTime = dBestTime = hTimer.GetRealElapsed();
+	  else if(hTimer.GetRealElapsed() < dBestTime)
+	    {
+	      dBestTime = hTimer.GetRealElapsed();
+	      dBestSmartless = pdCandidates[iCandidate];
+	    }
+	}
+
+      if(pLogicalVolume)
+	{
+	  SetSmartless(pLogicalVolume->GetName(), dBestSmartless);
+	  G4cout << "----> Smartless of " << pLogicalVolume->GetName() << " (" << pLogicalVolume->GetNoDaughters()
+		 << " daughters): " << dBestSmartless << G4endl;
+	}
+    }
+
+  if(pAnalysisManager)
+    pAnalysisManager->SetCalibration(false);
+
+  G4cout << "----> Smartless tuning: " << dStartTime << " s -> " << dBestTime << " s";
+  if(dBestTime > 0.)
+    G4cout << ", speed-up " << dStartTime/dBestTime;
+  G4cout << G4endl;
+}
+
+//******************************************************************/
+// SetMeshModel
+//******************************************************************/
+void muensterTPCDetectorConstruction::SetMeshModel(const G4String &hModel) {
+  // slab:    meshes are volumes with an ABSLENGTH from the transparency
+  // surface: meshes are planes, the MeshSurface process absorbs the
+  //          photons with the same probability, no boundary steps
+  if(hModel != "slab" && hModel != "surface")
+    {
+      G4cout << "--> warning from DetectorConstruction::SetMeshModel : "
+	     << hModel << " not known" << G4endl;
+      return;
+    }
+
+  G4cout << "----> Setting mesh model to " << hModel << G4endl;
+  m_bMeshSurfaces = (hModel == "surface");
+
+  if(G4StateManager::GetStateManager()->GetCurrentState() == G4State_Idle)
+    MountMeshes();
+}
+
+//******************************************************************/
+// MountMeshes
+//******************************************************************/
+void muensterTPCDetectorConstruction::MountMeshes() {
+  G4bool bModified = false;
+
+  for(G4int i=0; i<(G4int) m_hGridMeshPhysicalVolumes.size(); i++)
+    {
+      G4VPhysicalVolume *pMesh = m_hGridMeshPhysicalVolumes[i];
+      G4LogicalVolume *pMotherLogicalVolume = pMesh->GetMotherLogical();
+
+      if(m_bMeshSurfaces && pMotherLogicalVolume->IsDaughter(pMesh))
+	pMotherLogicalVolume->RemoveDaughter(pMesh);
+      else if(!m_bMeshSurfaces && !pMotherLogicalVolume->IsDaughter(pMesh))
+	pMotherLogicalVolume->AddDaughter(pMesh);
+      else
+	continue;
+
+      bModified = true;
+    }
+
+  // the mothers of the meshes (GXe and LXe)
+  if(bModified && G4StateManager::GetStateManager()->GetCurrentState() == G4State_Idle)
+    for(G4int i=0; i<(G4int) m_hGridMeshPhysicalVolumes.size(); i++)
+      ReoptimiseGeometry(m_hGridMeshPhysicalVolumes[i]);
+
+  UpdateMeshPlanes();
+}
+
+//******************************************************************/
+// UpdateMeshPlanes
+//******************************************************************/
+void muensterTPCDetectorConstruction::UpdateMeshPlanes() {
+  vector<muensterTPCMeshSurfaceProcess::MeshPlane> hMeshPlanes;
+
+  for(G4int i=0; i<(G4int) m_hGridMeshPhysicalVolumes.size() && m_bMeshSurfaces; i++)
+    {
+      G4VPhysicalVolume *pMesh = m_hGridMeshPhysicalVolumes[i];
+      G4Tubs *pMeshTubs = (G4Tubs *) pMesh->GetLogicalVolume()->GetSolid();
+
+      // Lab -> OuterCryostatVacuum -> LXe (-> GXe) -> mesh
+      G4double dZ = pMesh->GetTranslation().z();
+      if(pMesh->GetMotherLogical() == m_pGXeLogicalVolume)
+	dZ += m_pGXePhysicalVolume->GetTranslation().z();
+      dZ += m_pLXePhysicalVolume->GetTranslation().z();
+      dZ += m_pOuterCryostatVacuumPhysicalVolume->GetTranslation().z();
+
+      muensterTPCMeshSurfaceProcess::MeshPlane hPlane;
+      hPlane.dZ = dZ;
+      hPlane.dRadius = pMeshTubs->GetOuterRadius();
+      hPlane.dThickness = 2*pMeshTubs->GetZHalfLength();
+      hPlane.pMaterial = pMesh->GetLogicalVolume()->GetMaterial();
+
+      hMeshPlanes.push_back(hPlane);
+    }
+
+  muensterTPCMeshSurfaceProcess::SetMeshPlanes(hMeshPlanes);
+}
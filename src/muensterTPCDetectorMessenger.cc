@@ -18,6 +18,7 @@
 #include <G4ios.hh>
 #include <fstream>
 #include <iomanip>
+#include <sstream>
 
 #include "muensterTPCDetectorMessenger.hh"
 
@@ -29,13 +30,32 @@ muensterTPCDetectorMessenger::muensterTPCDetectorMessenger(muensterTPCDetectorCo
 	m_pDetectorDir = new G4UIdirectory("/Xe/detector/");
 	m_pDetectorDir->SetGuidance("detector control.");
 
-	// Not working - just a template
 	m_pLXeLevelCmd = new G4UIcmdWithADoubleAndUnit("/Xe/detector/setLXeLevel", this);
-	m_pLXeLevelCmd->SetGuidance("Define level of the liquid xenon - spread of the GXe.");
+	m_pLXeLevelCmd->SetGuidance("Shift the liquid xenon level w.r.t. the nominal level (between gate and anode).");
+	m_pLXeLevelCmd->SetGuidance("Can be changed between runs, only the xenon volumes are re-optimised.");
 	m_pLXeLevelCmd->SetParameterName("LXeLevel", false);
-	m_pLXeLevelCmd->SetRange("LXeLevel >= 0.");
+	m_pLXeLevelCmd->SetUnitCategory("Length");
 	m_pLXeLevelCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
 
+	m_pAnodeMeshOffsetCmd = new G4UIcmdWithADoubleAndUnit("/Xe/detector/setAnodeMeshOffset", this);
+	m_pAnodeMeshOffsetCmd->SetGuidance("Shift the anode mesh w.r.t. its nominal position.");
+	m_pAnodeMeshOffsetCmd->SetGuidance("Can be changed between runs, only the xenon volumes are re-optimised.");
+	m_pAnodeMeshOffsetCmd->SetParameterName("AnodeOffset", false);
+	m_pAnodeMeshOffsetCmd->SetUnitCategory("Length");
+	m_pAnodeMeshOffsetCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pNbMountedTopPmtsCmd = new G4UIcmdWithAnInteger("/Xe/detector/setNbTopPmts", this);
+	m_pNbMountedTopPmtsCmd->SetGuidance("Number of mounted PMTs in the top array, the other positions stay empty.");
+	m_pNbMountedTopPmtsCmd->SetParameterName("NbTopPmts", false);
+	m_pNbMountedTopPmtsCmd->SetRange("NbTopPmts >= 0");
+	m_pNbMountedTopPmtsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pNbMountedBottomPmtsCmd = new G4UIcmdWithAnInteger("/Xe/detector/setNbBottomPmts", this);
+	m_pNbMountedBottomPmtsCmd->SetGuidance("Number of mounted PMTs in the bottom array, the other positions stay empty.");
+	m_pNbMountedBottomPmtsCmd->SetParameterName("NbBottomPmts", false);
+	m_pNbMountedBottomPmtsCmd->SetRange("NbBottomPmts >= 0");
+	m_pNbMountedBottomPmtsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
 	m_pMaterCmd = new G4UIcmdWithAString("/Xe/detector/setMat",this);
 	m_pMaterCmd->SetGuidance("Select material of the LXe volume.");
 	m_pMaterCmd->SetParameterName("choice",false);
@@ -107,11 +127,83 @@ muensterTPCDetectorMessenger::muensterTPCDetectorMessenger(muensterTPCDetectorCo
     m_pLXeRefractionIndexCmd->SetRange("LXeR >= 1.56 && LXeR <= 1.69");
     m_pLXeRefractionIndexCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
 
+	m_pTeflonSurfaceModelCmd = new G4UIcmdWithAString("/Xe/detector/setTeflonSurfaceModel", this);
+	m_pTeflonSurfaceModelCmd->SetGuidance("Select the optical model of the Teflon surfaces.");
+	m_pTeflonSurfaceModelCmd->SetGuidance("unified: microfacet sampling, lambertian: reduced, diffuse only (fast optical runs)");
+	m_pTeflonSurfaceModelCmd->SetParameterName("model", false);
+	m_pTeflonSurfaceModelCmd->SetCandidates("unified lambertian");
+	m_pTeflonSurfaceModelCmd->AvailableForStates(G4State_Idle);
+
+	m_pMeshModelCmd = new G4UIcmdWithAString("/Xe/detector/setMeshModel", this);
+	m_pMeshModelCmd->SetGuidance("Select the optical model of the grid meshes.");
+	m_pMeshModelCmd->SetGuidance("slab: mesh volumes with an absorption length from the transparency,");
+	m_pMeshModelCmd->SetGuidance("surface: zero-thickness planes with the same absorption probability (fewer steps)");
+	m_pMeshModelCmd->SetParameterName("model", false);
+	m_pMeshModelCmd->SetCandidates("slab surface");
+	m_pMeshModelCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pPmtPlacementCmd = new G4UIcmdWithAString("/Xe/detector/setPmtPlacement", this);
+	m_pPmtPlacementCmd->SetGuidance("Placement of the PMT arrays in their holders.");
+	m_pPmtPlacementCmd->SetGuidance("placement: one volume per PMT part, parameterised: one parameterised volume per array");
+	m_pPmtPlacementCmd->SetParameterName("placement", false);
+	m_pPmtPlacementCmd->SetCandidates("placement parameterised");
+	m_pPmtPlacementCmd->AvailableForStates(G4State_PreInit);
+
+	m_pPmtLayoutCmd = new G4UIcmdWithAString("/Xe/detector/setPmtLayout", this);
+	m_pPmtLayoutCmd->SetGuidance("Read the PMT positions from a table, one PMT per line: top|bottom, x [mm], y [mm].");
+	m_pPmtLayoutCmd->SetGuidance("The order of the lines gives the PMT numbers, the top array comes first.");
+	m_pPmtLayoutCmd->SetParameterName("filename", false);
+	m_pPmtLayoutCmd->AvailableForStates(G4State_PreInit);
+
+	m_pGdmlCacheCmd = new G4UIcmdWithAString("/Xe/detector/setGdmlCache", this);
+	m_pGdmlCacheCmd->SetGuidance("Read the geometry from a GDML file if it was written with the same geometry parameters,");
+	m_pGdmlCacheCmd->SetGuidance("otherwise build the geometry and write it to the file.");
+	m_pGdmlCacheCmd->SetParameterName("filename", false);
+	m_pGdmlCacheCmd->AvailableForStates(G4State_PreInit);
+
+	m_pExportGdmlCmd = new G4UIcmdWithAString("/Xe/detector/exportGdml", this);
+	m_pExportGdmlCmd->SetGuidance("Write the current geometry to a GDML file.");
+	m_pExportGdmlCmd->SetParameterName("filename", false);
+	m_pExportGdmlCmd->AvailableForStates(G4State_Idle);
+
+	m_pAuditGeometryCmd = new G4UIcmdWithAnInteger("/Xe/detector/auditGeometry", this);
+	m_pAuditGeometryCmd->SetGuidance("Check all placements for overlaps and time the navigation per logical volume");
+	m_pAuditGeometryCmd->SetGuidance("with random points in the cryostat, the smartless/voxel settings are printed too.");
+	m_pAuditGeometryCmd->SetParameterName("NbPoints", true);
+	m_pAuditGeometryCmd->SetDefaultValue(100000);
+	m_pAuditGeometryCmd->SetRange("NbPoints > 0");
+	m_pAuditGeometryCmd->AvailableForStates(G4State_Idle);
+
+	m_pSmartlessCmd = new G4UIcommand("/Xe/detector/smartless", this);
+	m_pSmartlessCmd->SetGuidance("Set the voxelisation quality (smartless) of a logical volume.");
+	m_pSmartlessCmd->SetGuidance("[usage] /Xe/detector/smartless volume value");
+	m_pSmartlessCmd->SetGuidance("        volume: name of the logical volume, e.g. LXeVolume");
+	m_pSmartlessCmd->SetGuidance("        value: average number of voxels per daughter (Geant4 default 2)");
+
+	G4UIparameter *pParameter;
+	pParameter = new G4UIparameter("volume", 's', false);
+	m_pSmartlessCmd->SetParameter(pParameter);
+	pParameter = new G4UIparameter("value", 'd', false);
+	pParameter->SetParameterRange("value > 0.");
+	m_pSmartlessCmd->SetParameter(pParameter);
+	m_pSmartlessCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pTuneSmartlessCmd = new G4UIcmdWithAnInteger("/Xe/detector/tuneSmartless", this);
+	m_pTuneSmartlessCmd->SetGuidance("Choose the smartless of all mother volumes with short runs of the current source");
+	m_pTuneSmartlessCmd->SetGuidance("(e.g. optical photons) and print the speed-up, the runs go into a temporary output file.");
+	m_pTuneSmartlessCmd->SetParameterName("NbEvents", true);
+	m_pTuneSmartlessCmd->SetDefaultValue(1000);
+	m_pTuneSmartlessCmd->SetRange("NbEvents > 0");
+	m_pTuneSmartlessCmd->AvailableForStates(G4State_Idle);
+
 }
 
 muensterTPCDetectorMessenger::~muensterTPCDetectorMessenger()
 {
 	delete m_pLXeLevelCmd;
+	delete m_pAnodeMeshOffsetCmd;
+	delete m_pNbMountedTopPmtsCmd;
+	delete m_pNbMountedBottomPmtsCmd;
 	delete m_pMaterCmd;
 	delete m_pLXeMeshMaterialCmd;
 	delete m_pGXeMeshMaterialCmd;
@@ -124,6 +216,15 @@ muensterTPCDetectorMessenger::~muensterTPCDetectorMessenger()
 	delete m_pLXeRefractionIndexCmd;
 	delete m_pLXeMeshTransparencyCmd;
 	delete m_pGXeMeshTransparencyCmd;
+	delete m_pTeflonSurfaceModelCmd;
+	delete m_pMeshModelCmd;
+	delete m_pPmtPlacementCmd;
+	delete m_pPmtLayoutCmd;
+	delete m_pGdmlCacheCmd;
+	delete m_pExportGdmlCmd;
+	delete m_pAuditGeometryCmd;
+	delete m_pSmartlessCmd;
+	delete m_pTuneSmartlessCmd;
 
 	delete m_pDetectorDir;
 }
@@ -134,6 +235,15 @@ void muensterTPCDetectorMessenger::SetNewValue(G4UIcommand *pUIcommand, G4String
 	if(pUIcommand == m_pLXeLevelCmd)
 		m_pXeDetector->SetLXeLevel(m_pLXeLevelCmd->GetNewDoubleValue(hNewValue));
 
+	if(pUIcommand == m_pAnodeMeshOffsetCmd)
+		m_pXeDetector->SetAnodeMeshOffset(m_pAnodeMeshOffsetCmd->GetNewDoubleValue(hNewValue));
+
+	if(pUIcommand == m_pNbMountedTopPmtsCmd)
+		m_pXeDetector->SetNbMountedTopPmts(m_pNbMountedTopPmtsCmd->GetNewIntValue(hNewValue));
+
+	if(pUIcommand == m_pNbMountedBottomPmtsCmd)
+		m_pXeDetector->SetNbMountedBottomPmts(m_pNbMountedBottomPmtsCmd->GetNewIntValue(hNewValue));
+
 	if(pUIcommand == m_pMaterCmd )
 		m_pXeDetector->SetMaterial(hNewValue);
 
@@ -169,6 +279,39 @@ void muensterTPCDetectorMessenger::SetNewValue(G4UIcommand *pUIcommand, G4String
 
 	if(pUIcommand == m_pLXeRefractionIndexCmd)
       m_pXeDetector->SetLXeRefractionIndex(m_pLXeRefractionIndexCmd->GetNewDoubleValue(hNewValue));	  
+
+	if(pUIcommand == m_pTeflonSurfaceModelCmd)
+		m_pXeDetector->SetTeflonSurfaceModel(hNewValue);
+
+	if(pUIcommand == m_pMeshModelCmd)
+		m_pXeDetector->SetMeshModel(hNewValue);
+
+	if(pUIcommand == m_pPmtPlacementCmd)
+		m_pXeDetector->SetPmtPlacement(hNewValue);
+
+	if(pUIcommand == m_pPmtLayoutCmd)
+		m_pXeDetector->SetPmtLayout(hNewValue);
+
+	if(pUIcommand == m_pGdmlCacheCmd)
+		m_pXeDetector->SetGdmlCache(hNewValue);
+
+	if(pUIcommand == m_pExportGdmlCmd)
+		m_pXeDetector->ExportGdml(hNewValue, false);
+
+	if(pUIcommand == m_pAuditGeometryCmd)
+		m_pXeDetector->AuditGeometry(m_pAuditGeometryCmd->GetNewIntValue(hNewValue));
+
+	if(pUIcommand == m_pSmartlessCmd)
+	{
+		std::istringstream hStream(hNewValue);
+		G4String hVolumeName;
+		G4double dSmartless;
+		hStream >> hVolumeName >> dSmartless;
+		m_pXeDetector->SetSmartless(hVolumeName, dSmartless);
+	}
+
+	if(pUIcommand == m_pTuneSmartlessCmd)
+		m_pXeDetector->TuneSmartless(m_pTuneSmartlessCmd->GetNewIntValue(hNewValue));
 }
 
 
@@ -8,6 +8,8 @@
  *
  * @comment 
  ******************************************************************/
+#include <algorithm>
+
 #include "muensterTPCEventData.hh"
 
 muensterTPCEventData::muensterTPCEventData()
@@ -32,12 +34,23 @@ muensterTPCEventData::muensterTPCEventData()
 	m_pEnergyDeposited = new vector<float>;
 	m_pKineticEnergy = new vector<float>;
 	m_pTime = new vector<float>;
+	m_pStepLength = new vector<float>;
 
 	m_pPrimaryParticleType = new vector<string>;
 	m_fPrimaryEnergy = 0.;
 	m_fPrimaryX = 0.;
 	m_fPrimaryY = 0.;
 	m_fPrimaryZ = 0.;	
+
+	m_pWaveformPmt = new vector<int>;
+	m_pWaveformBin = new vector<int>;
+	m_pWaveformAmplitude = new vector<float>;
+	m_iNbWaveformBins = 0;
+	m_fWaveformBinWidth = 1.;
+	m_fWaveformStartTime = 0.;
+
+	m_iStepFields = eDefaultStepFields;
+	m_iReserveHint = 0;
 }
 
 muensterTPCEventData::~muensterTPCEventData()
@@ -55,8 +68,58 @@ muensterTPCEventData::~muensterTPCEventData()
 	delete m_pEnergyDeposited;
 	delete m_pKineticEnergy;
 	delete m_pTime;
+	delete m_pStepLength;
 
 	delete m_pPrimaryParticleType;
+
+	delete m_pWaveformPmt;
+	delete m_pWaveformBin;
+	delete m_pWaveformAmplitude;
+}
+
+// branch names of the step fields in the order of the bits
+static const char *szStepFieldNames[muensterTPCEventData::eNbStepFields] = {
+	"trackid", "parentid", "type", "parenttype", "creaproc", "edproc",
+	"xp", "yp", "zp", "ed", "time", "ekin", "steplen"
+};
+
+const char *
+muensterTPCEventData::GetStepFieldName(int iBit)
+{
+	return (iBit >= 0 && iBit < eNbStepFields)?(szStepFieldNames[iBit]):("");
+}
+
+int
+muensterTPCEventData::GetStepField(const string &hName)
+{
+	for(int i=0; i<eNbStepFields; i++)
+		if(hName == szStepFieldNames[i])
+			return 1<<i;
+
+	return 0;
+}
+
+// number of steps below which the vectors are never shrunk
+static const int iMinReserve = 1024;
+
+// the strings of the pooled elements are overwritten, this keeps their buffers
+static inline void AssignString(vector<string> *pVector, int iIndex, const string &hValue)
+{
+	if(iIndex < (int) pVector->size())
+		(*pVector)[iIndex].assign(hValue);
+	else
+		pVector->push_back(hValue);
+}
+
+template<class T> static inline void ShrinkVector(vector<T> *pVector, int iCapacity)
+{
+	if((int) pVector->capacity() <= 4*iCapacity)
+		return;
+
+	vector<T> hVector;
+	hVector.reserve(iCapacity);
+	hVector.assign(pVector->begin(), pVector->begin()+std::min((int) pVector->size(), iCapacity));
+	pVector->swap(hVector);
 }
 
 void
@@ -66,28 +129,186 @@ muensterTPCEventData::Clear()
 	m_iNbTopPmtHits = 0;
 	m_iNbBottomPmtHits = 0;
 
-	m_pPmtHits->clear();
+	// only the pmts with hits have photons in their waveform
+	if(m_iNbWaveformBins)
+	{
+		const int iNbPmts = std::min((int) m_pPmtHits->size(), (int) m_hWaveforms.size()/m_iNbWaveformBins);
+		for(int i=0; i<iNbPmts; i++)
+			if((*m_pPmtHits)[i])
+				std::fill(m_hWaveforms.begin()+i*m_iNbWaveformBins, m_hWaveforms.begin()+(i+1)*m_iNbWaveformBins, 0.f);
+	}
+	m_pWaveformPmt->clear();
+	m_pWaveformBin->clear();
+	m_pWaveformAmplitude->clear();
+
+	// the size is set once per run
+	std::fill(m_pPmtHits->begin(), m_pPmtHits->end(), 0);
 
 	m_fTotalEnergyDeposited = 0.0;
+
+	// slowly decaying maximum of the event sizes
+	m_iReserveHint = std::max(m_iNbSteps, m_iReserveHint - m_iReserveHint/8);
 	m_iNbSteps = 0;
 
+	// clear() keeps the capacity, the string vectors keep their elements until Seal()
 	m_pTrackId->clear();
 	m_pParentId->clear();
-	m_pParticleType->clear();
-	m_pParentType->clear();
-	m_pCreatorProcess->clear();
-	m_pDepositingProcess->clear();
 	m_pX->clear();
 	m_pY->clear();
 	m_pZ->clear();
 	m_pEnergyDeposited->clear();
 	m_pKineticEnergy->clear();
 	m_pTime->clear();
+	m_pStepLength->clear();
+
+	Reserve(m_iReserveHint);
 
-	m_pPrimaryParticleType->clear();
 	m_fPrimaryEnergy = 0.;
 	m_fPrimaryX = 0.;
 	m_fPrimaryY = 0.;
 	m_fPrimaryZ = 0.;	
 }
 
+void
+muensterTPCEventData::Reserve(int iNbSteps)
+{
+	// memory of single large events is returned once they are rare
+	const int iCapacity = std::max(iNbSteps, iMinReserve);
+
+	ShrinkVector(m_pTrackId, iCapacity);
+	ShrinkVector(m_pParentId, iCapacity);
+	ShrinkVector(m_pParticleType, iCapacity);
+	ShrinkVector(m_pParentType, iCapacity);
+	ShrinkVector(m_pCreatorProcess, iCapacity);
+	ShrinkVector(m_pDepositingProcess, iCapacity);
+	ShrinkVector(m_pX, iCapacity);
+	ShrinkVector(m_pY, iCapacity);
+	ShrinkVector(m_pZ, iCapacity);
+	ShrinkVector(m_pEnergyDeposited, iCapacity);
+	ShrinkVector(m_pKineticEnergy, iCapacity);
+	ShrinkVector(m_pTime, iCapacity);
+	ShrinkVector(m_pStepLength, iCapacity);
+
+	m_pTrackId->reserve(iNbSteps);
+	m_pParentId->reserve(iNbSteps);
+	m_pParticleType->reserve(iNbSteps);
+	m_pParentType->reserve(iNbSteps);
+	m_pCreatorProcess->reserve(iNbSteps);
+	m_pDepositingProcess->reserve(iNbSteps);
+	m_pX->reserve(iNbSteps);
+	m_pY->reserve(iNbSteps);
+	m_pZ->reserve(iNbSteps);
+	m_pEnergyDeposited->reserve(iNbSteps);
+	m_pKineticEnergy->reserve(iNbSteps);
+	m_pTime->reserve(iNbSteps);
+	m_pStepLength->reserve(iNbSteps);
+}
+
+void
+muensterTPCEventData::AddStep(int iTrackId, int iParentId, const string &hParticleType, const string &hParentType,
+	const string &hCreatorProcess, const string &hDepositingProcess, float fX, float fY, float fZ,
+	float fEnergyDeposited, float fKineticEnergy, float fTime, float fStepLength)
+{
+	if(m_iStepFields & eStepTrackId) m_pTrackId->push_back(iTrackId);
+	if(m_iStepFields & eStepParentId) m_pParentId->push_back(iParentId);
+
+	if(m_iStepFields & eStepType) SetStepString(m_pParticleType, hParticleType);
+	if(m_iStepFields & eStepParentType) SetStepString(m_pParentType, hParentType);
+	if(m_iStepFields & eStepCreatorProcess) SetStepString(m_pCreatorProcess, hCreatorProcess);
+	if(m_iStepFields & eStepDepositingProcess) SetStepString(m_pDepositingProcess, hDepositingProcess);
+
+	if(m_iStepFields & eStepX) m_pX->push_back(fX);
+	if(m_iStepFields & eStepY) m_pY->push_back(fY);
+	if(m_iStepFields & eStepZ) m_pZ->push_back(fZ);
+	if(m_iStepFields & eStepEnergyDeposited) m_pEnergyDeposited->push_back(fEnergyDeposited);
+	if(m_iStepFields & eStepKineticEnergy) m_pKineticEnergy->push_back(fKineticEnergy);
+	if(m_iStepFields & eStepTime) m_pTime->push_back(fTime);
+	if(m_iStepFields & eStepLength) m_pStepLength->push_back(fStepLength);
+
+	m_iNbSteps++;
+}
+
+void
+muensterTPCEventData::SetStepString(vector<string> *pVector, const string &hValue)
+{
+	AssignString(pVector, m_iNbSteps, hValue);
+}
+
+void
+muensterTPCEventData::SetPrimaryParticleType(const string &hParticleType)
+{
+	AssignString(m_pPrimaryParticleType, 0, hParticleType);
+	m_pPrimaryParticleType->resize(1);
+}
+
+void
+muensterTPCEventData::Seal()
+{
+	m_pParticleType->resize((m_iStepFields & eStepType)?(m_iNbSteps):(0));
+	m_pParentType->resize((m_iStepFields & eStepParentType)?(m_iNbSteps):(0));
+	m_pCreatorProcess->resize((m_iStepFields & eStepCreatorProcess)?(m_iNbSteps):(0));
+	m_pDepositingProcess->resize((m_iStepFields & eStepDepositingProcess)?(m_iNbSteps):(0));
+}
+
+void
+muensterTPCEventData::SetWaveform(int iNbPmts, int iNbBins, float fBinWidth, float fStartTime, const vector<float> &hSpeResponse)
+{
+	m_iNbWaveformBins = std::max(iNbBins, 0);
+	m_fWaveformBinWidth = fBinWidth;
+	m_fWaveformStartTime = fStartTime;
+	m_hSpeResponse = hSpeResponse;
+
+	// the converter of the binary format only needs the settings, not the buffer
+	m_hWaveforms.assign(iNbPmts*m_iNbWaveformBins, 0.f);
+	m_hConvolution.assign(m_iNbWaveformBins, 0.f);
+}
+
+void
+muensterTPCEventData::SealWaveforms()
+{
+	m_pWaveformPmt->clear();
+	m_pWaveformBin->clear();
+	m_pWaveformAmplitude->clear();
+
+	if(!m_iNbWaveformBins)
+		return;
+
+	const int iNbBins = m_iNbWaveformBins;
+	const int iNbResponseBins = m_hSpeResponse.size();
+	const int iNbPmts = std::min((int) m_pPmtHits->size(), (int) m_hWaveforms.size()/iNbBins);
+
+	for(int i=0; i<iNbPmts; i++)
+	{
+		if(!(*m_pPmtHits)[i])
+			continue;
+
+		const float *pPhotons = &m_hWaveforms[i*iNbBins];
+		const float *pWaveform = pPhotons;
+
+		// the photons are sparse, every photon bin adds the response
+		if(iNbResponseBins)
+		{
+			std::fill(m_hConvolution.begin(), m_hConvolution.end(), 0.f);
+			for(int j=0; j<iNbBins; j++)
+			{
+				if(pPhotons[j] == 0.f)
+					continue;
+
+				const int iNbTerms = std::min(iNbResponseBins, iNbBins-j);
+				for(int k=0; k<iNbTerms; k++)
+					m_hConvolution[j+k] += pPhotons[j]*m_hSpeResponse[k];
+			}
+			pWaveform = &m_hConvolution[0];
+		}
+
+		for(int j=0; j<iNbBins; j++)
+		{
+			if(pWaveform[j] != 0.f)
+			{
+				m_pWaveformPmt->push_back(i);
+				m_pWaveformBin->push_back(j);
+				m_pWaveformAmplitude->push_back(pWaveform[j]);
+			}
+		}
+	}
+}
@@ -0,0 +1,220 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Event selection before the event is written
+ *
+ * @comment
+ ******************************************************************/
+#include <G4SystemOfUnits.hh>
+#include <G4ios.hh>
+
+#include <algorithm>
+#include <cfloat>
+
+#include "muensterTPCEventFilter.hh"
+#include "muensterTPCEventData.hh"
+#include "muensterTPCEventFilterMessenger.hh"
+
+muensterTPCEventFilter::muensterTPCEventFilter() {
+	m_pMessenger = new muensterTPCEventFilterMessenger(this);
+
+	Clear();
+
+	m_lNbAccepted = 0;
+	m_lNbRejected = 0;
+	m_bNeedsSteps = false;
+}
+
+muensterTPCEventFilter::~muensterTPCEventFilter() {
+	delete m_pMessenger;
+}
+
+//******************************************************************/
+// SetEnergyRange
+//******************************************************************/
+void muensterTPCEventFilter::SetEnergyRange(G4double dMinimum, G4double dMaximum) {
+	m_bEnergyCut = true;
+	m_dEnergyMinimum = dMinimum;
+	m_dEnergyMaximum = dMaximum;
+
+	G4cout << "----> Setting event filter: energy in the LXe from " << dMinimum/keV << " to " << dMaximum/keV << " keV" << G4endl;
+}
+
+//******************************************************************/
+// SetFiducialVolume
+//******************************************************************/
+void muensterTPCEventFilter::SetFiducialVolume(G4double dZMinimum, G4double dZMaximum, G4double dRadius) {
+	m_bFiducialVolume = true;
+	m_dFiducialZMinimum = dZMinimum;
+	m_dFiducialZMaximum = dZMaximum;
+	m_dFiducialRadius = dRadius;
+
+	G4cout << "----> Setting event filter: fiducial volume " << dZMinimum/mm << " mm < z < " << dZMaximum/mm
+	       << " mm, r < " << dRadius/mm << " mm" << G4endl;
+}
+
+//******************************************************************/
+// SetFiducialEnergyRange
+//******************************************************************/
+void muensterTPCEventFilter::SetFiducialEnergyRange(G4double dMinimum, G4double dMaximum) {
+	m_bFiducialEnergyCut = true;
+	m_dFiducialEnergyMinimum = dMinimum;
+	m_dFiducialEnergyMaximum = dMaximum;
+
+	G4cout << "----> Setting event filter: energy in the fiducial volume from " << dMinimum/keV << " to " << dMaximum/keV << " keV" << G4endl;
+}
+
+//******************************************************************/
+// SetSingleScatter
+//******************************************************************/
+void muensterTPCEventFilter::SetSingleScatter(G4double dZRange) {
+	m_dSingleScatterZRange = dZRange;
+
+	G4cout << "----> Setting event filter: single scatter within " << dZRange/mm << " mm in z" << G4endl;
+}
+
+//******************************************************************/
+// SetMinimumPmtHits
+//******************************************************************/
+void muensterTPCEventFilter::SetMinimumPmtHits(G4int iNbPmtHits) {
+	m_iMinimumPmtHits = iNbPmtHits;
+
+	G4cout << "----> Setting event filter: at least " << iNbPmtHits << " pmt hits" << G4endl;
+}
+
+//******************************************************************/
+// Clear
+//******************************************************************/
+void muensterTPCEventFilter::Clear() {
+	m_bEnergyCut = false;
+	m_dEnergyMinimum = 0.;
+	m_dEnergyMaximum = -1.;
+
+	m_bFiducialVolume = false;
+	m_dFiducialZMinimum = 0.;
+	m_dFiducialZMaximum = 0.;
+	m_dFiducialRadius = 0.;
+
+	m_bFiducialEnergyCut = false;
+	m_dFiducialEnergyMinimum = 0.;
+	m_dFiducialEnergyMaximum = -1.;
+
+	m_dSingleScatterZRange = 0.;
+	m_iMinimumPmtHits = 0;
+}
+
+//******************************************************************/
+// BeginOfRun - collects the active cuts
+//******************************************************************/
+void muensterTPCEventFilter::BeginOfRun(G4double dDriftLength, G4double dRadius) {
+	// drift region of the current geometry
+	if(!m_bFiducialVolume)
+	{
+		m_dFiducialZMinimum = -dDriftLength;
+		m_dFiducialZMaximum = 0.;
+		m_dFiducialRadius = dRadius;
+	}
+
+	m_hCuts.clear();
+	if(m_bEnergyCut)
+		m_hCuts.push_back(&muensterTPCEventFilter::EnergyCut);
+	if(m_bFiducialEnergyCut)
+		m_hCuts.push_back(&muensterTPCEventFilter::FiducialEnergyCut);
+	if(m_dSingleScatterZRange > 0.)
+		m_hCuts.push_back(&muensterTPCEventFilter::SingleScatterCut);
+	if(m_iMinimumPmtHits > 0)
+		m_hCuts.push_back(&muensterTPCEventFilter::PmtHitsCut);
+
+	m_bNeedsSteps = m_bFiducialEnergyCut || m_dSingleScatterZRange > 0.;
+
+	m_lNbAccepted = 0;
+	m_lNbRejected = 0;
+}
+
+//******************************************************************/
+// EndOfRun
+//******************************************************************/
+void muensterTPCEventFilter::EndOfRun() {
+	if(m_hCuts.empty())
+		return;
+
+	G4cout << "Filter: " << m_hCuts.size() << " cuts || " << m_lNbAccepted << " accepted || " << m_lNbRejected << " rejected";
+	if(m_lNbAccepted+m_lNbRejected > 0)
+		G4cout << " || efficiency " << (G4double) m_lNbAccepted/(m_lNbAccepted+m_lNbRejected);
+	G4cout << G4endl;
+}
+
+//******************************************************************/
+// Accept
+//******************************************************************/
+G4bool muensterTPCEventFilter::Accept(muensterTPCEventData *pEventData, G4int iNbPmtHits) {
+	if(m_hCuts.empty())
+		return true;
+
+	EventSummary hSummary;
+	hSummary.dEnergy = pEventData->m_fTotalEnergyDeposited*keV;
+	hSummary.dFiducialEnergy = 0.;
+	hSummary.dZMinimum = DBL_MAX;
+	hSummary.dZMaximum = -DBL_MAX;
+	hSummary.iNbPmtHits = iNbPmtHits;
+
+	// one pass over the steps of the record (mm, keV), which has no optical photons
+	if(m_bNeedsSteps)
+	{
+		const G4double dFiducialRadius2 = m_dFiducialRadius*m_dFiducialRadius;
+		const G4float *pX = pEventData->m_pX->data();
+		const G4float *pY = pEventData->m_pY->data();
+		const G4float *pZ = pEventData->m_pZ->data();
+		const G4float *pEnergyDeposited = pEventData->m_pEnergyDeposited->data();
+
+		for(G4int i=0; i<pEventData->m_iNbSteps; i++)
+		{
+			const G4double dEnergyDeposited = pEnergyDeposited[i]*keV;
+			if(dEnergyDeposited <= 0.)
+				continue;
+
+			const G4double dX = pX[i]*mm, dY = pY[i]*mm, dZ = pZ[i]*mm;
+
+			if(dZ > m_dFiducialZMinimum && dZ < m_dFiducialZMaximum && dX*dX+dY*dY < dFiducialRadius2)
+				hSummary.dFiducialEnergy += dEnergyDeposited;
+
+			hSummary.dZMinimum = std::min(hSummary.dZMinimum, dZ);
+			hSummary.dZMaximum = std::max(hSummary.dZMaximum, dZ);
+		}
+	}
+
+	for(G4int i=0; i<(G4int) m_hCuts.size(); i++)
+	{
+		if(!(this->*m_hCuts[i])(hSummary))
+		{
+			m_lNbRejected++;
+			return false;
+		}
+	}
+
+	m_lNbAccepted++;
+	return true;
+}
+
+//******************************************************************/
+// cuts
+//******************************************************************/
+G4bool muensterTPCEventFilter::EnergyCut(const EventSummary &hSummary) {
+	return hSummary.dEnergy >= m_dEnergyMinimum && (m_dEnergyMaximum < 0. || hSummary.dEnergy <= m_dEnergyMaximum);
+}
+
+G4bool muensterTPCEventFilter::FiducialEnergyCut(const EventSummary &hSummary) {
+	return hSummary.dFiducialEnergy >= m_dFiducialEnergyMinimum
+		&& (m_dFiducialEnergyMaximum < 0. || hSummary.dFiducialEnergy <= m_dFiducialEnergyMaximum);
+}
+
+G4bool muensterTPCEventFilter::SingleScatterCut(const EventSummary &hSummary) {
+	// events without energy deposition are no single scatters
+	return hSummary.dZMaximum >= hSummary.dZMinimum && hSummary.dZMaximum-hSummary.dZMinimum <= m_dSingleScatterZRange;
+}
+
+G4bool muensterTPCEventFilter::PmtHitsCut(const EventSummary &hSummary) {
+	return hSummary.iNbPmtHits >= m_iMinimumPmtHits;
+}
+
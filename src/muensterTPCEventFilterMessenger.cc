@@ -0,0 +1,140 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Communications with the EventFilter class
+ *
+ * @comment
+ ******************************************************************/
+
+#include <G4UIdirectory.hh>
+#include <G4UIcommand.hh>
+#include <G4UIparameter.hh>
+#include <G4UIcmdWithoutParameter.hh>
+#include <G4UIcmdWithAnInteger.hh>
+#include <G4UIcmdWithADoubleAndUnit.hh>
+#include <G4ios.hh>
+
+#include <sstream>
+
+#include "muensterTPCEventFilterMessenger.hh"
+#include "muensterTPCEventFilter.hh"
+
+// a range command "min max unit" with a unit of the given category
+static G4UIcommand *CreateRangeCommand(const char *szName, G4UImessenger *pMessenger, const char *szCategory, const char *szDefaultUnit)
+{
+  G4UIcommand *pCommand = new G4UIcommand(szName, pMessenger);
+
+  G4UIparameter *pParameter;
+  pParameter = new G4UIparameter("min", 'd', false);
+  pCommand->SetParameter(pParameter);
+  pParameter = new G4UIparameter("max", 'd', false);
+  pCommand->SetParameter(pParameter);
+  pParameter = new G4UIparameter("unit", 's', true);
+  pParameter->SetDefaultValue(szDefaultUnit);
+  pParameter->SetParameterCandidates(G4UIcommand::UnitsList(szCategory));
+  pCommand->SetParameter(pParameter);
+  pCommand->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  return pCommand;
+}
+
+muensterTPCEventFilterMessenger::muensterTPCEventFilterMessenger(muensterTPCEventFilter *pEventFilter):
+  m_pEventFilter(pEventFilter)
+{
+  // create directory
+  m_pDirectory = new G4UIdirectory("/Xe/filter/");
+  m_pDirectory->SetGuidance("Event filter, the cuts are applied before the event is written.");
+
+  m_pEnergyCmd = CreateRangeCommand("/Xe/filter/energy", this, "Energy", "keV");
+  m_pEnergyCmd->SetGuidance("Keep events with an energy deposition in the LXe within [min, max].");
+  m_pEnergyCmd->SetGuidance("[usage] /Xe/filter/energy min max unit, max < 0: no upper limit");
+
+  m_pFiducialVolumeCmd = new G4UIcommand("/Xe/filter/fiducialVolume", this);
+  m_pFiducialVolumeCmd->SetGuidance("Set the fiducial volume of /Xe/filter/fiducialEnergy (default drift region).");
+  m_pFiducialVolumeCmd->SetGuidance("[usage] /Xe/filter/fiducialVolume zmin zmax radius unit");
+  G4UIparameter *pParameter;
+  pParameter = new G4UIparameter("zmin", 'd', false);
+  m_pFiducialVolumeCmd->SetParameter(pParameter);
+  pParameter = new G4UIparameter("zmax", 'd', false);
+  m_pFiducialVolumeCmd->SetParameter(pParameter);
+  pParameter = new G4UIparameter("radius", 'd', false);
+  pParameter->SetParameterRange("radius > 0.");
+  m_pFiducialVolumeCmd->SetParameter(pParameter);
+  pParameter = new G4UIparameter("unit", 's', true);
+  pParameter->SetDefaultValue("mm");
+  pParameter->SetParameterCandidates(G4UIcommand::UnitsList("Length"));
+  m_pFiducialVolumeCmd->SetParameter(pParameter);
+  m_pFiducialVolumeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  m_pFiducialEnergyCmd = CreateRangeCommand("/Xe/filter/fiducialEnergy", this, "Energy", "keV");
+  m_pFiducialEnergyCmd->SetGuidance("Keep events with an energy deposition in the fiducial volume within [min, max].");
+  m_pFiducialEnergyCmd->SetGuidance("[usage] /Xe/filter/fiducialEnergy min max unit, max < 0: no upper limit");
+
+  m_pSingleScatterCmd = new G4UIcmdWithADoubleAndUnit("/Xe/filter/singleScatter", this);
+  m_pSingleScatterCmd->SetGuidance("Keep events with all energy depositions within a z range (0 switches the cut off).");
+  m_pSingleScatterCmd->SetParameterName("ZRange", false);
+  m_pSingleScatterCmd->SetRange("ZRange >= 0.");
+  m_pSingleScatterCmd->SetDefaultUnit("mm");
+  m_pSingleScatterCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  m_pMinimumPmtHitsCmd = new G4UIcmdWithAnInteger("/Xe/filter/minPmtHits", this);
+  m_pMinimumPmtHitsCmd->SetGuidance("Keep events with at least N pmt hits (0 switches the cut off).");
+  m_pMinimumPmtHitsCmd->SetParameterName("NbPmtHits", false);
+  m_pMinimumPmtHitsCmd->SetRange("NbPmtHits >= 0");
+  m_pMinimumPmtHitsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  m_pClearCmd = new G4UIcmdWithoutParameter("/Xe/filter/clear", this);
+  m_pClearCmd->SetGuidance("Remove all cuts.");
+  m_pClearCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+muensterTPCEventFilterMessenger::~muensterTPCEventFilterMessenger()
+{
+  delete m_pEnergyCmd;
+  delete m_pFiducialVolumeCmd;
+  delete m_pFiducialEnergyCmd;
+  delete m_pSingleScatterCmd;
+  delete m_pMinimumPmtHitsCmd;
+  delete m_pClearCmd;
+  delete m_pDirectory;
+}
+
+void muensterTPCEventFilterMessenger::SetNewValue(G4UIcommand *pUIcommand, G4String hNewValues)
+{
+  if(pUIcommand == m_pEnergyCmd || pUIcommand == m_pFiducialEnergyCmd)
+  {
+    std::istringstream hStream(hNewValues);
+    G4double dMinimum, dMaximum;
+    G4String hUnit;
+    hStream >> dMinimum >> dMaximum >> hUnit;
+
+    // the maximum keeps its sign (< 0: no upper limit)
+    const G4double dUnit = G4UIcommand::ValueOf(hUnit);
+    if(pUIcommand == m_pEnergyCmd)
+      m_pEventFilter->SetEnergyRange(dMinimum*dUnit, dMaximum*dUnit);
+    else
+      m_pEventFilter->SetFiducialEnergyRange(dMinimum*dUnit, dMaximum*dUnit);
+  }
+
+  if(pUIcommand == m_pFiducialVolumeCmd)
+  {
+    std::istringstream hStream(hNewValues);
+    G4double dZMinimum, dZMaximum, dRadius;
+    G4String hUnit;
+    hStream >> dZMinimum >> dZMaximum >> dRadius >> hUnit;
+
+    const G4double dUnit = G4UIcommand::ValueOf(hUnit);
+    m_pEventFilter->SetFiducialVolume(dZMinimum*dUnit, dZMaximum*dUnit, dRadius*dUnit);
+  }
+
+  if(pUIcommand == m_pSingleScatterCmd)
+    m_pEventFilter->SetSingleScatter(m_pSingleScatterCmd->GetNewDoubleValue(hNewValues));
+
+  if(pUIcommand == m_pMinimumPmtHitsCmd)
+    m_pEventFilter->SetMinimumPmtHits(m_pMinimumPmtHitsCmd->GetNewIntValue(hNewValues));
+
+  if(pUIcommand == m_pClearCmd)
+    m_pEventFilter->Clear();
+}
+
@@ -0,0 +1,187 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Histograms of event quantities instead of the events
+ *
+ * @comment
+ ******************************************************************/
+#include <TH1D.h>
+#include <TH2D.h>
+#include <TH3D.h>
+
+#include <cmath>
+#include <numeric>
+#include <sstream>
+
+#include "muensterTPCHistogramWriter.hh"
+#include "muensterTPCEventData.hh"
+
+enum {
+	eTotalEnergyDeposited, eNbTopPmtHits, eNbBottomPmtHits, eNbPmtHits, eAsymmetry, eNbSteps,
+	ePrimaryEnergy, ePrimaryX, ePrimaryY, ePrimaryZ, ePrimaryR,
+	eNbVariables
+};
+
+static const char *szVariableNames[eNbVariables] = {
+	"etot", "ntpmthits", "nbpmthits", "npmthits", "asym", "nsteps",
+	"e_pri", "xp_pri", "yp_pri", "zp_pri", "rp_pri"
+};
+
+static G4int GetVariableIndex(const G4String &hVariable)
+{
+	for(G4int i=0; i<eNbVariables; i++)
+		if(hVariable == szVariableNames[i])
+			return i;
+
+	return -1;
+}
+
+muensterTPCHistogramWriter::muensterTPCHistogramWriter(muensterTPCEventData *pEventData, const std::vector<Histogram> &hHistograms) {
+	m_pEventData = pEventData;
+
+	for(G4int i=0; i<(G4int) hHistograms.size(); i++)
+	{
+		const Histogram &hHistogram = hHistograms[i];
+
+		std::stringstream hTitle;
+		hTitle << hHistogram.hName << ";" << hHistogram.hVariables[0] << ";" << hHistogram.hVariables[1] << ";" << hHistogram.hVariables[2];
+
+		TH1 *pHistogram = 0;
+		if(hHistogram.iDimension == 1)
+			pHistogram = new TH1D(hHistogram.hName.c_str(), hTitle.str().c_str(),
+				hHistogram.iNbBins[0], hHistogram.dMin[0], hHistogram.dMax[0]);
+		else if(hHistogram.iDimension == 2)
+			pHistogram = new TH2D(hHistogram.hName.c_str(), hTitle.str().c_str(),
+				hHistogram.iNbBins[0], hHistogram.dMin[0], hHistogram.dMax[0],
+				hHistogram.iNbBins[1], hHistogram.dMin[1], hHistogram.dMax[1]);
+		else
+			pHistogram = new TH3D(hHistogram.hName.c_str(), hTitle.str().c_str(),
+				hHistogram.iNbBins[0], hHistogram.dMin[0], hHistogram.dMax[0],
+				hHistogram.iNbBins[1], hHistogram.dMin[1], hHistogram.dMax[1],
+				hHistogram.iNbBins[2], hHistogram.dMin[2], hHistogram.dMax[2]);
+
+		m_hHistograms.push_back(pHistogram);
+		m_hDimensions.push_back(hHistogram.iDimension);
+		for(G4int j=0; j<3; j++)
+			m_hVariables.push_back((j < hHistogram.iDimension)?(GetVariableIndex(hHistogram.hVariables[j])):(0));
+	}
+
+	// time histogram per pmt in the binning of the waveforms
+	m_pWaveformHistogram = 0;
+	if(pEventData->HasWaveforms())
+	{
+		const G4int iNbPmts = pEventData->m_pPmtHits->size();
+		const G4int iNbBins = pEventData->GetNbWaveformBins();
+		const G4double dStartTime = pEventData->GetWaveformStartTime();
+		m_pWaveformHistogram = new TH2D("h_waveforms", "h_waveforms;pmt;time [ns]", iNbPmts, -0.5, iNbPmts-0.5,
+			iNbBins, dStartTime, dStartTime+iNbBins*pEventData->GetWaveformBinWidth());
+	}
+}
+
+//******************************************************************/
+// the histograms belong to the output file
+//******************************************************************/
+muensterTPCHistogramWriter::~muensterTPCHistogramWriter() {
+}
+
+//******************************************************************/
+// Fill
+//******************************************************************/
+void muensterTPCHistogramWriter::Fill() {
+	muensterTPCEventData *pEventData = m_pEventData;
+
+	// all variables, only a few operations per event
+	G4double dValues[eNbVariables];
+	const G4double dNbTopPmtHits = pEventData->m_iNbTopPmtHits;
+	const G4double dNbBottomPmtHits = pEventData->m_iNbBottomPmtHits;
+
+	dValues[eTotalEnergyDeposited] = pEventData->m_fTotalEnergyDeposited;
+	dValues[eNbTopPmtHits] = dNbTopPmtHits;
+	dValues[eNbBottomPmtHits] = dNbBottomPmtHits;
+	dValues[eNbPmtHits] = std::accumulate(pEventData->m_pPmtHits->begin(), pEventData->m_pPmtHits->end(), 0);
+	// events without light are in the underflow bin
+	dValues[eAsymmetry] = (dNbTopPmtHits+dNbBottomPmtHits > 0.)?((dNbTopPmtHits-dNbBottomPmtHits)/(dNbTopPmtHits+dNbBottomPmtHits)):(-2.);
+	dValues[eNbSteps] = pEventData->m_iNbSteps;
+	dValues[ePrimaryEnergy] = pEventData->m_fPrimaryEnergy;
+	dValues[ePrimaryX] = pEventData->m_fPrimaryX;
+	dValues[ePrimaryY] = pEventData->m_fPrimaryY;
+	dValues[ePrimaryZ] = pEventData->m_fPrimaryZ;
+	dValues[ePrimaryR] = std::sqrt(dValues[ePrimaryX]*dValues[ePrimaryX] + dValues[ePrimaryY]*dValues[ePrimaryY]);
+
+	for(G4int i=0; i<(G4int) m_hHistograms.size(); i++)
+	{
+		const G4int *pVariables = &m_hVariables[3*i];
+
+		if(m_hDimensions[i] == 1)
+			m_hHistograms[i]->Fill(dValues[pVariables[0]]);
+		else if(m_hDimensions[i] == 2)
+			((TH2D *) m_hHistograms[i])->Fill(dValues[pVariables[0]], dValues[pVariables[1]]);
+		else
+			((TH3D *) m_hHistograms[i])->Fill(dValues[pVariables[0]], dValues[pVariables[1]], dValues[pVariables[2]]);
+	}
+
+	if(m_pWaveformHistogram)
+	{
+		// bin centres, weighted with the photons or amplitude
+		const G4int iNbWaveformBins = pEventData->m_pWaveformBin->size();
+		const G4double dStartTime = pEventData->GetWaveformStartTime();
+		const G4double dBinWidth = pEventData->GetWaveformBinWidth();
+		for(G4int i=0; i<iNbWaveformBins; i++)
+			m_pWaveformHistogram->Fill((*pEventData->m_pWaveformPmt)[i],
+				dStartTime + ((*pEventData->m_pWaveformBin)[i]+0.5)*dBinWidth, (*pEventData->m_pWaveformAmplitude)[i]);
+	}
+
+	m_lNbEntries++;
+}
+
+//******************************************************************/
+// Close - the histograms are written with the output file
+//******************************************************************/
+void muensterTPCHistogramWriter::Close() {
+}
+
+//******************************************************************/
+// GetDescription
+//******************************************************************/
+G4String muensterTPCHistogramWriter::GetDescription() {
+	std::stringstream hStream;
+	hStream << "histograms || " << m_hHistograms.size() << " histograms";
+	if(m_pWaveformHistogram)
+		hStream << " + h_waveforms";
+
+	return hStream.str();
+}
+
+//******************************************************************/
+// IsVariable
+//******************************************************************/
+G4bool muensterTPCHistogramWriter::IsVariable(const G4String &hVariable) {
+	return GetVariableIndex(hVariable) != -1;
+}
+
+//******************************************************************/
+// GetDefaultHistograms
+//******************************************************************/
+std::vector<muensterTPCHistogramWriter::Histogram> muensterTPCHistogramWriter::GetDefaultHistograms() {
+	const char *szNames[5] = {"h_etot", "h_ntpmthits", "h_nbpmthits", "h_asym", "h_zp_pri"};
+	const char *szVariables[5] = {"etot", "ntpmthits", "nbpmthits", "asym", "zp_pri"};
+	// asym = +1 (all hits in the top array) has to be inside the last bin
+	const G4int iNbBins[5] = {1000, 1000, 1000, 201, 200};
+	const G4double dMin[5] = {0., 0., 0., -1.005, -250.};
+	const G4double dMax[5] = {1000., 10000., 10000., 1.005, 50.};
+
+	std::vector<Histogram> hHistograms(5);
+	for(G4int i=0; i<5; i++)
+	{
+		hHistograms[i].hName = szNames[i];
+		hHistograms[i].iDimension = 1;
+		hHistograms[i].hVariables[0] = szVariables[i];
+		hHistograms[i].iNbBins[0] = iNbBins[i];
+		hHistograms[i].dMin[0] = dMin[i];
+		hHistograms[i].dMax[0] = dMax[i];
+	}
+
+	return hHistograms;
+}
+
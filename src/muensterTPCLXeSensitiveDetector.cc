@@ -13,6 +13,8 @@
 #include <G4VProcess.hh>
 #include <G4ThreeVector.hh>
 #include <G4SDManager.hh>
+#include <G4OpticalPhoton.hh>
+#include <G4SystemOfUnits.hh>
 #include <G4ios.hh>
 
 #include <map>
@@ -20,10 +22,16 @@
 using std::map;
 
 #include "muensterTPCLXeSensitiveDetector.hh"
+#include "muensterTPCEventData.hh"
 
 muensterTPCLXeSensitiveDetector::muensterTPCLXeSensitiveDetector(G4String hName): G4VSensitiveDetector(hName)
 {
 	collectionName.insert("LXeHitsCollection");
+
+	m_pEventData = 0;
+	m_iStepFields = 0;
+	m_bStoreHits = false;
+	m_iNbHits = 0;
 }
 
 muensterTPCLXeSensitiveDetector::~muensterTPCLXeSensitiveDetector()
@@ -42,27 +50,99 @@ void muensterTPCLXeSensitiveDetector::Initialize(G4HCofThisEvent* pHitsCollectio
 	pHitsCollectionOfThisEvent->AddHitsCollection(iHitsCollectionID, m_pLXeHitsCollection);
 
 	m_hParticleTypes.clear();
+	m_iNbHits = 0;
+}
+
+//******************************************************************/
+// SetEventData - the fields are fixed for the run
+//******************************************************************/
+void muensterTPCLXeSensitiveDetector::SetEventData(muensterTPCEventData *pEventData)
+{
+	m_pEventData = pEventData;
+	m_iStepFields = (pEventData)?(pEventData->GetStepFields()):(0);
 }
 
 G4bool muensterTPCLXeSensitiveDetector::ProcessHits(G4Step* pStep, G4TouchableHistory *pHistory)
 {
-	G4double dEnergyDeposited = pStep->GetTotalEnergyDeposit();
+	G4Track *pTrack = pStep->GetTrack();
+
+	m_iNbHits++;
+
+	if(m_bStoreHits)
+		StoreHit(pStep);
+
+	// the optical photons are the pmt hits
+	if(!m_pEventData || pTrack->GetDefinition() == G4OpticalPhoton::Definition())
+		return true;
+
+	muensterTPCEventData *pEventData = m_pEventData;
+	const G4int iStepFields = m_iStepFields;
+	const G4double dEnergyDeposited = pStep->GetTotalEnergyDeposit();
+
+	pEventData->m_fTotalEnergyDeposited += dEnergyDeposited/keV;
+
+	if(!iStepFields)
+		return true;
+
+	// only the enabled fields are computed, the names belong to the particle
+	// definitions and processes, only the strings of the record are assigned
+	if(iStepFields & muensterTPCEventData::eStepTrackId)
+		pEventData->m_pTrackId->push_back(pTrack->GetTrackID());
+	if(iStepFields & muensterTPCEventData::eStepParentId)
+		pEventData->m_pParentId->push_back(pTrack->GetParentID());
+	if(iStepFields & muensterTPCEventData::eStepType)
+		pEventData->SetStepString(pEventData->m_pParticleType, pTrack->GetDefinition()->GetParticleName());
+	if(iStepFields & muensterTPCEventData::eStepParentType)
+	{
+		m_hParticleTypes.insert(std::make_pair(pTrack->GetTrackID(), pTrack->GetDefinition()));
+		pEventData->SetStepString(pEventData->m_pParentType, GetParentType(pTrack->GetParentID()));
+	}
+	if(iStepFields & muensterTPCEventData::eStepCreatorProcess)
+	{
+		static const G4String hNoCreatorProcess("Null");
+		const G4VProcess *pCreatorProcess = pTrack->GetCreatorProcess();
+		pEventData->SetStepString(pEventData->m_pCreatorProcess, (pCreatorProcess)?(pCreatorProcess->GetProcessName()):(hNoCreatorProcess));
+	}
+	if(iStepFields & muensterTPCEventData::eStepDepositingProcess)
+		pEventData->SetStepString(pEventData->m_pDepositingProcess, pStep->GetPostStepPoint()->GetProcessDefinedStep()->GetProcessName());
+
+	const G4ThreeVector &hPosition = pStep->GetPostStepPoint()->GetPosition();
+	if(iStepFields & muensterTPCEventData::eStepX)
+		pEventData->m_pX->push_back(hPosition.x()/mm);
+	if(iStepFields & muensterTPCEventData::eStepY)
+		pEventData->m_pY->push_back(hPosition.y()/mm);
+	if(iStepFields & muensterTPCEventData::eStepZ)
+		pEventData->m_pZ->push_back(hPosition.z()/mm);
+	if(iStepFields & muensterTPCEventData::eStepEnergyDeposited)
+		pEventData->m_pEnergyDeposited->push_back(dEnergyDeposited/keV);
+	if(iStepFields & muensterTPCEventData::eStepKineticEnergy)
+		pEventData->m_pKineticEnergy->push_back(pTrack->GetKineticEnergy()/keV);
+	if(iStepFields & muensterTPCEventData::eStepTime)
+		pEventData->m_pTime->push_back(pTrack->GetGlobalTime()/second);
+	if(iStepFields & muensterTPCEventData::eStepLength)
+		pEventData->m_pStepLength->push_back(pStep->GetStepLength()/mm);
+
+	pEventData->m_iNbSteps++;
+
+	return true;
+}
+
+//******************************************************************/
+// StoreHit - hits collection of the visualization
+//******************************************************************/
+void muensterTPCLXeSensitiveDetector::StoreHit(G4Step *pStep)
+{
 	G4Track *pTrack = pStep->GetTrack();
 
 	muensterTPCLXeHit* pHit = new muensterTPCLXeHit();
 
 	pHit->SetTrackId(pTrack->GetTrackID());
 
-	if(!m_hParticleTypes.count(pTrack->GetTrackID()))
-		m_hParticleTypes[pTrack->GetTrackID()] = pTrack->GetDefinition()->GetParticleName();
+	m_hParticleTypes.insert(std::make_pair(pTrack->GetTrackID(), pTrack->GetDefinition()));
 
 	pHit->SetParentId(pTrack->GetParentID());
 	pHit->SetParticleType(pTrack->GetDefinition()->GetParticleName());
-
-	if(pTrack->GetParentID())
-		pHit->SetParentType(m_hParticleTypes[pTrack->GetParentID()]);
-	else
-		pHit->SetParentType(G4String("none"));
+	pHit->SetParentType(GetParentType(pTrack->GetParentID()));
 
 	if(pTrack->GetCreatorProcess())
 		pHit->SetCreatorProcess(pTrack->GetCreatorProcess()->GetProcessName());
@@ -71,13 +151,27 @@ G4bool muensterTPCLXeSensitiveDetector::ProcessHits(G4Step* pStep, G4TouchableHi
 
 	pHit->SetDepositingProcess(pStep->GetPostStepPoint()->GetProcessDefinedStep()->GetProcessName());
 	pHit->SetPosition(pStep->GetPostStepPoint()->GetPosition());
-	pHit->SetEnergyDeposited(dEnergyDeposited);
+	pHit->SetEnergyDeposited(pStep->GetTotalEnergyDeposit());
 	pHit->SetKineticEnergy(pTrack->GetKineticEnergy());
 	pHit->SetTime(pTrack->GetGlobalTime());
 
 	m_pLXeHitsCollection->insert(pHit);
+}
 
-	return true;
+//******************************************************************/
+// GetParentType - tracks without steps in the xenon have no type
+//******************************************************************/
+const G4String &muensterTPCLXeSensitiveDetector::GetParentType(G4int iParentId)
+{
+	static const G4String hNoParent("none");
+	static const G4String hUnknownParent("");
+
+	if(!iParentId)
+		return hNoParent;
+
+	map<int,const G4ParticleDefinition *>::const_iterator pParticleType = m_hParticleTypes.find(iParentId);
+
+	return (pParticleType != m_hParticleTypes.end())?(pParticleType->second->GetParticleName()):(hUnknownParent);
 }
 
 void muensterTPCLXeSensitiveDetector::EndOfEvent(G4HCofThisEvent *pHitsCollectionOfThisEvent)
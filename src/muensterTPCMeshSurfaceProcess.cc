@@ -0,0 +1,99 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Zero-thickness optical model of the grid meshes
+ *
+ * @comment
+ ******************************************************************/
+#include <G4Track.hh>
+#include <G4Step.hh>
+#include <G4StepPoint.hh>
+#include <G4Material.hh>
+#include <G4MaterialPropertiesTable.hh>
+#include <G4OpticalPhoton.hh>
+#include <Randomize.hh>
+
+#include <cmath>
+
+#include "muensterTPCMeshSurfaceProcess.hh"
+
+std::vector<muensterTPCMeshSurfaceProcess::MeshPlane> muensterTPCMeshSurfaceProcess::m_hMeshPlanes;
+
+muensterTPCMeshSurfaceProcess::muensterTPCMeshSurfaceProcess(const G4String &hProcessName):
+	G4VDiscreteProcess(hProcessName, fOptical)
+{
+}
+
+muensterTPCMeshSurfaceProcess::~muensterTPCMeshSurfaceProcess()
+{
+}
+
+void muensterTPCMeshSurfaceProcess::SetMeshPlanes(const std::vector<MeshPlane> &hMeshPlanes)
+{
+	m_hMeshPlanes = hMeshPlanes;
+}
+
+G4bool muensterTPCMeshSurfaceProcess::IsApplicable(const G4ParticleDefinition &hParticle)
+{
+	return (&hParticle == G4OpticalPhoton::OpticalPhoton());
+}
+
+G4double muensterTPCMeshSurfaceProcess::GetMeanFreePath(const G4Track &, G4double, G4ForceCondition *)
+{
+	return DBL_MAX;
+}
+
+G4double muensterTPCMeshSurfaceProcess::PostStepGetPhysicalInteractionLength(const G4Track &, G4double, G4ForceCondition *pCondition)
+{
+	// never limits the step, but looks at every step if there are meshes
+	*pCondition = (m_hMeshPlanes.empty())?(NotForced):(StronglyForced);
+
+	return DBL_MAX;
+}
+
+G4VParticleChange* muensterTPCMeshSurfaceProcess::PostStepDoIt(const G4Track &hTrack, const G4Step &hStep)
+{
+	aParticleChange.Initialize(hTrack);
+
+	// already absorbed or detected by another process
+	if(hTrack.GetTrackStatus() == fStopAndKill)
+		return &aParticleChange;
+
+	const G4ThreeVector &hPreStepPosition = hStep.GetPreStepPoint()->GetPosition();
+	const G4ThreeVector &hPostStepPosition = hStep.GetPostStepPoint()->GetPosition();
+	const G4double dDeltaZ = hPostStepPosition.z()-hPreStepPosition.z();
+
+	if(dDeltaZ == 0.)
+		return &aParticleChange;
+
+	const G4double dAbsCosTheta = std::fabs(dDeltaZ)/hStep.GetStepLength();
+	const G4double dPhotonMomentum = hTrack.GetDynamicParticle()->GetTotalMomentum();
+
+	G4double dTransmission = 1.;
+	for(size_t i=0; i<m_hMeshPlanes.size(); i++)
+	{
+		const MeshPlane &hPlane = m_hMeshPlanes[i];
+
+		// crossing of the plane within the mesh radius
+		const G4double dFraction = (hPlane.dZ-hPreStepPosition.z())/dDeltaZ;
+		if(dFraction <= 0. || dFraction > 1.)
+			continue;
+
+		const G4ThreeVector hCrossing = hPreStepPosition + dFraction*(hPostStepPosition-hPreStepPosition);
+		if(hCrossing.perp() > hPlane.dRadius)
+			continue;
+
+		G4MaterialPropertiesTable *pPropertiesTable = hPlane.pMaterial->GetMaterialPropertiesTable();
+		G4MaterialPropertyVector *pAbsorptionLength = (pPropertiesTable)?(pPropertiesTable->GetProperty("ABSLENGTH")):(0);
+		if(!pAbsorptionLength)
+			continue;
+
+		dTransmission *= std::exp(-hPlane.dThickness/(dAbsCosTheta*pAbsorptionLength->Value(dPhotonMomentum)));
+	}
+
+	if(dTransmission < 1. && G4UniformRand() >= dTransmission)
+		aParticleChange.ProposeTrackStatus(fStopAndKill);
+
+	return &aParticleChange;
+}
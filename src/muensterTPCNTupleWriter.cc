@@ -0,0 +1,253 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * RNTuple output of the event data
+ *
+ * @comment
+ ******************************************************************/
+#include <TDirectory.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "muensterTPCNTupleWriter.hh"
+#include "muensterTPCEventData.hh"
+
+#ifdef MUENSTERTPC_USE_RNTUPLE
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,36,0)
+using ROOT::RField;
+using ROOT::RFieldBase;
+using ROOT::RNTupleModel;
+using ROOT::RNTupleWriter;
+using ROOT::RNTupleWriteOptions;
+using ROOT::RRecordField;
+using ROOT::RVectorField;
+#else
+using ROOT::Experimental::RField;
+using ROOT::Experimental::RFieldBase;
+using ROOT::Experimental::RNTupleModel;
+using ROOT::Experimental::RNTupleWriter;
+using ROOT::Experimental::RNTupleWriteOptions;
+using ROOT::Experimental::RRecordField;
+using ROOT::Experimental::RVectorField;
+#endif
+#endif
+
+muensterTPCNTupleWriter::muensterTPCNTupleWriter(muensterTPCEventData *pEventData, TDirectory *pDirectory, G4int iCompressionSetting) {
+	m_pEventData = pEventData;
+	m_lStepSize = 0;
+	m_iNbStepRecords = 0;
+
+#ifdef MUENSTERTPC_USE_RNTUPLE
+	// the bare model has no default entry, the fields are bound to the event record
+	std::unique_ptr<RNTupleModel> pModel = RNTupleModel::CreateBare();
+
+	// event
+	pModel->MakeField<int>("eventid");
+	pModel->MakeField<int>("ntpmthits");
+	pModel->MakeField<int>("nbpmthits");
+	pModel->MakeField<std::vector<int> >("pmthits");
+	pModel->MakeField<float>("etot");
+	pModel->MakeField<int>("nsteps");
+
+	// waveforms
+	if(pEventData->HasWaveforms())
+	{
+		pModel->MakeField<std::vector<int> >("wfpmt");
+		pModel->MakeField<std::vector<int> >("wfbin");
+		pModel->MakeField<std::vector<float> >("wfamp");
+	}
+
+	// steps, one record of the selected step fields per step
+	std::vector<std::unique_ptr<RFieldBase> > hStepFields;
+	std::size_t lMaxAlignment = 1;
+
+	for(G4int iBit=0; iBit<muensterTPCEventData::eNbStepFields; iBit++)
+	{
+		if(!pEventData->HasStepField(1<<iBit))
+			continue;
+
+		StepMember hMember = {0, 0, 0, 0};
+		switch(1<<iBit)
+		{
+			case muensterTPCEventData::eStepTrackId: hMember.pInts = pEventData->m_pTrackId; break;
+			case muensterTPCEventData::eStepParentId: hMember.pInts = pEventData->m_pParentId; break;
+			case muensterTPCEventData::eStepType: hMember.pStrings = pEventData->m_pParticleType; break;
+			case muensterTPCEventData::eStepParentType: hMember.pStrings = pEventData->m_pParentType; break;
+			case muensterTPCEventData::eStepCreatorProcess: hMember.pStrings = pEventData->m_pCreatorProcess; break;
+			case muensterTPCEventData::eStepDepositingProcess: hMember.pStrings = pEventData->m_pDepositingProcess; break;
+			case muensterTPCEventData::eStepX: hMember.pFloats = pEventData->m_pX; break;
+			case muensterTPCEventData::eStepY: hMember.pFloats = pEventData->m_pY; break;
+			case muensterTPCEventData::eStepZ: hMember.pFloats = pEventData->m_pZ; break;
+			case muensterTPCEventData::eStepEnergyDeposited: hMember.pFloats = pEventData->m_pEnergyDeposited; break;
+			case muensterTPCEventData::eStepTime: hMember.pFloats = pEventData->m_pTime; break;
+			case muensterTPCEventData::eStepKineticEnergy: hMember.pFloats = pEventData->m_pKineticEnergy; break;
+			case muensterTPCEventData::eStepLength: hMember.pFloats = pEventData->m_pStepLength; break;
+		}
+
+		const char *szName = muensterTPCEventData::GetStepFieldName(iBit);
+		std::unique_ptr<RFieldBase> pField;
+		if(hMember.pInts)
+			pField = std::make_unique<RField<int> >(szName);
+		else if(hMember.pFloats)
+			pField = std::make_unique<RField<float> >(szName);
+		else
+			pField = std::make_unique<RField<std::string> >(szName);
+
+		// members are padded to their alignment as in the record field
+		const std::size_t lAlignment = pField->GetAlignment();
+		lMaxAlignment = std::max(lMaxAlignment, lAlignment);
+		m_lStepSize += (lAlignment - m_lStepSize%lAlignment)%lAlignment;
+		hMember.lOffset = m_lStepSize;
+		m_lStepSize += pField->GetValueSize();
+
+		m_hStepMembers.push_back(hMember);
+		hStepFields.push_back(std::move(pField));
+	}
+	m_lStepSize += (lMaxAlignment - m_lStepSize%lMaxAlignment)%lMaxAlignment;
+
+	if(!m_hStepMembers.empty())
+	{
+		std::unique_ptr<RRecordField> pStep = std::make_unique<RRecordField>("_0", std::move(hStepFields));
+		if(pStep->GetValueSize() != m_lStepSize)
+		{
+			G4cout << "!!!!> rntuple step record of " << pStep->GetValueSize() << " bytes, expected " << m_lStepSize << " bytes!" << G4endl;
+			exit(-1);
+		}
+		pModel->AddField(std::make_unique<RVectorField>("steps", std::move(pStep)));
+	}
+
+	// primary
+	pModel->MakeField<std::vector<std::string> >("type_pri");
+	pModel->MakeField<float>("e_pri");
+	pModel->MakeField<float>("xp_pri");
+	pModel->MakeField<float>("yp_pri");
+	pModel->MakeField<float>("zp_pri");
+
+	RNTupleWriteOptions hOptions;
+	if(iCompressionSetting != -1)
+		hOptions.SetCompression(iCompressionSetting);
+
+	m_pWriter = RNTupleWriter::Append(std::move(pModel), "events", *pDirectory, hOptions);
+	m_pEntry = m_pWriter->CreateEntry();
+
+	m_pEntry->BindRawPtr("eventid", &pEventData->m_iEventId);
+	m_pEntry->BindRawPtr("ntpmthits", &pEventData->m_iNbTopPmtHits);
+	m_pEntry->BindRawPtr("nbpmthits", &pEventData->m_iNbBottomPmtHits);
+	m_pEntry->BindRawPtr("pmthits", pEventData->m_pPmtHits);
+	m_pEntry->BindRawPtr("etot", &pEventData->m_fTotalEnergyDeposited);
+	m_pEntry->BindRawPtr("nsteps", &pEventData->m_iNbSteps);
+
+	if(pEventData->HasWaveforms())
+	{
+		m_pEntry->BindRawPtr("wfpmt", pEventData->m_pWaveformPmt);
+		m_pEntry->BindRawPtr("wfbin", pEventData->m_pWaveformBin);
+		m_pEntry->BindRawPtr("wfamp", pEventData->m_pWaveformAmplitude);
+	}
+
+	// the untyped collection takes the buffer as its std::vector<char>
+	if(!m_hStepMembers.empty())
+		m_pEntry->BindRawPtr("steps", static_cast<void *>(&m_hSteps));
+
+	m_pEntry->BindRawPtr("type_pri", pEventData->m_pPrimaryParticleType);
+	m_pEntry->BindRawPtr("e_pri", &pEventData->m_fPrimaryEnergy);
+	m_pEntry->BindRawPtr("xp_pri", &pEventData->m_fPrimaryX);
+	m_pEntry->BindRawPtr("yp_pri", &pEventData->m_fPrimaryY);
+	m_pEntry->BindRawPtr("zp_pri", &pEventData->m_fPrimaryZ);
+#endif
+}
+
+muensterTPCNTupleWriter::~muensterTPCNTupleWriter() {
+	Close();
+}
+
+//******************************************************************/
+// Fill
+//******************************************************************/
+void muensterTPCNTupleWriter::Fill() {
+#ifdef MUENSTERTPC_USE_RNTUPLE
+	FillSteps();
+	m_pWriter->Fill(*m_pEntry);
+	m_lNbEntries++;
+#endif
+}
+
+//******************************************************************/
+// Close
+//******************************************************************/
+void muensterTPCNTupleWriter::Close() {
+#ifdef MUENSTERTPC_USE_RNTUPLE
+	m_pEntry.reset();
+	m_pWriter.reset();
+#endif
+	ResizeSteps(0);
+}
+
+//******************************************************************/
+// FillSteps
+//******************************************************************/
+void muensterTPCNTupleWriter::FillSteps() {
+	const G4int iNbSteps = (m_hStepMembers.empty())?(0):(m_pEventData->m_iNbSteps);
+
+	ResizeSteps(iNbSteps);
+
+	for(G4int i=0; i<iNbSteps; i++)
+	{
+		char *pRecord = m_hSteps.data() + i*m_lStepSize;
+
+		for(std::size_t j=0; j<m_hStepMembers.size(); j++)
+		{
+			const StepMember &hMember = m_hStepMembers[j];
+
+			if(hMember.pInts)
+				std::memcpy(pRecord + hMember.lOffset, &(*hMember.pInts)[i], sizeof(int));
+			else if(hMember.pFloats)
+				std::memcpy(pRecord + hMember.lOffset, &(*hMember.pFloats)[i], sizeof(float));
+			else
+				*reinterpret_cast<std::string *>(pRecord + hMember.lOffset) = (*hMember.pStrings)[i];
+		}
+	}
+}
+
+//******************************************************************/
+// ResizeSteps
+//******************************************************************/
+void muensterTPCNTupleWriter::ResizeSteps(G4int iNbSteps) {
+	const std::size_t lSize = iNbSteps*m_lStepSize;
+
+	// the strings cannot be moved bytewise, they are destroyed before the buffer grows
+	if(lSize > m_hSteps.capacity())
+	{
+		ResizeSteps(0);
+		m_hSteps.reserve(lSize + lSize/2);
+	}
+
+	for(G4int i=iNbSteps; i<m_iNbStepRecords; i++)
+		for(std::size_t j=0; j<m_hStepMembers.size(); j++)
+			if(m_hStepMembers[j].pStrings)
+				reinterpret_cast<std::string *>(m_hSteps.data() + i*m_lStepSize + m_hStepMembers[j].lOffset)->~basic_string();
+
+	m_hSteps.resize(lSize);
+
+	for(G4int i=m_iNbStepRecords; i<iNbSteps; i++)
+		for(std::size_t j=0; j<m_hStepMembers.size(); j++)
+			if(m_hStepMembers[j].pStrings)
+				new(m_hSteps.data() + i*m_lStepSize + m_hStepMembers[j].lOffset) std::string();
+
+	m_iNbStepRecords = iNbSteps;
+}
+
+//******************************************************************/
+// IsAvailable
+//******************************************************************/
+G4bool muensterTPCNTupleWriter::IsAvailable() {
+#ifdef MUENSTERTPC_USE_RNTUPLE
+	return true;
+#else
+	return false;
+#endif
+}
+
@@ -0,0 +1,449 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Optical boundary process with tabulated angular response
+ *
+ * @comment
+ ******************************************************************/
+#include <G4Track.hh>
+#include <G4Step.hh>
+#include <G4StepPoint.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4LogicalBorderSurface.hh>
+#include <G4OpticalSurface.hh>
+#include <G4Navigator.hh>
+#include <G4TransportationManager.hh>
+#include <G4ParallelWorldProcess.hh>
+#include <G4GeometryTolerance.hh>
+#include <G4PhysicalConstants.hh>
+#include <Randomize.hh>
+#include <G4ios.hh>
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+
+#include "muensterTPCOpBoundaryProcess.hh"
+
+using std::vector;
+using std::map;
+
+muensterTPCOpBoundaryProcess::muensterTPCOpBoundaryProcess(const G4String &hMode, const G4String &hTableFilename, const G4String &hProcessName):
+	G4OpBoundaryProcess(hProcessName)
+{
+	m_hMode = hMode;
+	m_hTableFilename = hTableFilename;
+	m_bTablesRead = false;
+
+	m_iNbCosInBins = 20;
+	m_iNbCosOutBins = 40;
+	m_iNbPhiBins = 36;
+	m_iNbCells = m_iNbCosOutBins*m_iNbPhiBins;
+
+	// the surfaces with a tabulated response (see DetectorConstruction)
+	const G4String hSurfaceNames[] = {"TeflonOpticalSurface", "GXeTeflonOpticalSurface", "SS304LSteelOpticalSurface"};
+
+	for(G4int iSurface = 0; iSurface < 3; iSurface++)
+	{
+		BoundaryResponse &hResponse = m_hResponses[hSurfaceNames[iSurface]];
+
+		hResponse.hSurfaceName = hSurfaceNames[iSurface];
+		hResponse.hCounts.assign(m_iNbCosInBins*(m_iNbCells+1), 0.);
+		hResponse.hEntries.assign(m_iNbCosInBins, 0.);
+		hResponse.hProbability.assign(m_iNbCosInBins*(m_iNbCells+1), 0.);
+		hResponse.hAlias.assign(m_iNbCosInBins*(m_iNbCells+1), 0);
+		hResponse.hValidationModel.assign(m_iNbCosOutBins+1, 0.);
+		hResponse.hValidationTable.assign(m_iNbCosOutBins+1, 0.);
+	}
+
+	G4cout << "muensterTPCOpBoundaryProcess: boundary model " << m_hMode << ", table " << m_hTableFilename << G4endl;
+}
+
+muensterTPCOpBoundaryProcess::~muensterTPCOpBoundaryProcess()
+{
+}
+
+G4VParticleChange*
+muensterTPCOpBoundaryProcess::PostStepDoIt(const G4Track &hTrack, const G4Step &hStep)
+{
+	if(!m_bTablesRead && m_hMode != "record")
+		ReadTables();
+
+	// only boundaries with a tabulated surface are treated here
+	BoundaryResponse *pResponse = 0;
+	G4ThreeVector hNormal;
+
+	if(hStep.GetPostStepPoint()->GetStepStatus() == fGeomBoundary
+		&& hStep.GetStepLength() > 0.5*G4GeometryTolerance::GetInstance()->GetSurfaceTolerance())
+	{
+		pResponse = GetResponse(hStep);
+
+		if(pResponse && !GetSurfaceNormal(hStep, hNormal))
+			pResponse = 0;
+	}
+
+	if(!pResponse)
+		return G4OpBoundaryProcess::PostStepDoIt(hTrack, hStep);
+
+	// local frame: normal against the incoming photon, t1 along the incidence plane
+	const G4ThreeVector hOldMomentum = hTrack.GetMomentumDirection();
+	const G4double dCosIn = -hOldMomentum.dot(hNormal);
+
+	G4ThreeVector hT1 = hOldMomentum + dCosIn*hNormal;
+	hT1 = (hT1.mag2() > 1e-12)?(hT1.unit()):(hNormal.orthogonal().unit());
+	const G4ThreeVector hT2 = hNormal.cross(hT1);
+
+	const G4int iCosIn = GetCosInBin(dCosIn);
+
+	if(m_hMode == "tabulated" && pResponse->hEntries[iCosIn] > 0.)
+	{
+		aParticleChange.Initialize(hTrack);
+
+		G4int iCell = SampleCell(pResponse, iCosIn);
+
+		if(iCell == m_iNbCells)
+		{
+			aParticleChange.ProposeTrackStatus(fStopAndKill);
+			return &aParticleChange;
+		}
+
+		G4ThreeVector hNewMomentum = GetDirection(iCell, hNormal, hT1, hT2);
+		G4ThreeVector hNewPolarization = hTrack.GetPolarization() - hTrack.GetPolarization().dot(hNewMomentum)*hNewMomentum;
+		hNewPolarization = (hNewPolarization.mag2() > 1e-12)?(hNewPolarization.unit()):(hNewMomentum.orthogonal().unit());
+
+		aParticleChange.ProposeMomentumDirection(hNewMomentum);
+		aParticleChange.ProposePolarization(hNewPolarization);
+
+		return &aParticleChange;
+	}
+
+	// standard physics, the outcome is recorded or compared with the table
+	G4VParticleChange *pParticleChange = G4OpBoundaryProcess::PostStepDoIt(hTrack, hStep);
+
+	G4int iCell = -1;
+	if(aParticleChange.GetTrackStatus() == fStopAndKill)
+		iCell = m_iNbCells;
+	else if(aParticleChange.GetMomentumDirection()->dot(hNormal) > 0.)
+		iCell = GetCell(*aParticleChange.GetMomentumDirection(), hNormal, hT1, hT2);
+
+	// transmissions are not part of the tables
+	if(iCell < 0)
+		return pParticleChange;
+
+	if(m_hMode == "record")
+	{
+		pResponse->hCounts[iCosIn*(m_iNbCells+1) + iCell] += 1.;
+		pResponse->hEntries[iCosIn] += 1.;
+	}
+	else if(m_hMode == "validate" && pResponse->hEntries[iCosIn] > 0.)
+	{
+		pResponse->hValidationModel[(iCell == m_iNbCells)?(m_iNbCosOutBins):(iCell/m_iNbPhiBins)] += 1.;
+
+		G4int iTableCell = SampleCell(pResponse, iCosIn);
+		pResponse->hValidationTable[(iTableCell == m_iNbCells)?(m_iNbCosOutBins):(iTableCell/m_iNbPhiBins)] += 1.;
+	}
+
+	return pParticleChange;
+}
+
+void
+muensterTPCOpBoundaryProcess::EndOfRun()
+{
+	if(m_hMode == "record")
+		WriteTables();
+	else if(m_hMode == "validate")
+		PrintValidation();
+}
+
+muensterTPCOpBoundaryProcess::BoundaryResponse *
+muensterTPCOpBoundaryProcess::GetResponse(const G4Step &hStep)
+{
+	G4LogicalBorderSurface *pBorderSurface = G4LogicalBorderSurface::GetSurface(hStep.GetPreStepPoint()->GetPhysicalVolume(),
+		hStep.GetPostStepPoint()->GetPhysicalVolume());
+
+	if(!pBorderSurface)
+		return 0;
+
+	const G4SurfaceProperty *pSurface = pBorderSurface->GetSurfaceProperty();
+
+	map<const G4SurfaceProperty *, BoundaryResponse *>::iterator pIt = m_hSurfaceCache.find(pSurface);
+	if(pIt != m_hSurfaceCache.end())
+		return pIt->second;
+
+	// first time this surface is hit
+	BoundaryResponse *pResponse = 0;
+	map<G4String, BoundaryResponse>::iterator pResponseIt = m_hResponses.find(pSurface->GetName());
+	if(pResponseIt != m_hResponses.end())
+		pResponse = &(pResponseIt->second);
+
+	m_hSurfaceCache[pSurface] = pResponse;
+
+	return pResponse;
+}
+
+G4bool
+muensterTPCOpBoundaryProcess::GetSurfaceNormal(const G4Step &hStep, G4ThreeVector &hNormal)
+{
+	// same normal as used by G4OpBoundaryProcess
+	G4bool bValid = false;
+	G4int iNavigatorId = G4ParallelWorldProcess::GetHypNavigatorID();
+	std::vector<G4Navigator*>::iterator pNavigator = G4TransportationManager::GetTransportationManager()->GetActiveNavigatorsIterator();
+
+	hNormal = (pNavigator[iNavigatorId])->GetGlobalExitNormal(hStep.GetPostStepPoint()->GetPosition(), &bValid);
+
+	if(!bValid)
+		return false;
+
+	if(hStep.GetPostStepPoint()->GetMomentumDirection().dot(hNormal) > 0.)
+		hNormal = -hNormal;
+
+	return true;
+}
+
+G4int
+muensterTPCOpBoundaryProcess::GetCosInBin(G4double dCosIn)
+{
+	G4int iBin = (G4int) (dCosIn*m_iNbCosInBins);
+
+	return (iBin < 0)?(0):((iBin >= m_iNbCosInBins)?(m_iNbCosInBins-1):(iBin));
+}
+
+G4int
+muensterTPCOpBoundaryProcess::GetCell(const G4ThreeVector &hDirection, const G4ThreeVector &hNormal, const G4ThreeVector &hT1, const G4ThreeVector &hT2)
+{
+	G4int iCosOut = (G4int) (hDirection.dot(hNormal)*m_iNbCosOutBins);
+	iCosOut = (iCosOut >= m_iNbCosOutBins)?(m_iNbCosOutBins-1):(iCosOut);
+
+	G4double dPhi = std::atan2(hDirection.dot(hT2), hDirection.dot(hT1));
+	G4int iPhi = (G4int) ((dPhi + pi)/twopi*m_iNbPhiBins);
+	iPhi = (iPhi >= m_iNbPhiBins)?(m_iNbPhiBins-1):(iPhi);
+
+	return iCosOut*m_iNbPhiBins + iPhi;
+}
+
+G4int
+muensterTPCOpBoundaryProcess::SampleCell(BoundaryResponse *pResponse, G4int iCosIn)
+{
+	// Walker alias method, one uniform cell and one acceptance test
+	const G4int iOffset = iCosIn*(m_iNbCells+1);
+	G4int iCell = (G4int) (G4UniformRand()*(m_iNbCells+1));
+	iCell = (iCell > m_iNbCells)?(m_iNbCells):(iCell);
+
+	if(G4UniformRand() < pResponse->hProbability[iOffset + iCell])
+		return iCell;
+	else
+		return pResponse->hAlias[iOffset + iCell];
+}
+
+G4ThreeVector
+muensterTPCOpBoundaryProcess::GetDirection(G4int iCell, const G4ThreeVector &hNormal, const G4ThreeVector &hT1, const G4ThreeVector &hT2)
+{
+	// uniform within the cell
+	G4int iCosOut = iCell/m_iNbPhiBins;
+	G4int iPhi = iCell%m_iNbPhiBins;
+
+	G4double dCosOut = (iCosOut + G4UniformRand())/m_iNbCosOutBins;
+	G4double dSinOut = std::sqrt(1. - dCosOut*dCosOut);
+	G4double dPhi = -pi + (iPhi + G4UniformRand())*twopi/m_iNbPhiBins;
+
+	return (dCosOut*hNormal + dSinOut*(std::cos(dPhi)*hT1 + std::sin(dPhi)*hT2)).unit();
+}
+
+void
+muensterTPCOpBoundaryProcess::BuildAliasTables(BoundaryResponse *pResponse)
+{
+	const G4int iNbCells = m_iNbCells+1;
+
+	for(G4int iCosIn = 0; iCosIn < m_iNbCosInBins; iCosIn++)
+	{
+		const G4int iOffset = iCosIn*iNbCells;
+
+		G4double dTotal = 0.;
+		for(G4int iCell = 0; iCell < iNbCells; iCell++)
+			dTotal += pResponse->hCounts[iOffset + iCell];
+
+		pResponse->hEntries[iCosIn] = dTotal;
+		if(dTotal <= 0.)
+			continue;
+
+		vector<G4double> hScaled(iNbCells);
+		vector<G4int> hSmall, hLarge;
+
+		for(G4int iCell = 0; iCell < iNbCells; iCell++)
+		{
+			hScaled[iCell] = pResponse->hCounts[iOffset + iCell]*iNbCells/dTotal;
+			if(hScaled[iCell] < 1.)
+				hSmall.push_back(iCell);
+			else
+				hLarge.push_back(iCell);
+		}
+
+		while(!hSmall.empty() && !hLarge.empty())
+		{
+			G4int iSmall = hSmall.back(); hSmall.pop_back();
+			G4int iLarge = hLarge.back(); hLarge.pop_back();
+
+			pResponse->hProbability[iOffset + iSmall] = hScaled[iSmall];
+			pResponse->hAlias[iOffset + iSmall] = iLarge;
+
+			hScaled[iLarge] = (hScaled[iLarge] + hScaled[iSmall]) - 1.;
+			if(hScaled[iLarge] < 1.)
+				hSmall.push_back(iLarge);
+			else
+				hLarge.push_back(iLarge);
+		}
+
+		// numerical leftovers are accepted with probability one
+		for(size_t i = 0; i < hLarge.size(); i++)
+		{
+			pResponse->hProbability[iOffset + hLarge[i]] = 1.;
+			pResponse->hAlias[iOffset + hLarge[i]] = hLarge[i];
+		}
+		for(size_t i = 0; i < hSmall.size(); i++)
+		{
+			pResponse->hProbability[iOffset + hSmall[i]] = 1.;
+			pResponse->hAlias[iOffset + hSmall[i]] = hSmall[i];
+		}
+	}
+}
+
+void
+muensterTPCOpBoundaryProcess::ReadTables()
+{
+	m_bTablesRead = true;
+
+	std::ifstream hIn(m_hTableFilename.c_str());
+
+	if(!hIn.is_open())
+	{
+		G4cout << "muensterTPCOpBoundaryProcess: could not open " << m_hTableFilename
+			<< ", using the standard boundary process." << G4endl;
+		return;
+	}
+
+	G4String hLine;
+	BoundaryResponse *pResponse = 0;
+
+	while(std::getline(hIn, hLine))
+	{
+		if(hLine.empty() || hLine[0] == '#')
+			continue;
+
+		std::stringstream hStream(hLine);
+
+		if(hLine.substr(0, 7) == "surface")
+		{
+			G4String hKeyword, hSurfaceName;
+			G4int iNbCosInBins = 0, iNbCosOutBins = 0, iNbPhiBins = 0;
+
+			hStream >> hKeyword >> hSurfaceName >> iNbCosInBins >> iNbCosOutBins >> iNbPhiBins;
+
+			pResponse = 0;
+			if(m_hResponses.count(hSurfaceName) && iNbCosInBins == m_iNbCosInBins
+				&& iNbCosOutBins == m_iNbCosOutBins && iNbPhiBins == m_iNbPhiBins)
+				pResponse = &m_hResponses[hSurfaceName];
+			else
+				G4cout << "muensterTPCOpBoundaryProcess: ignoring table of " << hSurfaceName << G4endl;
+
+			continue;
+		}
+
+		if(!pResponse)
+			continue;
+
+		G4int iCosIn = -1;
+		hStream >> iCosIn;
+
+		if(iCosIn < 0 || iCosIn >= m_iNbCosInBins)
+			continue;
+
+		for(G4int iCell = 0; iCell <= m_iNbCells; iCell++)
+			hStream >> pResponse->hCounts[iCosIn*(m_iNbCells+1) + iCell];
+	}
+
+	for(map<G4String, BoundaryResponse>::iterator pIt = m_hResponses.begin(); pIt != m_hResponses.end(); pIt++)
+	{
+		BuildAliasTables(&(pIt->second));
+
+		G4double dEntries = 0.;
+		for(G4int iCosIn = 0; iCosIn < m_iNbCosInBins; iCosIn++)
+			dEntries += pIt->second.hEntries[iCosIn];
+
+		G4cout << "muensterTPCOpBoundaryProcess: " << pIt->first << " table with " << dEntries << " entries" << G4endl;
+	}
+}
+
+void
+muensterTPCOpBoundaryProcess::WriteTables()
+{
+	std::ofstream hOut(m_hTableFilename.c_str());
+
+	hOut << "# muensterTPCsim optical boundary response" << std::endl;
+	hOut << "# surface <name> <cos theta in bins> <cos theta out bins> <phi bins>" << std::endl;
+	hOut << "# <cos theta in bin> <counts per (cos theta out, phi) cell> <absorbed>" << std::endl;
+
+	for(map<G4String, BoundaryResponse>::iterator pIt = m_hResponses.begin(); pIt != m_hResponses.end(); pIt++)
+	{
+		hOut << "surface " << pIt->first << " " << m_iNbCosInBins << " " << m_iNbCosOutBins << " " << m_iNbPhiBins << std::endl;
+
+		for(G4int iCosIn = 0; iCosIn < m_iNbCosInBins; iCosIn++)
+		{
+			hOut << iCosIn;
+			for(G4int iCell = 0; iCell <= m_iNbCells; iCell++)
+				hOut << " " << pIt->second.hCounts[iCosIn*(m_iNbCells+1) + iCell];
+			hOut << std::endl;
+		}
+	}
+
+	hOut.close();
+
+	G4cout << "muensterTPCOpBoundaryProcess: boundary response written to " << m_hTableFilename << G4endl;
+}
+
+void
+muensterTPCOpBoundaryProcess::PrintValidation()
+{
+	G4cout << "================================================================" << G4endl;
+	G4cout << "Boundary response validation (standard model vs. table)" << G4endl;
+
+	for(map<G4String, BoundaryResponse>::iterator pIt = m_hResponses.begin(); pIt != m_hResponses.end(); pIt++)
+	{
+		const vector<G4double> &hModel = pIt->second.hValidationModel;
+		const vector<G4double> &hTable = pIt->second.hValidationTable;
+
+		G4double dNbModel = 0., dNbTable = 0.;
+		for(G4int iBin = 0; iBin <= m_iNbCosOutBins; iBin++)
+		{
+			dNbModel += hModel[iBin];
+			dNbTable += hTable[iBin];
+		}
+
+		if(dNbModel <= 0. || dNbTable <= 0.)
+		{
+			G4cout << pIt->first << ": no interactions" << G4endl;
+			continue;
+		}
+
+		// chi2 of two histograms with (almost) the same number of entries
+		G4double dChi2 = 0.;
+		G4int iNdf = 0;
+		for(G4int iBin = 0; iBin <= m_iNbCosOutBins; iBin++)
+		{
+			if(hModel[iBin] + hTable[iBin] > 0.)
+			{
+				dChi2 += std::pow(hModel[iBin] - hTable[iBin], 2)/(hModel[iBin] + hTable[iBin]);
+				iNdf++;
+			}
+		}
+
+		G4cout << pIt->first << ": " << dNbModel << " interactions"
+			<< " || absorbed model " << std::setprecision(4) << hModel[m_iNbCosOutBins]/dNbModel
+			<< " table " << hTable[m_iNbCosOutBins]/dNbTable
+			<< " || cos theta out chi2/ndf " << dChi2 << "/" << iNdf-1 << G4endl;
+	}
+
+	G4cout << "================================================================" << G4endl;
+}
+
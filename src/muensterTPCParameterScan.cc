@@ -0,0 +1,116 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Parameter scan over run time settings within one process
+ *
+ * @comment
+ ******************************************************************/
+#include <G4UImanager.hh>
+#include <G4UIcommandStatus.hh>
+
+#include <sstream>
+#include <iomanip>
+
+#include "muensterTPCParameterScan.hh"
+#include "muensterTPCParameterScanMessenger.hh"
+#include "muensterTPCAnalysisManager.hh"
+
+muensterTPCParameterScan::muensterTPCParameterScan(muensterTPCAnalysisManager *pAnalysisManager) {
+	m_pAnalysisManager = pAnalysisManager;
+
+	m_pMessenger = new muensterTPCParameterScanMessenger(this);
+}
+
+muensterTPCParameterScan::~muensterTPCParameterScan() {
+	delete m_pMessenger;
+}
+
+//******************************************************************/
+// AddParameter
+//******************************************************************/
+void muensterTPCParameterScan::AddParameter(const G4String &hCommand, const vector<G4String> &hValues) {
+	ScanParameter hParameter;
+	hParameter.hCommand = hCommand;
+	hParameter.hValues = hValues;
+
+	m_hParameters.push_back(hParameter);
+
+	G4cout << "----> Scan parameter " << hCommand << " with " << hValues.size() << " values, "
+	       << GetNbPoints() << " points in total" << G4endl;
+}
+
+//******************************************************************/
+// Clear
+//******************************************************************/
+void muensterTPCParameterScan::Clear() {
+	m_hParameters.clear();
+}
+
+//******************************************************************/
+// GetNbPoints
+//******************************************************************/
+G4int muensterTPCParameterScan::GetNbPoints() {
+	if(m_hParameters.empty())
+		return 0;
+
+	G4int iNbPoints = 1;
+	for(G4int i=0; i<(G4int) m_hParameters.size(); i++)
+		iNbPoints *= m_hParameters[i].hValues.size();
+
+	return iNbPoints;
+}
+
+//******************************************************************/
+// BeamOn
+//******************************************************************/
+void muensterTPCParameterScan::BeamOn(G4int iNbEventsPerPoint) {
+	G4UImanager *pUImanager = G4UImanager::GetUIpointer();
+
+	const G4int iNbPoints = GetNbPoints();
+	if(!iNbPoints)
+	{
+		G4cout << "--> warning from ParameterScan::BeamOn : no parameters to scan" << G4endl;
+		return;
+	}
+
+	std::stringstream hStream;
+	for(G4int iPoint=0; iPoint<iNbPoints; iPoint++)
+	{
+		// the first parameter changes fastest
+		G4String hDescription;
+		G4int iIndex = iPoint;
+		for(G4int i=0; i<(G4int) m_hParameters.size(); i++)
+		{
+			const ScanParameter &hParameter = m_hParameters[i];
+			const G4String &hValue = hParameter.hValues[iIndex % hParameter.hValues.size()];
+			iIndex /= hParameter.hValues.size();
+
+			// only changes the material properties, surfaces etc. of the existing geometry
+			G4String hCommand = hParameter.hCommand + " " + hValue;
+			if(pUImanager->ApplyCommand(hCommand) != fCommandSucceeded)
+			{
+				G4cout << "--> warning from ParameterScan::BeamOn : " << hCommand << " failed, scan stopped" << G4endl;
+				m_pAnalysisManager->SetScanPoint("", "", false);
+				return;
+			}
+
+			hDescription += (i?"; ":"") + hCommand;
+		}
+
+		hStream.str("");
+		hStream << "point_" << std::setw(4) << std::setfill('0') << iPoint;
+
+		G4cout << "----> Scan point " << iPoint+1 << " of " << iNbPoints << ": " << hDescription << G4endl;
+
+		// the first point creates the output file, all others are added
+		m_pAnalysisManager->SetScanPoint(hStream.str(), hDescription, iPoint > 0);
+
+		hStream.str("");
+		hStream << "/run/beamOn " << iNbEventsPerPoint;
+		pUImanager->ApplyCommand(hStream.str());
+	}
+
+	m_pAnalysisManager->SetScanPoint("", "", false);
+}
+
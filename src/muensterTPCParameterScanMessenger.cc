@@ -0,0 +1,99 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Communications with the ParameterScan class
+ *
+ * @comment
+ ******************************************************************/
+
+#include <G4UIdirectory.hh>
+#include <G4UIcmdWithoutParameter.hh>
+#include <G4UIcmdWithAString.hh>
+#include <G4UIcmdWithAnInteger.hh>
+#include <G4ios.hh>
+
+#include <sstream>
+#include <cstdlib>
+
+#include "muensterTPCParameterScanMessenger.hh"
+#include "muensterTPCParameterScan.hh"
+
+muensterTPCParameterScanMessenger::muensterTPCParameterScanMessenger(muensterTPCParameterScan *pParameterScan):
+  m_pParameterScan(pParameterScan)
+{
+  // create directory
+  m_pDirectory = new G4UIdirectory("/Xe/scan/");
+  m_pDirectory->SetGuidance("Parameter scan control commands.");
+
+  // add a parameter to the scan grid
+  m_pAddParameterCmd = new G4UIcmdWithAString("/Xe/scan/addParameter", this);
+  m_pAddParameterCmd->SetGuidance("Add a command and its values to the scan grid, e.g.");
+  m_pAddParameterCmd->SetGuidance("/Xe/scan/addParameter /Xe/detector/setLXeAbsorbtionLength 50 100 200 cm");
+  m_pAddParameterCmd->SetGuidance("A unit at the end of the list is used for all values.");
+  m_pAddParameterCmd->SetParameterName("CommandAndValues", false);
+  m_pAddParameterCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  // remove all parameters
+  m_pClearCmd = new G4UIcmdWithoutParameter("/Xe/scan/clear", this);
+  m_pClearCmd->SetGuidance("Remove all parameters from the scan grid.");
+  m_pClearCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  // run all points of the grid
+  m_pBeamOnCmd = new G4UIcmdWithAnInteger("/Xe/scan/beamOn", this);
+  m_pBeamOnCmd->SetGuidance("Start one run per point of the scan grid.");
+  m_pBeamOnCmd->SetGuidance("Each point is written into its own directory of the output file.");
+  m_pBeamOnCmd->SetParameterName("NbEvents", false);
+  m_pBeamOnCmd->SetRange("NbEvents > 0");
+  m_pBeamOnCmd->AvailableForStates(G4State_Idle);
+}
+
+muensterTPCParameterScanMessenger::~muensterTPCParameterScanMessenger()
+{
+  delete m_pAddParameterCmd;
+  delete m_pClearCmd;
+  delete m_pBeamOnCmd;
+  delete m_pDirectory;
+}
+
+void muensterTPCParameterScanMessenger::SetNewValue(G4UIcommand *pUIcommand, G4String hNewValues)
+{
+  if(pUIcommand == m_pAddParameterCmd)
+  {
+    std::istringstream hStream(hNewValues);
+    G4String hCommand;
+    std::string hToken;
+    vector<G4String> hValues;
+
+    hStream >> hCommand;
+    while(hStream >> hToken)
+      hValues.push_back(hToken);
+
+    // a trailing unit belongs to all values
+    if(hValues.size() > 1)
+    {
+      const char *szLast = hValues.back().c_str();
+      char *pEnd = 0;
+      std::strtod(szLast, &pEnd);
+      if(pEnd == szLast)
+      {
+        G4String hUnit = hValues.back();
+        hValues.pop_back();
+        for(G4int i=0; i<(G4int) hValues.size(); i++)
+          hValues[i] += " " + hUnit;
+      }
+    }
+
+    if(hCommand.empty() || hValues.empty())
+      G4cout << "--> warning from ParameterScanMessenger : no values for " << hNewValues << G4endl;
+    else
+      m_pParameterScan->AddParameter(hCommand, hValues);
+  }
+
+  if(pUIcommand == m_pClearCmd)
+    m_pParameterScan->Clear();
+
+  if(pUIcommand == m_pBeamOnCmd)
+    m_pParameterScan->BeamOn(m_pBeamOnCmd->GetNewIntValue(hNewValues));
+}
+
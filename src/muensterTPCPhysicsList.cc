@@ -18,6 +18,11 @@
 #include <G4ParticleTable.hh>
 #include <G4HadronCaptureProcess.hh>
 #include <G4UserLimits.hh>
+#include <G4Region.hh>
+#include <G4RegionStore.hh>
+#include <G4ProductionCuts.hh>
+#include <G4StateManager.hh>
+#include <G4Version.hh>
 #include "G4UserSpecialCuts.hh"
 #include <G4ios.hh>
 #include <globals.hh>
@@ -26,6 +31,9 @@
 #include "G4PhysicsListHelper.hh"
 
 #include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
 
 #include <G4EmStandardPhysics.hh>
 #include <G4EmLivermorePhysics.hh>
@@ -33,6 +41,8 @@
 
 #include "muensterTPCPhysicsList.hh"
 #include "muensterTPCPhysicsMessenger.hh"
+#include "muensterTPCOpBoundaryProcess.hh"
+#include "muensterTPCMeshSurfaceProcess.hh"
 
 #include "G4VPhysicsConstructor.hh"
 #include "G4HadronPhysicsQGSP_BERT.hh"
@@ -47,16 +57,27 @@
 // Constructor /////////////////////////////////////////////////////////////
 muensterTPCPhysicsList::muensterTPCPhysicsList():G4VUserPhysicsList() {
 
-	defaultCutValue = 1.0 * mm;	//
+	// the default cuts apply to the lab, the TPC and cryostat get their own
+	defaultCutValue = 10.0 * mm;	//
 	cutForGamma = defaultCutValue;
 	cutForElectron = defaultCutValue;
 	cutForPositron = defaultCutValue;
 
+	m_dXenonRegionCut = 1.0 * mm;
+	m_dCryostatRegionCut = 5.0 * mm;
+
+	m_hRetrieveTablesDirectory = "";
+
 	VerboseLevel = 0;
 	OpVerbLevel = 0;
 
 	SetVerboseLevel(VerboseLevel);
 
+  emPhysicsList = 0;
+  m_hPhysicsMode = "full";
+  m_hOpBoundaryModel = "standard";
+  m_hOpBoundaryTable = "OpBoundaryResponse.dat";
+
   m_pMessenger = new muensterTPCPhysicsMessenger(this);
 	
   particleList = new G4DecayPhysics("decays");
@@ -158,12 +179,49 @@ void muensterTPCPhysicsList::ConstructMyShortLiveds()
 // Construct Processes //////////////////////////////////////////////////////
 void muensterTPCPhysicsList::ConstructProcess()
 {
+  G4cout <<"MuensterTPCPhysicsList::MuensterTPCPhysicsList() Physics mode: "<< m_hPhysicsMode << G4endl;
   G4cout <<"MuensterTPCPhysicsList::MuensterTPCPhysicsList() EM physics: "<< m_hEMlowEnergyModel << G4endl;
   G4cout <<"MuensterTPCPhysicsList::MuensterTPCPhysicsList() Cerenkov: "<< m_bCerenkov << G4endl;
 
+	// the physics mode decides which parts are registered at all:
+	//   full    - EM, optical, hadronic and (radioactive) decays
+	//   em      - EM, optical and (radioactive) decays, for gamma/beta sources
+	//   optical - transportation and optical processes, for opticalphoton sources
+  if (m_hPhysicsMode != "full" && m_hPhysicsMode != "em" && m_hPhysicsMode != "optical") {
+    G4String msg = "MuensterTPCPhysicsList::MuensterTPCPhysicsList() Available choices for the physics mode are: <full> <em> <optical>";
+    G4Exception("MuensterTPCPhysicsList::ConstructProcess()","PhysicsList",FatalException,msg);
+  }
+
+  const G4bool bEMPhysics = (m_hPhysicsMode != "optical");
+  const G4bool bHadronicPhysics = (m_hPhysicsMode == "full");
+  const G4bool bDecayPhysics = (m_hPhysicsMode != "optical");
+
 	AddTransportation();
 
 	// EM physics
+  if (bEMPhysics)
+    ConstructEMPhysics();
+
+	  // construct optical physics...... is there a G4 standard for this one as well?
+  ConstructOp();
+  //opPhysicsList = new G4OpticalPhysics();
+  //	opPhysicsList->ConstructProcess();
+
+	// construct the Hadronic physics models
+  if (bHadronicPhysics)
+    ConstructHadronicPhysics();
+  
+  // some other stuff
+  if (bDecayPhysics) {
+    if (bHadronicPhysics && m_hHadronicModel != "custom")
+      particleList->ConstructProcess();
+    ConstructGeneral();
+  }
+}
+
+void muensterTPCPhysicsList::ConstructEMPhysics()
+{
+  // the constructor is only created when EM physics is actually needed
   if (m_hEMlowEnergyModel == "emstandard") {
     emPhysicsList = new G4EmStandardPhysics(); 
   } else if (m_hEMlowEnergyModel == "emlivermore"){
@@ -184,13 +242,10 @@ void muensterTPCPhysicsList::ConstructProcess()
   } else {
     ConstructEM(); // obsolete in GEANT4_VERSION > geant4.9.4.p02
   }
+}
 
-	  // construct optical physics...... is there a G4 standard for this one as well?
-  ConstructOp();
-  //opPhysicsList = new G4OpticalPhysics();
-  //	opPhysicsList->ConstructProcess();
-
-	// construct the Hadronic physics models
+void muensterTPCPhysicsList::ConstructHadronicPhysics()
+{
   hadronPhys.clear();
   if (m_hHadronicModel == "custom") {
     // custom hadronic physics list
@@ -214,15 +269,6 @@ void muensterTPCPhysicsList::ConstructProcess()
   for(size_t i=0; i<hadronPhys.size(); i++) {
     hadronPhys[i]->ConstructProcess();
   }
-  
-  // some other stuff
-  if        (m_hHadronicModel == "custom"){
-    ConstructGeneral();
-  } else if (m_hHadronicModel == "QGSP_BERT_HP" ||
-             m_hHadronicModel == "QGSP_BERT"   ) {
-    particleList->ConstructProcess();
-    ConstructGeneral();
-  }
 }
 
 void muensterTPCPhysicsList::SetBuilderList1(G4bool flagHP)
@@ -539,7 +585,11 @@ muensterTPCPhysicsList::ConstructOp()
 	// optical processes
 	G4OpAbsorption *theAbsorptionProcess = new G4OpAbsorption();
 	G4OpRayleigh *theRayleighScatteringProcess = new G4OpRayleigh();
-	G4OpBoundaryProcess *theBoundaryProcess = new G4OpBoundaryProcess();
+	G4OpBoundaryProcess *theBoundaryProcess = 0;
+	if(m_hOpBoundaryModel == "standard")
+		theBoundaryProcess = new G4OpBoundaryProcess();
+	else
+		theBoundaryProcess = new muensterTPCOpBoundaryProcess(m_hOpBoundaryModel, m_hOpBoundaryTable);
 
 	//theAbsorptionProcess->DumpPhysicsTable();
 	//theRayleighScatteringProcess->DumpPhysicsTable();
@@ -561,7 +611,7 @@ muensterTPCPhysicsList::ConstructOp()
 		G4ProcessManager *pmanager = particle->GetProcessManager();
 		G4String particleName = particle->GetParticleName();
 
-		if(theScintProcessDef->IsApplicable(*particle))
+		if(theScintProcessDef->IsApplicable(*particle) && m_hPhysicsMode != "optical")
 		{
 			//      if(particle->GetPDGMass() > 5.0*GeV) 
 			if(particle->GetParticleName() == "GenericIon")
@@ -592,14 +642,18 @@ muensterTPCPhysicsList::ConstructOp()
 
 		if(particleName == "opticalphoton")
 		{
-			// Step limitation seen as a process
-		    pmanager->AddProcess(new G4UserSpecialCuts(),-1,-1,1);
+			// Step limitation seen as a process, the minimal optical mode
+			// relies on absorption and the surfaces to end the tracks
+			if(m_hPhysicsMode != "optical")
+				pmanager->AddProcess(new G4UserSpecialCuts(),-1,-1,1);
 			pmanager->AddDiscreteProcess(theAbsorptionProcess);
 			pmanager->AddDiscreteProcess(theRayleighScatteringProcess);
 			pmanager->AddDiscreteProcess(theBoundaryProcess);
+			// only active with the surface mesh model
+			pmanager->AddDiscreteProcess(new muensterTPCMeshSurfaceProcess());
 		}
 		// ... and give those particles that need it a bit of Cerenkov.... and only if you want to
-    if(fCerenkovProcess->IsApplicable(*particle) && m_bCerenkov){
+    if(fCerenkovProcess->IsApplicable(*particle) && m_bCerenkov && m_hPhysicsMode != "optical"){
       pmanager->AddProcess(fCerenkovProcess);
       pmanager->SetProcessOrdering(fCerenkovProcess,idxPostStep);
     }
@@ -1056,12 +1110,167 @@ muensterTPCPhysicsList::SetCuts()
 	G4ProductionCutsTable::GetProductionCutsTable()->SetEnergyRange(lowlimit,
 		100. * GeV);
 
+	ApplyCuts();
+
+	// only use cached tables if they were built with the same physics and cuts
+	if(m_hRetrieveTablesDirectory != "")
+	{
+		if(G4StateManager::GetStateManager()->GetCurrentState() != G4State_Idle
+			&& CheckTableSignature(m_hRetrieveTablesDirectory))
+		{
+			G4cout << "muensterTPCPhysicsList::SetCuts: retrieving physics tables from "
+				<< m_hRetrieveTablesDirectory << G4endl;
+			SetPhysicsTableRetrieved(m_hRetrieveTablesDirectory);
+		}
+		else
+		{
+			G4cout << "muensterTPCPhysicsList::SetCuts: physics tables in "
+				<< m_hRetrieveTablesDirectory << " do not match, building them." << G4endl;
+			ResetPhysicsTableRetrieved();
+			m_hRetrieveTablesDirectory = "";
+		}
+	}
+
+	if(verboseLevel > 0) DumpCutValuesTable();
+}
+
+void
+muensterTPCPhysicsList::ApplyCuts()
+{
 	// set cut values for gamma at first and for e- second and next for e+,
 	// because some processes for e+/e- need cut values for gamma 
 	SetCutValue(cutForGamma, "gamma");
 	SetCutValue(cutForElectron, "e-");
 	SetCutValue(cutForPositron, "e+");
 
-	if(verboseLevel > 0) DumpCutValuesTable();
+	// fine cuts where the energy is measured, coarse cuts in passive materials
+	SetRegionCuts("XenonRegion", m_dXenonRegionCut);
+	SetRegionCuts("CryostatRegion", m_dCryostatRegionCut);
 }
 
+void
+muensterTPCPhysicsList::SetRegionCuts(const G4String &hRegionName, G4double dCut)
+{
+	G4Region *pRegion = G4RegionStore::GetInstance()->GetRegion(hRegionName, false);
+
+	if(!pRegion)
+	{
+		G4cout << "muensterTPCPhysicsList::SetRegionCuts: region " << hRegionName
+			<< " not found, using the default cuts there." << G4endl;
+		return;
+	}
+
+	G4ProductionCuts *pCuts = pRegion->GetProductionCuts();
+	if(!pCuts)
+	{
+		pCuts = new G4ProductionCuts();
+		pRegion->SetProductionCuts(pCuts);
+	}
+
+	pCuts->SetProductionCut(dCut, "gamma");
+	pCuts->SetProductionCut(dCut, "e-");
+	pCuts->SetProductionCut(dCut, "e+");
+	pCuts->SetProductionCut(dCut, "proton");
+
+	if(verboseLevel > 0)
+		G4cout << "muensterTPCPhysicsList::SetRegionCuts: " << hRegionName
+			<< " CutLength : " << G4BestUnit(dCut, "Length") << G4endl;
+}
+
+void
+muensterTPCPhysicsList::SetXenonRegionCut(G4double dCut)
+{
+	m_dXenonRegionCut = dCut;
+
+	// between runs the cuts have to be pushed to the regions directly
+	if(G4StateManager::GetStateManager()->GetCurrentState() == G4State_Idle)
+		ApplyCuts();
+}
+
+void
+muensterTPCPhysicsList::SetCryostatRegionCut(G4double dCut)
+{
+	m_dCryostatRegionCut = dCut;
+
+	if(G4StateManager::GetStateManager()->GetCurrentState() == G4State_Idle)
+		ApplyCuts();
+}
+
+void
+muensterTPCPhysicsList::SetLabCut(G4double dCut)
+{
+	defaultCutValue = dCut;
+	cutForGamma = dCut;
+	cutForElectron = dCut;
+	cutForPositron = dCut;
+
+	if(G4StateManager::GetStateManager()->GetCurrentState() == G4State_Idle)
+		ApplyCuts();
+}
+
+
+// Physics table cache //////////////////////////////////////////////////////
+void
+muensterTPCPhysicsList::StoreTables(const G4String &hDirectory)
+{
+	mkdir(hDirectory.c_str(), 0755);
+
+	if(!StorePhysicsTable(hDirectory))
+	{
+		G4cout << "muensterTPCPhysicsList::StoreTables: could not store the physics tables in "
+			<< hDirectory << G4endl;
+		return;
+	}
+
+	std::ofstream hSignatureFile((hDirectory + "/muensterTPCPhysics.sig").c_str());
+	hSignatureFile << GetTableSignature();
+	hSignatureFile.close();
+
+	G4cout << "muensterTPCPhysicsList::StoreTables: physics tables stored in "
+		<< hDirectory << G4endl;
+}
+
+G4String
+muensterTPCPhysicsList::GetTableSignature()
+{
+	// everything that changes the content of the physics tables
+	std::stringstream hSignature;
+
+	hSignature << "Geant4Version " << G4Version << "\n";
+	hSignature << "PhysicsMode " << m_hPhysicsMode << "\n";
+	hSignature << "EMlowEnergyModel " << m_hEMlowEnergyModel << "\n";
+	hSignature << "HadronicModel " << m_hHadronicModel << "\n";
+	hSignature << "Cerenkov " << m_bCerenkov << "\n";
+	hSignature << "LabCut[mm] " << defaultCutValue/mm << "\n";
+	hSignature << "XenonCut[mm] " << m_dXenonRegionCut/mm << "\n";
+	hSignature << "CryostatCut[mm] " << m_dCryostatRegionCut/mm << "\n";
+
+	return hSignature.str();
+}
+
+G4bool
+muensterTPCPhysicsList::CheckTableSignature(const G4String &hDirectory)
+{
+	std::ifstream hSignatureFile((hDirectory + "/muensterTPCPhysics.sig").c_str());
+
+	if(!hSignatureFile.is_open())
+	{
+		G4cout << "muensterTPCPhysicsList::CheckTableSignature: no signature in "
+			<< hDirectory << G4endl;
+		return false;
+	}
+
+	std::stringstream hStoredSignature;
+	hStoredSignature << hSignatureFile.rdbuf();
+
+	if(hStoredSignature.str() != GetTableSignature())
+	{
+		G4cout << "muensterTPCPhysicsList::CheckTableSignature: stored tables were built with" << G4endl
+			<< hStoredSignature.str()
+			<< "current settings are" << G4endl
+			<< GetTableSignature();
+		return false;
+	}
+
+	return true;
+}
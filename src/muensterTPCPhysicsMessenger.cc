@@ -56,6 +56,63 @@ muensterTPCPhysicsMessenger::muensterTPCPhysicsMessenger(muensterTPCPhysicsList
   m_pCerenkovCmd->SetGuidance("Switch Cerenkov radiation on (=true) or off (=false)");
   m_pCerenkovCmd->SetDefaultValue(false);
   m_pCerenkovCmd->AvailableForStates(G4State_PreInit);
+
+  // choose which physics constructors are registered
+  m_pPhysicsModeCmd = new G4UIcmdWithAString("/run/physics/setPhysicsMode", this);
+  m_pPhysicsModeCmd->SetGuidance("Choose which physics is registered:");
+  m_pPhysicsModeCmd->SetGuidance("<full = EM, optical, hadronic and decays> <em = no hadronic> <optical = optical photons only>");
+  m_pPhysicsModeCmd->SetCandidates("full em optical");
+  m_pPhysicsModeCmd->SetDefaultValue("full");
+  m_pPhysicsModeCmd->AvailableForStates(G4State_PreInit);
+
+  // optical boundary process for the Teflon and PMT casing surfaces
+  m_pOpBoundaryModelCmd = new G4UIcmdWithAString("/run/physics/setOpBoundaryModel", this);
+  m_pOpBoundaryModelCmd->SetGuidance("Choose the optical boundary model of the Teflon and PMT casing surfaces:");
+  m_pOpBoundaryModelCmd->SetGuidance("<standard = G4OpBoundaryProcess> <record = standard, write the response table>");
+  m_pOpBoundaryModelCmd->SetGuidance("<tabulated = sample from the response table> <validate = standard, compare with the table>");
+  m_pOpBoundaryModelCmd->SetCandidates("standard record tabulated validate");
+  m_pOpBoundaryModelCmd->SetDefaultValue("standard");
+  m_pOpBoundaryModelCmd->AvailableForStates(G4State_PreInit);
+
+  m_pOpBoundaryTableCmd = new G4UIcmdWithAString("/run/physics/setOpBoundaryTable", this);
+  m_pOpBoundaryTableCmd->SetGuidance("Set the file of the optical boundary response table");
+  m_pOpBoundaryTableCmd->SetParameterName("file", false);
+  m_pOpBoundaryTableCmd->AvailableForStates(G4State_PreInit);
+
+  // regional production cuts
+  m_pXenonCutCmd = new G4UIcmdWithADoubleAndUnit("/run/physics/setXenonCut", this);
+  m_pXenonCutCmd->SetGuidance("Set the production cut in the LXe/GXe region (TPC, meshes and PMTs)");
+  m_pXenonCutCmd->SetParameterName("XenonCut", false);
+  m_pXenonCutCmd->SetRange("XenonCut>0.");
+  m_pXenonCutCmd->SetDefaultUnit("mm");
+  m_pXenonCutCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  m_pCryostatCutCmd = new G4UIcmdWithADoubleAndUnit("/run/physics/setCryostatCut", this);
+  m_pCryostatCutCmd->SetGuidance("Set the production cut in the cryostat region (vessels, flanges and vacuum)");
+  m_pCryostatCutCmd->SetParameterName("CryostatCut", false);
+  m_pCryostatCutCmd->SetRange("CryostatCut>0.");
+  m_pCryostatCutCmd->SetDefaultUnit("mm");
+  m_pCryostatCutCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  m_pLabCutCmd = new G4UIcmdWithADoubleAndUnit("/run/physics/setLabCut", this);
+  m_pLabCutCmd->SetGuidance("Set the default production cut, used in the lab");
+  m_pLabCutCmd->SetParameterName("LabCut", false);
+  m_pLabCutCmd->SetRange("LabCut>0.");
+  m_pLabCutCmd->SetDefaultUnit("mm");
+  m_pLabCutCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  // physics table cache
+  m_pStoreTablesCmd = new G4UIcmdWithAString("/run/physics/storeTables", this);
+  m_pStoreTablesCmd->SetGuidance("Store the physics tables and the physics settings in a directory");
+  m_pStoreTablesCmd->SetGuidance("The tables are built at the first run, so use it after /run/beamOn (0 is enough)");
+  m_pStoreTablesCmd->SetParameterName("dir", false);
+  m_pStoreTablesCmd->AvailableForStates(G4State_Idle);
+
+  m_pRetrieveTablesCmd = new G4UIcmdWithAString("/run/physics/retrieveTables", this);
+  m_pRetrieveTablesCmd->SetGuidance("Retrieve the physics tables from a directory written by storeTables");
+  m_pRetrieveTablesCmd->SetGuidance("The tables are only used if physics lists and cuts match, otherwise they are rebuilt");
+  m_pRetrieveTablesCmd->SetParameterName("dir", false);
+  m_pRetrieveTablesCmd->AvailableForStates(G4State_PreInit);
 	
   /* to be implemented ..
 	// make histograms for cross sections  
@@ -68,10 +125,19 @@ muensterTPCPhysicsMessenger::muensterTPCPhysicsMessenger(muensterTPCPhysicsList
   m_pPhysicsList->SetEMlowEnergyModel("emlivermore");
 	m_pPhysicsList->SetHadronicModel("QGSP_BERT_HP");
 	m_pPhysicsList->SetCerenkov(false);
+	m_pPhysicsList->SetPhysicsMode("full");
 }
 
 muensterTPCPhysicsMessenger::~muensterTPCPhysicsMessenger()
 {
+  delete m_pPhysicsModeCmd;
+  delete m_pOpBoundaryModelCmd;
+  delete m_pOpBoundaryTableCmd;
+  delete m_pXenonCutCmd;
+  delete m_pCryostatCutCmd;
+  delete m_pLabCutCmd;
+  delete m_pStoreTablesCmd;
+  delete m_pRetrieveTablesCmd;
   delete m_pDirectory;
 }
 
@@ -87,6 +153,30 @@ muensterTPCPhysicsMessenger::SetNewValue(G4UIcommand * command, G4String newValu
   if(command == m_pCerenkovCmd)
     m_pPhysicsList->SetCerenkov(m_pCerenkovCmd->GetNewBoolValue(newValues));
 
+  if(command == m_pPhysicsModeCmd)
+    m_pPhysicsList->SetPhysicsMode(newValues);
+
+  if(command == m_pOpBoundaryModelCmd)
+    m_pPhysicsList->SetOpBoundaryModel(newValues);
+
+  if(command == m_pOpBoundaryTableCmd)
+    m_pPhysicsList->SetOpBoundaryTable(newValues);
+
+  if(command == m_pXenonCutCmd)
+    m_pPhysicsList->SetXenonRegionCut(m_pXenonCutCmd->GetNewDoubleValue(newValues));
+
+  if(command == m_pCryostatCutCmd)
+    m_pPhysicsList->SetCryostatRegionCut(m_pCryostatCutCmd->GetNewDoubleValue(newValues));
+
+  if(command == m_pLabCutCmd)
+    m_pPhysicsList->SetLabCut(m_pLabCutCmd->GetNewDoubleValue(newValues));
+
+  if(command == m_pStoreTablesCmd)
+    m_pPhysicsList->StoreTables(newValues);
+
+  if(command == m_pRetrieveTablesCmd)
+    m_pPhysicsList->RetrieveTables(newValues);
+
   //if(command == m_pHistosCmd)
   //  m_pPhysicsList->SetHistograms(m_pHistosCmd->GetNewBoolValue(newValues));
     
@@ -0,0 +1,28 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * Parameterised placement of the PMTs of one array
+ *
+ * @comment
+ ******************************************************************/
+#include <G4VPhysicalVolume.hh>
+
+#include "muensterTPCPmtParameterisation.hh"
+
+muensterTPCPmtParameterisation::muensterTPCPmtParameterisation(G4int iFirstPmtNb, const vector<G4ThreeVector> &hPositions)
+{
+	m_iFirstPmtNb = iFirstPmtNb;
+	m_hPositions = hPositions;
+}
+
+muensterTPCPmtParameterisation::~muensterTPCPmtParameterisation()
+{
+}
+
+void muensterTPCPmtParameterisation::ComputeTransformation(const G4int iCopyNo, G4VPhysicalVolume *pPhysicalVolume) const
+{
+	// the orientation of the pmts is part of the pmt unit
+	pPhysicalVolume->SetTranslation(m_hPositions[iCopyNo]);
+	pPhysicalVolume->SetRotation(0);
+}
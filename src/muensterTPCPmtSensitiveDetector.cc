@@ -13,6 +13,10 @@
 #include <G4VProcess.hh>
 #include <G4ThreeVector.hh>
 #include <G4SDManager.hh>
+#include <G4VTouchable.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4OpticalPhoton.hh>
+#include <G4SystemOfUnits.hh>
 #include <G4ios.hh>
 
 #include <map>
@@ -20,10 +24,16 @@
 using namespace std;
 
 #include "muensterTPCPmtSensitiveDetector.hh"
+#include "muensterTPCPmtParameterisation.hh"
+#include "muensterTPCEventData.hh"
 
 muensterTPCPmtSensitiveDetector::muensterTPCPmtSensitiveDetector(G4String hName): G4VSensitiveDetector(hName)
 {
 	collectionName.insert("PmtHitsCollection");
+
+	m_pEventData = 0;
+	m_bStoreHits = false;
+	m_iNbHits = 0;
 }
 
 muensterTPCPmtSensitiveDetector::~muensterTPCPmtSensitiveDetector()
@@ -40,31 +50,51 @@ void muensterTPCPmtSensitiveDetector::Initialize(G4HCofThisEvent* pHitsCollectio
 		iHitsCollectionID = G4SDManager::GetSDMpointer()->GetCollectionID(collectionName[0]);
 	
 	pHitsCollectionOfThisEvent->AddHitsCollection(iHitsCollectionID, m_pPmtHitsCollection); 
+
+	m_iNbHits = 0;
 }
 
 G4bool muensterTPCPmtSensitiveDetector::ProcessHits(G4Step* pStep, G4TouchableHistory *pHistory)
 {
 	G4Track *pTrack = pStep->GetTrack();
 
-	if(pTrack->GetDefinition()->GetParticleName() == "opticalphoton")
+	if(pTrack->GetDefinition() != G4OpticalPhoton::Definition())
+		return false;
+
+	// photocathode -> casing (pmt number) or, for parameterised arrays,
+	// photocathode -> casing -> pmt unit (replica number in the array)
+	const G4VTouchable *pTouchable = pTrack->GetTouchable();
+	G4int iPmtNb = pTouchable->GetCopyNumber(1);
+	if(pTouchable->GetHistoryDepth() > 2 && pTouchable->GetVolume(2)->IsParameterised())
+	{
+		const muensterTPCPmtParameterisation *pParameterisation =
+			static_cast<const muensterTPCPmtParameterisation *>(pTouchable->GetVolume(2)->GetParameterisation());
+		iPmtNb = pParameterisation->GetFirstPmtNb() + pTouchable->GetReplicaNumber(2);
+	}
+
+	m_iNbHits++;
+
+	if(m_pEventData)
+	{
+		(*(m_pEventData->m_pPmtHits))[iPmtNb]++;
+		m_pEventData->AddPhoton(iPmtNb, pTrack->GetGlobalTime()/ns);
+	}
+
+	if(m_bStoreHits)
 	{
 		muensterTPCPmtHit* pHit = new muensterTPCPmtHit();
 
 		pHit->SetPosition(pStep->GetPreStepPoint()->GetPosition());
 		pHit->SetTime(pTrack->GetGlobalTime());
-		pHit->SetPmtNb(pTrack->GetTouchable()->GetVolume(1)->GetCopyNo());
+		pHit->SetPmtNb(iPmtNb);
 
 		m_pPmtHitsCollection->insert(pHit);
 
 //        pHit->Print();
 //        pHit->Draw();
-
-		return true;
-	}
-	else
-	{
-		return false;
 	}
+
+	return true;
 }
 
 void muensterTPCPmtSensitiveDetector::EndOfEvent(G4HCofThisEvent *pHitsCollectionOfThisEvent)
@@ -11,8 +11,13 @@
 #include <globals.hh>
 #include <G4RunManagerKernel.hh>
 #include <G4Event.hh>
+#include <G4Run.hh>
 #include <Randomize.hh>
 
+#include <unistd.h>
+#include <sys/time.h>
+#include <stdint.h>
+
 #include "muensterTPCParticleSource.hh"
 #include "muensterTPCPrimaryGeneratorAction.hh"
 #include "muensterTPCPrimaryGeneratorMessenger.hh"
@@ -28,6 +33,14 @@ muensterTPCPrimaryGeneratorAction::muensterTPCPrimaryGeneratorAction()
 
 	m_lSeeds[0] = -1;
 	m_lSeeds[1] = -1;
+
+	// drawn at the first run if not set
+	m_bMasterSeed = false;
+	m_lMasterSeed = 0;
+	m_iRunId = 0;
+	m_iFirstEventId = 0;
+	m_iNextRunId = -1;
+	m_iNextEventId = 0;
 }
 
 muensterTPCPrimaryGeneratorAction::~muensterTPCPrimaryGeneratorAction()
@@ -35,9 +48,71 @@ muensterTPCPrimaryGeneratorAction::~muensterTPCPrimaryGeneratorAction()
 	delete m_pParticleSource;
 }
 
+// SplitMix64, the seeds of an event are a function of its counters only
+static uint64_t
+MixSeed(uint64_t lValue)
+{
+	lValue += 0x9E3779B97F4A7C15ULL;
+	lValue = (lValue ^ (lValue >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	lValue = (lValue ^ (lValue >> 27)) * 0x94D049BB133111EBULL;
+	return lValue ^ (lValue >> 31);
+}
+
+void
+muensterTPCPrimaryGeneratorAction::SetMasterSeed(G4long lMasterSeed)
+{
+	m_bMasterSeed = true;
+	m_lMasterSeed = lMasterSeed;
+
+	G4cout << "----> Setting master seed to " << m_lMasterSeed << G4endl;
+}
+
+void
+muensterTPCPrimaryGeneratorAction::SetFirstEvent(G4int iEventId, G4int iRunId)
+{
+	m_iNextEventId = iEventId;
+	m_iNextRunId = iRunId;
+
+	G4cout << "----> Setting first event of the next run to " << iEventId;
+	if(iRunId >= 0)
+		G4cout << " of run " << iRunId;
+	G4cout << G4endl;
+}
+
+void
+muensterTPCPrimaryGeneratorAction::BeginOfRun(const G4Run *pRun)
+{
+	// different for each job without a master seed, it is written into the output file
+	if(!m_bMasterSeed)
+	{
+		struct timeval hTimeValue;
+		gettimeofday(&hTimeValue, NULL);
+		const uint64_t lTime = 1000000ULL*hTimeValue.tv_sec + hTimeValue.tv_usec;
+		m_lMasterSeed = (G4long) (MixSeed(lTime ^ ((uint64_t) getpid() << 40)) & 0x7FFFFFFF);
+		m_bMasterSeed = true;
+	}
+
+	m_iRunId = (m_iNextRunId >= 0)?(m_iNextRunId):(pRun->GetRunID());
+	m_iFirstEventId = m_iNextEventId;
+	m_iNextRunId = -1;
+	m_iNextEventId = 0;
+
+	G4cout << "----> Seeding the events of run " << m_iRunId << " from master seed " << m_lMasterSeed
+	       << " (/Xe/gun/seed " << m_lMasterSeed << ")" << G4endl;
+}
+
 void
 muensterTPCPrimaryGeneratorAction::GeneratePrimaries(G4Event *pEvent)
 {
+	// independent of the previous events, the job splitting and the number of threads
+	const uint64_t lEventSeed = MixSeed(MixSeed(MixSeed((uint64_t) m_lMasterSeed) ^ (uint64_t) m_iRunId)
+		^ (uint64_t) (m_iFirstEventId + pEvent->GetEventID()));
+	long lSeeds[3];
+	lSeeds[0] = 1 + (long) ((lEventSeed & 0xFFFFFFFFULL) % 2147483562ULL);
+	lSeeds[1] = 1 + (long) ((lEventSeed >> 32) % 2147483398ULL);
+	lSeeds[2] = 0;
+	CLHEP::HepRandom::setTheSeeds(lSeeds);
+
 	m_lSeeds[0] = *(CLHEP::HepRandom::getTheSeeds());
 	m_lSeeds[1] = *(CLHEP::HepRandom::getTheSeeds()+1);
 
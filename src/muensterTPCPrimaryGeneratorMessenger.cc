@@ -10,9 +10,12 @@
 #include <G4UIcmdWithAnInteger.hh>
 #include <G4UIcmdWithADouble.hh>
 #include <G4UIcmdWithABool.hh>
+#include <G4UIcommand.hh>
+#include <G4UIparameter.hh>
 #include <G4Tokenizer.hh>
 #include <G4ios.hh>
 #include <fstream>
+#include <sstream>
 #include <iomanip>
 
 #include "muensterTPCPrimaryGeneratorMessenger.hh"
@@ -26,11 +29,34 @@ muensterTPCPrimaryGeneratorMessenger::muensterTPCPrimaryGeneratorMessenger(muens
   m_pWriteEmptyCmd->SetGuidance("Write empty events to the root tree true/false");
   m_pWriteEmptyCmd->SetDefaultValue(false);
   //m_pWriteEmptyCmd->AvailableForStates(G4State_PreInit);
+
+  // master seed of the event seeds, in the /Xe/gun/ directory of the particle source
+  m_pSeedCmd = new G4UIcmdWithAnInteger("/Xe/gun/seed", this);
+  m_pSeedCmd->SetGuidance("Set the master seed, the random numbers of each event are seeded from");
+  m_pSeedCmd->SetGuidance("(master seed, run id, event id). Without it a master seed is drawn at the first run.");
+  m_pSeedCmd->SetParameterName("Seed", false);
+  m_pSeedCmd->SetRange("Seed >= 0");
+  m_pSeedCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  // ids of the first event of the next run
+  m_pFirstEventCmd = new G4UIcommand("/Xe/gun/firstEvent", this);
+  m_pFirstEventCmd->SetGuidance("Set the event id (and run id) of the first event of the next run.");
+  m_pFirstEventCmd->SetGuidance("A single event is simulated again with /Xe/gun/seed <seed>, /Xe/gun/firstEvent <eventid> <runid>");
+  m_pFirstEventCmd->SetGuidance("and /run/beamOn 1 (not for decays postponed from the previous event).");
+  G4UIparameter *pParameter = new G4UIparameter("eventid", 'i', false);
+  pParameter->SetParameterRange("eventid >= 0");
+  m_pFirstEventCmd->SetParameter(pParameter);
+  pParameter = new G4UIparameter("runid", 'i', true);
+  pParameter->SetDefaultValue(-1);
+  m_pFirstEventCmd->SetParameter(pParameter);
+  m_pFirstEventCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
 }
 
 muensterTPCPrimaryGeneratorMessenger::~muensterTPCPrimaryGeneratorMessenger()
 {
-  delete m_pDirectory;
+  delete m_pWriteEmptyCmd;
+  delete m_pSeedCmd;
+  delete m_pFirstEventCmd;
 }
 
 void
@@ -38,5 +64,16 @@ muensterTPCPrimaryGeneratorMessenger::SetNewValue(G4UIcommand * command, G4Strin
 {
   if(command == m_pWriteEmptyCmd) 
     m_pPrimaryGeneratorAction->SetWriteEmpty(m_pWriteEmptyCmd->GetNewBoolValue(newValues));
+
+  if(command == m_pSeedCmd)
+    m_pPrimaryGeneratorAction->SetMasterSeed(m_pSeedCmd->GetNewIntValue(newValues));
+
+  if(command == m_pFirstEventCmd)
+  {
+    std::istringstream hStream(newValues);
+    G4int iEventId = 0, iRunId = -1;
+    hStream >> iEventId >> iRunId;
+    m_pPrimaryGeneratorAction->SetFirstEvent(iEventId, iRunId);
+  }
 }
 
@@ -9,12 +9,13 @@
  * @comment 
  ******************************************************************/
 #include <G4SDManager.hh>
+#include <G4ProcessTable.hh>
 
 #include <Randomize.hh>
-#include <sys/time.h>
 
 #include "muensterTPCAnalysisManager.hh"
 #include "muensterTPCRunAction.hh"
+#include "muensterTPCOpBoundaryProcess.hh"
 
 muensterTPCRunAction::muensterTPCRunAction(muensterTPCAnalysisManager *pAnalysisManager) {
 	m_pAnalysisManager = pAnalysisManager;
@@ -27,14 +28,12 @@ muensterTPCRunAction::~muensterTPCRunAction() {
 void muensterTPCRunAction::BeginOfRunAction(const G4Run *pRun) {
 	if (( ! G4Threading::IsMultithreadedApplication() ) ||
 			( G4Threading::IsMultithreadedApplication() && ! G4Threading::IsWorkerThread() )) {
+		// the seeds are set for each event by the PrimaryGeneratorAction
+		CLHEP::HepRandom::setTheEngine(new CLHEP::RanecuEngine);
+
+		// after the engine, a resumed run restores the engine state of its checkpoint
 		if(m_pAnalysisManager)
 			m_pAnalysisManager->BeginOfRun(pRun);
-
-		struct timeval hTimeValue;
-		gettimeofday(&hTimeValue, NULL);
-		
-		CLHEP::HepRandom::setTheEngine(new CLHEP::RanecuEngine);
-		CLHEP::HepRandom::setTheSeed(hTimeValue.tv_usec);
 	}
 }
 
@@ -43,6 +42,12 @@ void muensterTPCRunAction::EndOfRunAction(const G4Run *pRun) {
 				( G4Threading::IsMultithreadedApplication() && ! G4Threading::IsWorkerThread() )) {
 		if(m_pAnalysisManager)
 			m_pAnalysisManager->EndOfRun(pRun);
+
+		// boundary response tables (record/validate mode)
+		muensterTPCOpBoundaryProcess *pBoundaryProcess = dynamic_cast<muensterTPCOpBoundaryProcess *>
+			(G4ProcessTable::GetProcessTable()->FindProcess("OpBoundary", "opticalphoton"));
+		if(pBoundaryProcess)
+			pBoundaryProcess->EndOfRun();
 	}
 }
 
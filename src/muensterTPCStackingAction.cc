@@ -17,6 +17,7 @@
 #include <G4StackManager.hh>
 
 #include "muensterTPCAnalysisManager.hh"
+#include "muensterTPCCheckpoint.hh"
 
 #include "muensterTPCStackingAction.hh"
 
@@ -34,12 +35,20 @@ muensterTPCStackingAction::ClassifyNewTrack(const G4Track *pTrack)
 {
 	G4ClassificationOfNewTrack hTrackClassification = fUrgent;
 
+	// postponed tracks of a resumed run
+	if(m_pAnalysisManager && m_pAnalysisManager->IsPushingPostponedTracks())
+		return fPostpone;
+
 	if(pTrack->GetDefinition()->GetParticleType() == "nucleus" && !pTrack->GetDefinition()->GetPDGStable())
 	{
 		if(pTrack->GetParentID() > 0 && pTrack->GetCreatorProcess()->GetProcessName() == "RadioactiveDecay")
 			hTrackClassification = fPostpone;
 	}
 
+	// the postponed stack is part of the checkpoints
+	if(hTrackClassification == fPostpone && m_pAnalysisManager)
+		m_pAnalysisManager->GetCheckpoint()->AddPostponedTrack(pTrack);
+
 	return hTrackClassification;
 }
 
@@ -50,6 +59,11 @@ muensterTPCStackingAction::NewStage()
 
 void
 muensterTPCStackingAction::PrepareNewEvent()
-{ 
+{
+	if(!m_pAnalysisManager)
+		return;
+
+	// the postponed tracks of the previous event are part of this event now
+	m_pAnalysisManager->GetCheckpoint()->ClearPostponedTracks();
 }
 
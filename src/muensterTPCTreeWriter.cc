@@ -0,0 +1,267 @@
+/******************************************************************
+ * muensterTPCsim
+ *
+ * Simulations of the Muenster TPC
+ * TTree output of the event data
+ *
+ * @comment
+ ******************************************************************/
+#include <TROOT.h>
+#include <TTree.h>
+#include <TDirectory.h>
+
+#include <sstream>
+
+#include "muensterTPCTreeWriter.hh"
+#include "muensterTPCEventData.hh"
+
+//******************************************************************/
+// Branch - leaf list branches
+//******************************************************************/
+void muensterTPCTreeWriter::Branch(const char *szName, void *pAddress, const char *szLeafList) {
+	if(!m_bResume)
+		m_pTree->Branch(szName, pAddress, szLeafList);
+	else if(m_pTree->SetBranchAddress(szName, pAddress) < 0)
+		G4cout << "--> warning from TreeWriter::Branch : no branch " << szName << " in the resumed tree" << G4endl;
+}
+
+//******************************************************************/
+// Branch - object branches
+//******************************************************************/
+template<class T> void muensterTPCTreeWriter::Branch(const char *szName, const char *szClassName, T **pAddress) {
+	if(!m_bResume)
+		m_pTree->Branch(szName, szClassName, pAddress);
+	else if(m_pTree->SetBranchAddress(szName, pAddress) < 0)
+		G4cout << "--> warning from TreeWriter::Branch : no branch " << szName << " in the resumed tree" << G4endl;
+}
+
+muensterTPCTreeWriter::muensterTPCTreeWriter(muensterTPCEventData *pEventData, const std::vector<std::pair<G4String, G4int> > &hBasketSizes,
+	Long64_t lAutoFlush, Long64_t lAutoSave, G4bool bResume) {
+	m_lAutoFlush = lAutoFlush;
+	m_lAutoSave = lAutoSave;
+
+	// the tree of a resumed run as recovered by ROOT
+	m_pTree = 0;
+	if(bResume)
+		gDirectory->GetObject("events", m_pTree);
+	m_bResume = (m_pTree != 0);
+	m_lNbResumedEntries = (m_pTree)?(m_pTree->GetEntries()):(0);
+
+	// create ROOT Tree for the simulation data
+	if(!m_pTree)
+		m_pTree = new TTree("events", "Tree containing event data for muensterTPCsim");
+
+	// include missing ROOT classes
+	gROOT->ProcessLine("#include <vector>");
+
+	// initialize all tree branches for the different data types
+
+	//******************************************************************/	
+	// branches for each main event/particle beam:
+	//******************************************************************/
+	// eventid:	The eventid contains the individual ID of each event. Since 'event' is used in different situations,
+	//					it means, every particle created by 'beamOn' starts a detector event. All following events will be
+	//					be saved within the same eventid in specific branches (see below).
+	//					Acces to the eventid in ROOT: int eventid;
+	//																				T1->SetBranchAddress("eventid", &eventid);
+	Branch("eventid", &pEventData->m_iEventId, "eventid/I");
+	// ntpmthits:	total amount of top PMT hits for a specific eventid/particle beam
+	//						Acces in ROOT: 	int ntpmthits;
+	//														T1->SetBranchAddress("ntpmthits", &ntpmthits);
+	Branch("ntpmthits", &pEventData->m_iNbTopPmtHits, "ntpmthits/I");
+	// nbpmthits:	total amount of bottom PMT hits for a specific eventid/particle beam
+	//						Acces in ROOT: 	int nbpmthits;
+	//														T1->SetBranchAddress("nbpmthits", &nbpmthits);
+	Branch("nbpmthits", &pEventData->m_iNbBottomPmtHits, "nbpmthits/I");
+
+	//m_pTree->Branch("ntvetopmthits", &pEventData->m_iNbTopVetoPmtHits, "ntvetopmthits/I");
+	//m_pTree->Branch("nbvetopmthits", &pEventData->m_iNbBottomVetoPmtHits, "nbvetopmthits/I");
+
+	// pmthits:	total amount of PMT hits for a specific eventid and for each PMT
+	//						Acces in ROOT: 	vector<int> *pmthits= new vector<int>;
+	//														T1->SetBranchAddress("pmthits", &pmthits);
+	//						Note: Do not access pmthits without calling a specifig vector element.
+	Branch("pmthits", "vector<int>", &pEventData->m_pPmtHits);
+	// wfpmt, wfbin, wfamp:	non-zero bins of the pmt waveforms (/Xe/output/waveform), photons or
+	//											amplitude of the single photoelectron response, binning in wfnbins,
+	//											wfbinwidth and wfstart (ns)
+	//						Acces in ROOT: 	vector<int> *wfpmt= new vector<int>;
+	//														T1->SetBranchAddress("wfpmt", &wfpmt);
+	if(pEventData->HasWaveforms())
+	{
+		Branch("wfpmt", "vector<int>", &pEventData->m_pWaveformPmt);
+		Branch("wfbin", "vector<int>", &pEventData->m_pWaveformBin);
+		Branch("wfamp", "vector<float>", &pEventData->m_pWaveformAmplitude);
+	}
+	// etot:	Amount of energy, which is deopsited during this eventid/particle run.
+	//				Acces in ROOT: 	float etot;
+	//												T1->SetBranchAddress("etot", &etot);
+	Branch("etot", &pEventData->m_fTotalEnergyDeposited, "etot/F");
+	// nbpmthits:	total amount of bottom PMT hits for a specific eventid/particle beam
+	//						Acces in ROOT: 	int nbpmthits;
+	//														T1->SetBranchAddress("nbpmthits", &nbpmthits);
+	Branch("nsteps", &pEventData->m_iNbSteps, "nsteps/I");
+	
+	//******************************************************************/	
+	// branches for each event/particle which is created by the main event,
+	// only for the step fields of the event record
+	//******************************************************************/
+	// trackid:	ID of the current event in the event track. All listed events are
+	//					generated within the main eventid. (e.g. emitted gammas)
+	//					Acces in ROOT: 	vector<int> *trackid= new vector<int>;
+	//													T1->SetBranchAddress("trackid", &trackid);
+	if(pEventData->HasStepField(muensterTPCEventData::eStepTrackId))
+		Branch("trackid", "vector<int>", &pEventData->m_pTrackId);
+	// type:	type of the particles in the event track
+	//				Acces in ROOT: 	vector<string> *type= new vector<string>;
+	//												T1->SetBranchAddress("type", &type);
+	if(pEventData->HasStepField(muensterTPCEventData::eStepType))
+		Branch("type", "vector<string>", &pEventData->m_pParticleType);
+	// parentid:	trackid of the parent track event
+	//						Acces in ROOT: 	vector<int> *parentid= new vector<int>;
+	//														T1->SetBranchAddress("parentid", &parentid);
+	if(pEventData->HasStepField(muensterTPCEventData::eStepParentId))
+		Branch("parentid", "vector<int>", &pEventData->m_pParentId);
+	// parenttype:	parenttype of the parent track event
+	//							Acces in ROOT: 	vector<string> *parenttype= new vector<string>;
+	//															T1->SetBranchAddress("parenttype", &parenttype);
+	if(pEventData->HasStepField(muensterTPCEventData::eStepParentType))
+		Branch("parenttype", "vector<string>", &pEventData->m_pParentType);
+	// creaproc:	name of the creation process of the track particle/trackid
+	//						Acces in ROOT: 	vector<string> *creaproc= new vector<string>;
+	//														T1->SetBranchAddress("creaproc", &creaproc);
+	if(pEventData->HasStepField(muensterTPCEventData::eStepCreatorProcess))
+		Branch("creaproc", "vector<string>", &pEventData->m_pCreatorProcess);
+	// edproc:	name of the energy deposition process of the track particle/trackid
+	//					Acces in ROOT: 	vector<string> *edproc= new vector<string>;
+	//													T1->SetBranchAddress("edproc", &edproc);
+	if(pEventData->HasStepField(muensterTPCEventData::eStepDepositingProcess))
+		Branch("edproc", "vector<string>", &pEventData->m_pDepositingProcess);
+	// Positions of the current particle/trackid
+	// 		Acces in ROOT: 		vector<float> *xp= new vector<float>;
+	//											T1->SetBranchAddress("xp", &xp);
+	if(pEventData->HasStepField(muensterTPCEventData::eStepX))
+		Branch("xp", "vector<float>", &pEventData->m_pX);
+	// 		Acces in ROOT: 		vector<float> *yp= new vector<float>;
+	//											T1->SetBranchAddress("yp", &yp);
+	if(pEventData->HasStepField(muensterTPCEventData::eStepY))
+		Branch("yp", "vector<float>", &pEventData->m_pY);
+	// 		Acces in ROOT: 		vector<float> *zp= new vector<float>;
+	//											T1->SetBranchAddress("zp", &zp);
+	if(pEventData->HasStepField(muensterTPCEventData::eStepZ))
+		Branch("zp", "vector<float>", &pEventData->m_pZ);
+	// ed:	energy deposition of the current particle/trackid
+	// 			Acces in ROOT: 		vector<float> *ed= new vector<float>;
+	//												T1->SetBranchAddress("ed", &ed);
+	if(pEventData->HasStepField(muensterTPCEventData::eStepEnergyDeposited))
+		Branch("ed", "vector<float>", &pEventData->m_pEnergyDeposited);
+	// time:	timestamp of the current particle/trackid
+	// 				Acces in ROOT: 		vector<float> *time= new vector<float>;
+	//													T1->SetBranchAddress("time", &time);
+	if(pEventData->HasStepField(muensterTPCEventData::eStepTime))
+		Branch("time", "vector<float>", &pEventData->m_pTime);
+	// ekin:	kinetic energy of the particle after the step (/Xe/output/fields)
+	// 				Acces in ROOT: 		vector<float> *ekin= new vector<float>;
+	//													T1->SetBranchAddress("ekin", &ekin);
+	if(pEventData->HasStepField(muensterTPCEventData::eStepKineticEnergy))
+		Branch("ekin", "vector<float>", &pEventData->m_pKineticEnergy);
+	// steplen:	length of the step (/Xe/output/fields)
+	// 					Acces in ROOT: 		vector<float> *steplen= new vector<float>;
+	//														T1->SetBranchAddress("steplen", &steplen);
+	if(pEventData->HasStepField(muensterTPCEventData::eStepLength))
+		Branch("steplen", "vector<float>", &pEventData->m_pStepLength);
+
+	//******************************************************************/	
+	// branches for each event/particle which contain information about the primary particle
+	//******************************************************************/
+	// type_pri:	type of the primary event/main event
+	//						Acces in ROOT: 	vector<string> *type_pri= new vector<string>;
+	//														T1->SetBranchAddress("type_pri", &type_pri);
+	Branch("type_pri", "vector<string>", &pEventData->m_pPrimaryParticleType);
+	// Energy and positions of the current particle/trackid
+	// 		Acces in ROOT:	vector<float> *e_pri= new vector<float>;
+	//										T1->SetBranchAddress("e_pri", &e_pri);
+	Branch("e_pri", &pEventData->m_fPrimaryEnergy, "e_pri/F");
+	// 		Acces in ROOT:	vector<float> *xp_pri= new vector<float>;
+	//										T1->SetBranchAddress("xp_pri", &xp_pri);
+	Branch("xp_pri", &pEventData->m_fPrimaryX, "xp_pri/F");
+	// 		Acces in ROOT:	vector<float> *yp_pri= new vector<float>;
+	//										T1->SetBranchAddress("yp_pri", &yp_pri);	
+	Branch("yp_pri", &pEventData->m_fPrimaryY, "yp_pri/F");
+	// 		Acces in ROOT:	vector<float> *zp_pri= new vector<float>;
+	//										T1->SetBranchAddress("zp_pri", &zp_pri);
+	Branch("zp_pri", &pEventData->m_fPrimaryZ, "zp_pri/F");
+
+	// basket sizes in the order of the commands, e.g. "*" first and single branches afterwards
+	for(G4int i=0; i<(G4int) hBasketSizes.size(); i++)
+		m_pTree->SetBasketSize(hBasketSizes[i].first.c_str(), hBasketSizes[i].second);
+
+	//m_pTree->SetMaxTreeSize(10e9); /previous
+	m_pTree->SetMaxTreeSize(1000*Long64_t(2000000000)); //2TB
+	m_pTree->SetAutoFlush(lAutoFlush);
+	// auto save functionality to avoid data loss/ROOT can recover aborted simulations
+	// (ROOT: positive every N entries, negative every -N bytes, 0 off)
+	m_pTree->SetAutoSave(lAutoSave);
+}
+
+//******************************************************************/
+// the tree belongs to the output file
+//******************************************************************/
+muensterTPCTreeWriter::~muensterTPCTreeWriter() {
+}
+
+//******************************************************************/
+// Fill
+//******************************************************************/
+void muensterTPCTreeWriter::Fill() {
+	m_pTree->Fill();
+	m_lNbEntries++;
+}
+
+//******************************************************************/
+// Close - the baskets are written with the output file
+//******************************************************************/
+void muensterTPCTreeWriter::Close() {
+}
+
+//******************************************************************/
+// Checkpoint - the tree header on disk holds all events written so far
+//******************************************************************/
+G4bool muensterTPCTreeWriter::Checkpoint() {
+	m_pTree->AutoSave("SaveSelf FlushBaskets");
+
+	return true;
+}
+
+//******************************************************************/
+// GetDescription
+//******************************************************************/
+G4String muensterTPCTreeWriter::GetDescription() {
+	std::stringstream hStream;
+	hStream << "ttree || autoflush " << m_lAutoFlush << " || autosave ";
+	if(m_lAutoSave < 0)
+		hStream << -m_lAutoSave << " bytes";
+	else if(m_lAutoSave > 0)
+		hStream << m_lAutoSave << " entries";
+	else
+		hStream << "off";
+	if(m_bResume)
+		hStream << " || resumed after " << m_lNbResumedEntries << " entries";
+
+	return hStream.str();
+}
+
+//******************************************************************/
+// GetRawSize
+//******************************************************************/
+G4double muensterTPCTreeWriter::GetRawSize() {
+	return m_pTree->GetTotBytes();
+}
+
+//******************************************************************/
+// GetCompressedSize
+//******************************************************************/
+G4double muensterTPCTreeWriter::GetCompressedSize() {
+	return m_pTree->GetZipBytes();
+}
+